@@ -0,0 +1,96 @@
+#!/usr/bin/env bash
+# 对比 HXLibs 在不同 io_uring 配置档下 hello 端点的吞吐与每请求系统调用数
+# 用法: scripts/build.sh 之后执行 scripts/io_uring_profiles.sh
+# 需要 perf (统计 raw_syscalls:sys_enter); 没有 perf 时退化为 strace -c -f
+set -euo pipefail
+
+readonly SCRIPT_DIR="$(cd -- "$(dirname -- "${BASH_SOURCE[0]}")" && pwd)"
+readonly BENCH_DIR="$(cd -- "${SCRIPT_DIR}/.." && pwd)"
+readonly REPO_DIR="$(cd -- "${BENCH_DIR}/../.." && pwd)"
+readonly BUILD_DIR="${BENCH_BUILD_DIR:-${REPO_DIR}/.benchmark-build}"
+readonly BIN_DIR="${BUILD_DIR}/bin"
+readonly RESULT_DIR="${BENCH_RESULT_DIR:-${BUILD_DIR}/results}"
+readonly ASSET_DIR="${BUILD_DIR}/assets"
+
+readonly PORT="${BENCH_PORT:-18080}"
+readonly OPTIMIZATION="${BENCH_OPTIMIZATION:-O3}"
+readonly DURATION="${BENCH_DURATION:-15}"
+readonly WORKERS="${BENCH_WORKERS:-1}"
+readonly WRK_THREADS="${BENCH_WRK_THREADS:-2}"
+readonly CONNECTIONS="${BENCH_CONNECTIONS:-128}"
+readonly SERVER_CPUS="${BENCH_SERVER_CPUS:-0}"
+readonly CLIENT_CPUS="${BENCH_CLIENT_CPUS:-2,3}"
+# SqPoll 内核线程绑定的 CPU (为空则不绑定)
+readonly SQ_CPU="${BENCH_SQ_CPU:-1}"
+read -ra PROFILES <<< "${BENCH_PROFILES:-default sqpoll single-issuer coop-taskrun}"
+
+readonly SERVER="${BIN_DIR}/${OPTIMIZATION}/bench-hxlibs"
+for executable in "${SERVER}" "${BIN_DIR}/wrk"; do
+    if [[ ! -x "${executable}" ]]; then
+        printf 'Missing %s; run scripts/build.sh first.\n' "${executable}" >&2
+        exit 1
+    fi
+done
+
+SERVER_PID=""
+stop_server() {
+    if [[ -n "${SERVER_PID}" ]] && kill -0 "${SERVER_PID}" 2>/dev/null; then
+        kill -TERM "${SERVER_PID}" 2>/dev/null || true
+        wait "${SERVER_PID}" 2>/dev/null || true
+    fi
+    SERVER_PID=""
+}
+trap stop_server EXIT INT TERM
+
+mkdir -p "${RESULT_DIR}/logs"
+readonly OUTPUT="${RESULT_DIR}/io_uring_profiles.jsonl"
+: > "${OUTPUT}"
+
+count_syscalls() {
+    local pid="$1"
+    local seconds="$2"
+    local log="$3"
+    if command -v perf >/dev/null 2>&1; then
+        perf stat -x, -e raw_syscalls:sys_enter -p "${pid}" -- sleep "${seconds}" 2>"${log}" >/dev/null
+        awk -F, '/raw_syscalls:sys_enter/ { print $1 }' "${log}"
+    else
+        timeout --signal=INT "${seconds}" strace -c -f -p "${pid}" 2>"${log}" || true
+        awk '$NF == "total" { print $(NF - 2) }' "${log}"
+    fi
+}
+
+for profile in "${PROFILES[@]}"; do
+    log_file="${RESULT_DIR}/logs/hxlibs-${profile}.log"
+    taskset -c "${SERVER_CPUS}" "${SERVER}" "${PORT}" "${WORKERS}" "${ASSET_DIR}" \
+        "${profile}" ${SQ_CPU:+"${SQ_CPU}"} >"${log_file}" 2>&1 &
+    SERVER_PID=$!
+    for _ in {1..100}; do
+        [[ "$(curl --silent --max-time 1 "http://127.0.0.1:${PORT}/" || true)" == "Hello World!" ]] && break
+        sleep 0.1
+    done
+
+    syscall_log="${RESULT_DIR}/logs/hxlibs-${profile}.syscalls"
+    count_syscalls "${SERVER_PID}" "${DURATION}" "${syscall_log}" > "${syscall_log}.total" &
+    counter_pid=$!
+    wrk_out="$(taskset -c "${CLIENT_CPUS}" "${BIN_DIR}/wrk" \
+        -t"${WRK_THREADS}" -c"${CONNECTIONS}" -d"${DURATION}s" "http://127.0.0.1:${PORT}/")"
+    wait "${counter_pid}" || true
+
+    requests="$(awk '/requests in/ { print $1 }' <<< "${wrk_out}")"
+    rps="$(awk '/Requests\/sec/ { print $2 }' <<< "${wrk_out}")"
+    syscalls="$(head -n 1 "${syscall_log}.total")"
+    python3 - "${profile}" "${requests:-0}" "${rps:-0}" "${syscalls:-0}" <<'PY' | tee -a "${OUTPUT}"
+import json, sys
+profile, requests, rps, syscalls = sys.argv[1], int(sys.argv[2]), float(sys.argv[3]), int(sys.argv[4] or 0)
+print(json.dumps({
+    "profile": profile,
+    "requests_per_sec": rps,
+    "syscalls": syscalls,
+    "syscalls_per_request": round(syscalls / requests, 4) if requests else None,
+}, ensure_ascii=False))
+PY
+    stop_server
+    sleep 1
+done
+
+printf 'Results: %s\n' "${OUTPUT}"
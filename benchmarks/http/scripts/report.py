@@ -22,6 +22,7 @@ SCENARIO_NAMES = {
     "payload-64k": "64 KiB 响应（内存）/ 带宽负载",
     "payload-64k-file": "64 KiB 文件（磁盘 IO）/ 带宽负载",
     "mixed-traffic": "混合流量 / 高并发",
+    "json-api-pipeline": "JSON API / HTTP 流水线",
     "websocket": "WebSocket 回显",
 }
 
@@ -251,13 +251,14 @@ run_wrk() {
     local connections="$6"
     local repeat="$7"
     local seconds="$8"
+    local script="${9:-wrk_json.lua}"
 
     BENCH_PATHS="${paths}" BENCH_SERVER="${server}" BENCH_OPTIMIZATION="${optimization}" \
         BENCH_SCENARIO="${scenario}" BENCH_PROFILE="${profile}" BENCH_REPEAT="${repeat}" \
         BENCH_CONNECTIONS="${connections}" BENCH_DURATION="${seconds}" \
         taskset -c "${CLIENT_CPUS}" "${BIN_DIR}/wrk" \
         -t"${WRK_THREADS}" -c"${connections}" -d"${seconds}s" --timeout 5s --latency \
-        -s "${SCRIPT_DIR}/wrk_json.lua" "http://127.0.0.1:${PORT}/"
+        -s "${SCRIPT_DIR}/${script}" "http://127.0.0.1:${PORT}/"
 }
 
 readonly MIXED_PATHS='/,/api/users,/api/users/1001/orders/90001?page=2&limit=20&sort=name,/,/page.html,/api/users,/,/payload.bin,/page.html'
@@ -282,6 +283,17 @@ readonly SCENARIOS=(
     "mixed-traffic|高并发|${MIXED_PATHS}|${HIGH_CONNECTIONS}"
 )
 
+# BENCH_PIPELINE=N (N > 0) 时追加 HTTP/1.1 流水线场景: 每次写入 N 个请求 (wrk_pipeline.lua)
+readonly PIPELINE="${BENCH_PIPELINE:-0}"
+PIPELINE_SCENARIOS=()
+if [[ "${PIPELINE}" != 0 ]]; then
+    require_positive_integer BENCH_PIPELINE "${PIPELINE}"
+    PIPELINE_SCENARIOS=(
+        "json-api-pipeline|流水线x${PIPELINE}|/api/users|${CONNECTIONS}"
+    )
+fi
+readonly PIPELINE_SCENARIOS
+
 # 每个 (实现, 轮次) 只启动一次服务器, 连续压测全部场景;
 # 轮次间轮转实现顺序, 以摊平机器随时间的性能漂移。
 for ((repeat = 1; repeat <= REPEATS; ++repeat)); do
@@ -297,15 +309,19 @@ for ((repeat = 1; repeat <= REPEATS; ++repeat)); do
                 "${CONNECTIONS}" "${repeat}" "${RUNTIME_WARMUP}" >/dev/null
         fi
 
-        for scenario_config in "${SCENARIOS[@]}"; do
+        for scenario_config in "${SCENARIOS[@]}" "${PIPELINE_SCENARIOS[@]}"; do
             IFS='|' read -r scenario profile paths connections <<< "${scenario_config}"
+            script=wrk_json.lua
+            if [[ "${scenario}" == *-pipeline ]]; then
+                script=wrk_pipeline.lua
+            fi
             printf '轮次=%s 实现=%s 优化=%s 场景=%s 负载=%s 连接=%s 服务端CPU=%s 客户端CPU=%s\n' \
                 "${repeat}" "${server}" "${optimization}" "${scenario}" "${profile}" \
                 "${connections}" "${SERVER_CPUS}" "${CLIENT_CPUS}"
             run_wrk "${server}" "${optimization}" "${scenario}" "${profile}" \
-                "${paths}" "${connections}" "${repeat}" "${WARMUP}" >/dev/null
+                "${paths}" "${connections}" "${repeat}" "${WARMUP}" "${script}" >/dev/null
             run_wrk "${server}" "${optimization}" "${scenario}" "${profile}" \
-                "${paths}" "${connections}" "${repeat}" "${DURATION}" \
+                "${paths}" "${connections}" "${repeat}" "${DURATION}" "${script}" \
                 | tee -a "${RESULT_DIR}/results.jsonl"
         done
 
@@ -0,0 +1,25 @@
+-- HTTP/1.1 流水线: 每次写入 BENCH_PIPELINE 个请求 (默认 16), 服务端按序处理并返回;
+-- 路径与 JSON 汇总 (done) 沿用 wrk_json.lua
+local script_dir = debug.getinfo(1, "S").source:match("^@(.*/)") or "./"
+dofile(script_dir .. "wrk_json.lua")
+
+local depth = tonumber(os.getenv("BENCH_PIPELINE") or "16")
+local paths = {}
+for path in string.gmatch(os.getenv("BENCH_PATHS") or "/", "[^,]+") do
+    table.insert(paths, path)
+end
+
+local pipelined = nil
+
+-- 每线程预编码好一整批请求, request() 直接返回
+init = function()
+    local requests = {}
+    for i = 1, depth do
+        requests[i] = wrk.format(nil, paths[(i - 1) % #paths + 1])
+    end
+    pipelined = table.concat(requests)
+end
+
+request = function()
+    return pipelined
+end
@@ -34,6 +34,19 @@ std::string readFileOrExit(std::string const& path) {
     return data;
 }
 
+// io_uring 配置档: default | sqpoll | single-issuer | coop-taskrun
+HX::coroutine::IoUringProfile parseProfile(char const* value) {
+    using HX::coroutine::IoUringProfile;
+    for (auto profile : {IoUringProfile::Default, IoUringProfile::SqPoll,
+                         IoUringProfile::SingleIssuer, IoUringProfile::CoopTaskRun}) {
+        if (HX::coroutine::toString(profile) == value) {
+            return profile;
+        }
+    }
+    std::cerr << "profile must be one of: default, sqpoll, single-issuer, coop-taskrun\n";
+    std::exit(EXIT_FAILURE);
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
@@ -47,6 +60,12 @@ int main(int argc, char** argv) {
     auto const payload = readFileOrExit(assetDir + "/payload.bin");
     auto const htmlFile = assetDir + "/files/page-file.html";
     auto const payloadFile = assetDir + "/files/payload-file.bin";
+    HttpServerOptions options{};
+    options.eventLoop.profile = argc > 4 ? parseProfile(argv[4]) : coroutine::IoUringProfile::Default;
+    if (argc > 5) {
+        // SqPoll 内核线程绑定的 CPU
+        options.eventLoop.sqThreadCpu = std::atoi(argv[5]);
+    }
     if (port > 65535) {
         std::cerr << "port must be at most 65535\n";
         return EXIT_FAILURE;
@@ -54,10 +73,11 @@ int main(int argc, char** argv) {
 
     HttpServer server{static_cast<std::uint16_t>(port)};
     server.addEndpoint<GET>("/", [] ENDPOINT {
-        co_await res.setStatusAndContent(Status::CODE_200, benchmark_payloads::hello).sendRes();
+        co_await res.setResLine(Status::CODE_200).setContentType(TEXT)
+            .setBodyView(benchmark_payloads::hello).sendRes();
     }).addEndpoint<GET>("/api/users", [] ENDPOINT {
-        co_await res.setStatusAndContent(Status::CODE_200, benchmark_payloads::json)
-            .setContentType(JSON).sendRes();
+        co_await res.setResLine(Status::CODE_200).setContentType(JSON)
+            .setBodyView(benchmark_payloads::json).sendRes();
     }).addEndpoint<GET>("/api/users/{userId}/orders/{orderId}", [] ENDPOINT {
         auto query = req.getParseQueryParameters();
         std::string body = "{\"user_id\":" + req.getPathParam(0).to<std::string>()
@@ -65,17 +85,18 @@ int main(int argc, char** argv) {
             + ",\"page\":" + query["page"] + ",\"limit\":" + query["limit"]
             + ",\"sort\":\"" + query["sort"] + "\"}";
         co_await res.setStatusAndContent(Status::CODE_200, body).setContentType(JSON).sendRes();
-    }).addEndpoint<GET>("/page.html", [html] ENDPOINT {
-        co_await res.setStatusAndContent(Status::CODE_200, html)
-            .setContentType(HTML).sendRes();
-    }).addEndpoint<GET>("/payload.bin", [payload] ENDPOINT {
-        co_await res.setStatusAndContent(Status::CODE_200, payload)
-            .setContentType(HttpContentType::OctetStream).sendRes();
+    }).addEndpoint<GET>("/page.html", [&html] ENDPOINT {
+        // 资源在 main 中一直有效, 借用而不是每请求复制
+        co_await res.setResLine(Status::CODE_200).setContentType(HTML)
+            .setBodyView(html).sendRes();
+    }).addEndpoint<GET>("/payload.bin", [&payload] ENDPOINT {
+        co_await res.setResLine(Status::CODE_200).setContentType(HttpContentType::OctetStream)
+            .setBodyView(payload).sendRes();
     }).addEndpoint<GET>("/page-file.html", [htmlFile] ENDPOINT {
         // 磁盘变体: 走框架自己的文件传输 API, 每请求真实读盘
         co_await res.useRangeTransferFile(req.getRangeRequestView(), htmlFile);
     }).addEndpoint<GET>("/payload-file.bin", [payloadFile] ENDPOINT {
         co_await res.useRangeTransferFile(req.getRangeRequestView(), payloadFile);
     });
-    server.syncRun(workers);
+    server.syncRun(workers, [] {}, 30_s, options);
 }
@@ -40,6 +40,18 @@ foreach(TEST_FILE ${TEST_FILES})
         WORKING_DIRECTORY ${CMAKE_BINARY_DIR}/output/tests/${PARENT_DIR}
     )
 
+    # Linux 下再以 epoll 后端注册一次 (EventBackend::Auto 时由环境变量选择后端)
+    if(UNIX AND NOT APPLE)
+        add_test(
+            NAME ${TEST_NAME}_epoll
+            COMMAND ${TEST_NAME}
+            WORKING_DIRECTORY ${CMAKE_BINARY_DIR}/output/tests/${PARENT_DIR}
+        )
+        set_tests_properties(${TEST_NAME}_epoll PROPERTIES
+            ENVIRONMENT HXLIBS_EVENT_DRIVE=epoll
+        )
+    endif()
+
     # 启用 AddressSanitizer(仅 Debug 模式)
     if(HX_DEBUG_BY_ADDRESS_SANITIZER)
         target_compile_options(${TEST_NAME} PRIVATE
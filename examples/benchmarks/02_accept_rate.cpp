@@ -0,0 +1,98 @@
+#include <HXLibs/net/ApiMacro.hpp>
+#include <HXLibs/log/Log.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+#endif
+
+using namespace HX;
+using namespace net;
+
+/**
+ * @brief 连接风暴压测: 对比 多发 accept 与 逐个 accept 的每秒新建连接数
+ * @note 用法: benchmarks_02_accept_rate [客户端线程数=4] [每轮秒数=3] (请使用 Release 构建, 否则 debug 日志会成为瓶颈)
+ *       每个客户端线程循环: connect -> 发送 `Connection: close` 请求 -> 读到 EOF -> close
+ */
+
+#if defined(__linux__)
+
+namespace {
+
+std::size_t runClients(std::uint16_t port, std::size_t threadNum, std::chrono::seconds dur) {
+    std::atomic_size_t total{0};
+    std::atomic_bool stop{false};
+    std::vector<std::jthread> clients;
+    for (std::size_t i = 0; i < threadNum; ++i) {
+        clients.emplace_back([&] {
+            constexpr std::string_view req
+                = "GET / HTTP/1.1\r\nHost: 127.0.0.1\r\nConnection: close\r\n\r\n";
+            ::sockaddr_in addr{};
+            addr.sin_family = AF_INET;
+            addr.sin_port = htons(port);
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            char buf[1024];
+            std::size_t cnt = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+                if (::connect(fd, reinterpret_cast<::sockaddr*>(&addr), sizeof(addr)) == 0
+                    && ::send(fd, req.data(), req.size(), 0) > 0
+                ) {
+                    while (::recv(fd, buf, sizeof(buf), 0) > 0)
+                        ;
+                    ++cnt;
+                }
+                ::close(fd);
+            }
+            total += cnt;
+        });
+    }
+    std::this_thread::sleep_for(dur);
+    stop = true;
+    clients.clear();
+    return total.load();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t const threadNum = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 4;
+    auto const dur = std::chrono::seconds{argc > 2 ? std::strtol(argv[2], nullptr, 10) : 3};
+
+    std::uint16_t port = 28206;
+    for (bool multishot : {false, true}) {
+        HttpServer serv{port};
+        serv.addEndpoint<GET>("/", [] ENDPOINT {
+            co_await res.setStatusAndContent(Status::CODE_200, "Hello World!")
+                        .sendRes();
+        });
+        HttpServerOptions options{};
+        options.multishotAccept = multishot;
+        serv.asyncRun(1, [] {}, 30_s, options);
+        std::this_thread::sleep_for(std::chrono::milliseconds{200});
+
+        auto cnt = runClients(port, threadNum, dur);
+        log::hxLog.info(
+            multishot ? "multishot accept:" : "single accept:",
+            cnt / static_cast<std::size_t>(dur.count()), "conn/s");
+        ++port; // 避免 TIME_WAIT 影响下一轮 (serv 析构时关闭服务器)
+    }
+    return 0;
+}
+
+#else
+
+int main() {
+    log::hxLog.warning("multishot accept is only available on Linux");
+    return 0;
+}
+
+#endif
@@ -0,0 +1,109 @@
+#include <HXLibs/net/ApiMacro.hpp>
+#include <HXLibs/log/Log.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+#endif
+
+using namespace HX;
+using namespace net;
+
+/**
+ * @brief 空闲长连接的内存压测: 对比 连接自身缓冲区 与 提供缓冲区环 两种读取方式下, 每个空闲连接占用的内存
+ * @note 用法: benchmarks_03_idle_memory [连接数=1000] [缓冲区环个数=256] (连接数受 ulimit -n 限制)
+ *       每个连接先完成一次 keep-alive 请求, 然后保持空闲, 统计进程 RSS 的增量 / 连接数.
+ *       客户端套接字也在本进程中, 但其只占用内核内存, 不计入 RSS.
+ */
+
+#if defined(__linux__)
+
+namespace {
+
+std::size_t rssBytes() {
+    std::ifstream statm{"/proc/self/statm"};
+    std::size_t size = 0, resident = 0;
+    statm >> size >> resident;
+    return resident * static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+}
+
+std::vector<int> openIdleConnections(std::uint16_t port, std::size_t n) {
+    constexpr std::string_view req = "GET / HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n";
+    ::sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    std::vector<int> fds;
+    fds.reserve(n);
+    char buf[1024];
+    for (std::size_t i = 0; i < n; ++i) {
+        int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0
+            || ::connect(fd, reinterpret_cast<::sockaddr*>(&addr), sizeof(addr)) != 0
+            || ::send(fd, req.data(), req.size(), 0) <= 0
+            || ::recv(fd, buf, sizeof(buf), 0) <= 0
+        ) [[unlikely]] {
+            log::hxLog.error("connect failed at", i);
+            if (fd >= 0) {
+                ::close(fd);
+            }
+            break;
+        }
+        fds.push_back(fd);
+    }
+    return fds;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t const connNum = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000;
+    auto const ringEntries = static_cast<unsigned int>(
+        argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 256);
+
+    std::uint16_t port = 28208;
+    for (unsigned int entries : {0U, ringEntries}) {
+        HttpServer serv{port};
+        serv.addEndpoint<GET>("/", [] ENDPOINT {
+            co_await res.setStatusAndContent(Status::CODE_200, "Hello World!")
+                        .sendRes();
+        });
+        HttpServerOptions options{};
+        options.eventLoop.bufRingEntries = entries;
+        serv.asyncRun(1, [] {}, 120_s, options);
+        std::this_thread::sleep_for(std::chrono::milliseconds{200});
+
+        auto before = rssBytes();
+        auto fds = openIdleConnections(port, connNum);
+        std::this_thread::sleep_for(std::chrono::milliseconds{500});
+        auto after = rssBytes();
+
+        log::hxLog.info(
+            entries ? "buf ring:" : "conn buffer:",
+            fds.size(), "idle conn,",
+            (after - before) / std::max<std::size_t>(fds.size(), 1), "bytes/conn");
+        for (int fd : fds) {
+            ::close(fd);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds{200});
+        ++port; // serv 析构时关闭服务器
+    }
+    return 0;
+}
+
+#else
+
+int main() {
+    log::hxLog.warning("provided buffer ring is only available on Linux");
+    return 0;
+}
+
+#endif
@@ -0,0 +1,96 @@
+#include <HXLibs/net/ApiMacro.hpp>
+#include <HXLibs/log/Log.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+#if defined(__linux__)
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+#endif
+
+using namespace HX;
+using namespace net;
+
+/**
+ * @brief 大响应体的发送吞吐压测: 对比 普通发送 与 零拷贝发送 (IORING_OP_SEND_ZC)
+ * @note 用法: benchmarks_04_send_zc [响应体 MB=4] [请求数=200]
+ *       客户端在同一个 keep-alive 连接上顺序请求, 统计 MB/s.
+ *       回环网卡上内核仍会复制数据, 零拷贝的收益需要在真实网卡上测量.
+ */
+
+#if defined(__linux__)
+
+namespace {
+
+double benchOnce(std::uint16_t port, std::size_t bodySize, std::size_t reqNum) {
+    constexpr std::string_view req = "GET / HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n";
+    ::sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0 || ::connect(fd, reinterpret_cast<::sockaddr*>(&addr), sizeof(addr)) != 0) {
+        log::hxLog.error("connect failed");
+        return 0;
+    }
+    std::string buf(1 << 20, '\0');
+    std::size_t total = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < reqNum; ++i) {
+        ::send(fd, req.data(), req.size(), 0);
+        // 响应头很短, 读满 响应体 + 响应头 即可; 这里按响应体大小计数, 多出的头部在下次读取时被计入
+        std::size_t want = total + bodySize;
+        while (total < want) {
+            auto n = ::recv(fd, buf.data(), buf.size(), 0);
+            if (n <= 0) {
+                ::close(fd);
+                return 0;
+            }
+            total += static_cast<std::size_t>(n);
+        }
+    }
+    auto sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    ::close(fd);
+    return static_cast<double>(total) / (1024.0 * 1024.0) / sec;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t const bodySize = (argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 4) << 20;
+    std::size_t const reqNum = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 200;
+    std::string const body(bodySize, 'x');
+
+    std::uint16_t port = 28212;
+    for (std::size_t threshold : {std::size_t{0}, std::size_t{64 * 1024}}) {
+        HttpServer serv{port};
+        serv.addEndpoint<GET>("/", [&] ENDPOINT {
+            co_await res.setStatusAndContent(Status::CODE_200, body)
+                        .sendRes();
+        });
+        HttpServerOptions options{};
+        options.zeroCopySendThreshold = threshold;
+        serv.asyncRun(1, [] {}, 120_s, options);
+        std::this_thread::sleep_for(std::chrono::milliseconds{200});
+
+        auto mbps = benchOnce(port, bodySize, reqNum);
+        log::hxLog.info(threshold ? "send zc:" : "send:",
+            bodySize >> 20, "MB body,", reqNum, "req,", mbps, "MB/s");
+        ++port; // serv 析构时关闭服务器
+    }
+    return 0;
+}
+
+#else
+
+int main() {
+    log::hxLog.warning("zero-copy send is only available on Linux");
+    return 0;
+}
+
+#endif
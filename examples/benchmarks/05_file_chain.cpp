@@ -0,0 +1,134 @@
+#include <HXLibs/coroutine/loop/EventLoop.hpp>
+#include <HXLibs/utils/FileUtils.hpp>
+#include <HXLibs/log/Log.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+    #include <fcntl.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+#endif
+
+using namespace HX;
+
+/**
+ * @brief 使用链式任务发送静态文件: 发送响应头 -> 打开 -> 读取 -> 发送 -> 关闭, 一次提交, 一次恢复;
+ *        对比逐步 co_await (每一步都要经过一次 提交/完成 的往返)
+ * @note 用法: benchmarks_05_file_chain [文件大小 KB=4] [请求数=100000]
+ *       文件大小与静态文件服务相同, 事先通过 stat 获取 (AsyncFile::open 也是如此);
+ *       普通 fd 无法在链中传递, 因此文件打开到注册文件表的固定槽位.
+ */
+
+#if defined(__linux__)
+
+namespace {
+
+constexpr char const* kPath = "05_file_chain.html";
+constexpr unsigned int kSlot = 0; // 注册文件表中, 本示例独占的槽位
+
+std::string makeHead(std::size_t size) {
+    return "HTTP/1.1 200 OK\r\nContent-Type: text/html\r\nContent-Length: "
+        + std::to_string(size) + "\r\n\r\n";
+}
+
+/**
+ * @brief 逐步发送: openat, read, send, send, close 各一次往返
+ */
+coroutine::Task<bool> serveStepByStep(
+    coroutine::EventLoop& loop, int sock, std::string const& head, std::vector<char>& buf
+) {
+    int fd = co_await loop.makeAioTask().prepOpenat(AT_FDCWD, kPath, O_RDONLY, 0);
+    if (fd < 0) {
+        co_return false;
+    }
+    int n = co_await loop.makeAioTask().prepRead(fd, buf, 0);
+    int h = co_await loop.makeAioTask().prepSend(sock, head, MSG_MORE);
+    int b = co_await loop.makeAioTask().prepSend(sock, {buf.data(), static_cast<std::size_t>(n)}, 0);
+    co_await loop.makeAioTask().prepClose(fd);
+    co_return h == static_cast<int>(head.size()) && b == n;
+}
+
+/**
+ * @brief 链式发送: 5 个操作一次提交, 协程只恢复一次
+ */
+coroutine::Task<bool> serveChain(
+    coroutine::EventLoop& loop, int sock, std::string const& head, std::vector<char>& buf
+) {
+    auto const size = static_cast<unsigned int>(buf.size());
+    auto [h, open, n, b, close] = co_await loop.makeAioChain<5>()
+        .add(loop.makeAioTask().prepSend(sock, head, MSG_MORE))
+        .add(loop.makeAioTask().prepOpenatDirect(AT_FDCWD, kPath, O_RDONLY, 0, kSlot))
+        .add(loop.makeAioTask().prepRead(kSlot, buf, size, 0).setFixedFile())
+        .add(loop.makeAioTask().prepSend(sock, buf, 0))
+        .add(loop.makeAioTask().prepCloseDirect(kSlot));
+    if (open == 0 && close != 0) [[unlikely]] {
+        // 读取或发送不足 (文件被修改 / 对端关闭) 会中断链, 需要自行关闭槽位
+        co_await loop.makeAioTask().prepCloseDirect(kSlot);
+    }
+    co_return h == static_cast<int>(head.size()) && n == static_cast<int>(size)
+        && b == static_cast<int>(size);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t const fileSize = (argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 4) << 10;
+    std::size_t const reqNum = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 100000;
+    std::ofstream{kPath} << std::string(fileSize, 'x');
+
+    for (bool chain : {false, true}) {
+        int sv[2];
+        if (::socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0) {
+            log::hxLog.error("socketpair failed");
+            return 1;
+        }
+        // 客户端: 丢弃收到的响应
+        std::jthread cli{[fd = sv[1]] {
+            std::vector<char> buf(1 << 16);
+            while (::recv(fd, buf.data(), buf.size(), 0) > 0)
+                ;
+            ::close(fd);
+        }};
+
+        coroutine::EventLoopOptions options{};
+        options.fixedFiles = 1;
+        coroutine::EventLoop loop{options};
+        auto const size = utils::FileUtils::getFileSize(kPath);
+        auto const head = makeHead(size);
+        std::vector<char> buf(size);
+
+        auto t0 = std::chrono::steady_clock::now();
+        std::size_t ok = loop.sync([&]() -> coroutine::Task<std::size_t> {
+            std::size_t cnt = 0;
+            for (std::size_t i = 0; i < reqNum; ++i) {
+                cnt += chain
+                    ? co_await serveChain(loop, sv[0], head, buf)
+                    : co_await serveStepByStep(loop, sv[0], head, buf);
+            }
+            co_return cnt;
+        }());
+        auto sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        ::shutdown(sv[0], SHUT_WR);
+        ::close(sv[0]);
+
+        log::hxLog.info(chain ? "chain:" : "step by step:",
+            ok, "/", reqNum, "ok,", static_cast<double>(reqNum) / sec, "req/s");
+    }
+    ::unlink(kPath);
+    return 0;
+}
+
+#else
+
+int main() {
+    log::hxLog.warning("linked SQE chain is only available on Linux");
+    return 0;
+}
+
+#endif
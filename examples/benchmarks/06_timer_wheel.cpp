@@ -0,0 +1,97 @@
+#include <HXLibs/coroutine/loop/TimerLoop.hpp>
+#include <HXLibs/log/Log.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <map>
+#include <optional>
+#include <vector>
+
+using namespace HX;
+
+/**
+ * @brief 定时器 插入/取消 的压测: 对比 时间轮 (TimerLoop) 与 之前的红黑树 (std::multimap)
+ * @note 用法: benchmarks_06_timer_wheel [插入/取消次数=5000000] [常驻定时器数=100000]
+ *       模拟每个连接一个空闲超时定时器: 先插入 常驻定时器数 个定时器,
+ *       然后每次 插入一个新的定时器 并 取消最早插入的那个 (连接上有读写, 超时被重置).
+ */
+
+namespace {
+
+// 之前 TimerLoop 的实现: 按过期时间排序的红黑树, 每次插入都读取一次系统时钟
+struct TreeTimer {
+    using TimerTree = std::multimap<std::chrono::system_clock::time_point, std::coroutine_handle<>>;
+
+    TimerTree::iterator add(std::chrono::system_clock::duration dur) {
+        return _tree.insert({std::chrono::system_clock::now() + dur, std::noop_coroutine()});
+    }
+
+    void cancel(TimerTree::iterator it) {
+        _tree.erase(it);
+    }
+
+    TimerTree _tree;
+};
+
+template <typename Fn>
+double timeIt(Fn&& fn) {
+    auto t0 = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+std::chrono::milliseconds timeoutOf(std::size_t i) {
+    // 30s 左右的空闲超时, 稍加抖动, 避免全部落在同一个槽位
+    return std::chrono::milliseconds{30'000 + static_cast<long>(i % 1000)};
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t const opNum = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 5'000'000;
+    std::size_t const liveNum = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 100'000;
+
+    double treeSec = 0;
+    {
+        TreeTimer tree;
+        std::vector<TreeTimer::TimerTree::iterator> live(liveNum);
+        for (std::size_t i = 0; i < liveNum; ++i) {
+            live[i] = tree.add(timeoutOf(i));
+        }
+        treeSec = timeIt([&] {
+            for (std::size_t i = 0; i < opNum; ++i) {
+                auto& slot = live[i % liveNum];
+                tree.cancel(slot);
+                slot = tree.add(timeoutOf(i));
+            }
+        });
+    }
+
+    double wheelSec = 0;
+    {
+        coroutine::TimerLoop timerLoop;
+        using Timer = coroutine::TimerLoop::TimerAwaiter;
+        // 与协程帧中的 TimerAwaiter 一样, 节点内嵌在对象中, 插入无需分配内存
+        std::vector<std::optional<Timer>> live(liveNum);
+        auto add = [&](std::optional<Timer>& slot, std::size_t i) {
+            slot.emplace(coroutine::TimerLoop::makeTimer(timerLoop).sleepFor(timeoutOf(i)));
+            slot->await_suspend(std::noop_coroutine());
+        };
+        for (std::size_t i = 0; i < liveNum; ++i) {
+            add(live[i], i);
+        }
+        wheelSec = timeIt([&] {
+            for (std::size_t i = 0; i < opNum; ++i) {
+                auto& slot = live[i % liveNum];
+                slot.reset(); // 析构即取消
+                add(slot, i);
+            }
+        });
+    }
+
+    log::hxLog.info("multimap:", opNum, "insert/cancel,", liveNum, "live,",
+        static_cast<double>(opNum) / treeSec / 1e6, "M op/s");
+    log::hxLog.info("timing wheel:", opNum, "insert/cancel,", liveNum, "live,",
+        static_cast<double>(opNum) / wheelSec / 1e6, "M op/s");
+    return 0;
+}
@@ -0,0 +1,88 @@
+#include <HXLibs/coroutine/loop/EventLoop.hpp>
+#include <HXLibs/container/ThreadPool.hpp>
+#include <HXLibs/log/Log.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace HX;
+
+/**
+ * @brief 跨线程唤醒延迟的压测: 其他线程向空闲 (阻塞在事件驱动上) 的事件循环投递任务, 到任务开始执行的时间
+ * @note 用法: benchmarks_07_cross_thread_wakeup [次数=20000]
+ *       1. post: 工作线程 `loop.post(fn)`, 等待 fn 执行后再投递下一个
+ *       2. FutureResult::via(loop): 协程等待线程池任务, 并在事件循环线程中恢复 (往返)
+ */
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+void report(char const* name, std::vector<Clock::duration>& lat) {
+    std::sort(lat.begin(), lat.end());
+    auto us = [](Clock::duration d) {
+        return std::chrono::duration<double, std::micro>(d).count();
+    };
+    log::hxLog.info(name,
+        "p50:", us(lat[lat.size() / 2]), "us,",
+        "p99:", us(lat[lat.size() * 99 / 100]), "us,",
+        "max:", us(lat.back()), "us");
+}
+
+void benchPost(std::size_t n) {
+    coroutine::EventLoop loop;
+    std::vector<Clock::duration> lat;
+    lat.reserve(n);
+    auto raii = loop.makeTheradTask();
+    std::thread producer{[&] {
+        std::atomic_bool done{};
+        for (std::size_t i = 0; i < n; ++i) {
+            done.store(false, std::memory_order_relaxed);
+            auto t0 = Clock::now();
+            loop.post([&, t0] {
+                lat.push_back(Clock::now() - t0);
+                done.store(true, std::memory_order_release);
+            });
+            while (!done.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            // 让事件循环重新阻塞, 测量的是唤醒延迟
+            std::this_thread::sleep_for(std::chrono::microseconds{20});
+        }
+        loop.post([&] { raii.notify(); });
+    }};
+    loop.run();
+    producer.join();
+    report("post:", lat);
+}
+
+void benchVia(std::size_t n) {
+    coroutine::EventLoop loop;
+    container::ThreadPool pool;
+    pool.setFixedThreadNum(1);
+    pool.run<container::ThreadPool::Model::FixedSizeAndNoCheck>();
+    std::vector<Clock::duration> lat;
+    lat.reserve(n);
+    loop.sync([](coroutine::EventLoop& loop, container::ThreadPool& pool,
+                 std::vector<Clock::duration>& lat, std::size_t n) -> coroutine::Task<> {
+        for (std::size_t i = 0; i < n; ++i) {
+            auto t0 = Clock::now();
+            co_await pool.addTask([] { return 0; }).via(loop);
+            lat.push_back(Clock::now() - t0);
+        }
+    }(loop, pool, lat, n));
+    report("via(loop):", lat);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t const n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000;
+    benchPost(n);
+    benchVia(n);
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include <HXLibs/net/ApiMacro.hpp>
+#include <HXLibs/log/Log.hpp>
+
+#include <chrono>
+#include <ctime>
+#include <cstdlib>
+#include <thread>
+
+#if defined(__linux__)
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+#endif
+
+using namespace HX;
+using namespace net;
+
+/**
+ * @brief 短连接异常断开的压测: 客户端发送半个请求后直接 RST (SO_LINGER = 0) 关闭连接,
+ *        服务端读取时得到 -ECONNRESET; 统计每个连接的耗时与进程 CPU 时间
+ * @note 用法: benchmarks_08_abrupt_disconnect [连接数=20000] (建议将标准输出重定向到 /dev/null)
+ *       最后再发送一个正常请求, 其返回时服务端已处理完之前的所有连接.
+ */
+
+#if defined(__linux__)
+
+namespace {
+
+int connectTo(std::uint16_t port) {
+    ::sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0 || ::connect(fd, reinterpret_cast<::sockaddr*>(&addr), sizeof(addr)) != 0) [[unlikely]] {
+        std::abort();
+    }
+    return fd;
+}
+
+void resetClose(int fd) {
+    ::linger lg{1, 0};
+    ::setsockopt(fd, SOL_SOCKET, SO_LINGER, &lg, sizeof(lg));
+    ::close(fd);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t const n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000;
+    constexpr std::uint16_t port = 28214;
+    HttpServer serv{port};
+    serv.addEndpoint<GET>("/", [] ENDPOINT {
+        co_await res.setStatusAndContent(Status::CODE_200, "Hello World!")
+                    .sendRes();
+    });
+    serv.asyncRun(1, [] {}, 5_s);
+    std::this_thread::sleep_for(std::chrono::milliseconds{300});
+
+    constexpr std::string_view half = "GET / HTTP/1.1\r\nHost: 127.0.0.1\r\n";
+    auto const cpu0 = std::clock();
+    auto const t0 = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < n; ++i) {
+        int fd = connectTo(port);
+        ::send(fd, half.data(), half.size(), 0);
+        // 等服务端开始读取后再重置, 使其读取得到 -ECONNRESET
+        std::this_thread::yield();
+        resetClose(fd);
+    }
+    {
+        constexpr std::string_view req = "GET / HTTP/1.1\r\nHost: 127.0.0.1\r\nConnection: close\r\n\r\n";
+        int fd = connectTo(port);
+        char buf[1024];
+        ::send(fd, req.data(), req.size(), 0);
+        ::recv(fd, buf, sizeof(buf), 0);
+        ::close(fd);
+    }
+    auto const sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    auto const cpu = static_cast<double>(std::clock() - cpu0) / CLOCKS_PER_SEC;
+    log::hxLog.info("abrupt disconnect:", n, "conn,",
+                    static_cast<double>(n) / sec, "conn/s,",
+                    cpu * 1e6 / static_cast<double>(n), "us CPU/conn");
+    return 0;
+}
+
+#else
+
+int main() {
+    log::hxLog.warning("this benchmark is only available on Linux");
+    return 0;
+}
+
+#endif
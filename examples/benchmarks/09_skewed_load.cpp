@@ -0,0 +1,136 @@
+#include <HXLibs/net/ApiMacro.hpp>
+#include <HXLibs/log/Log.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+#endif
+
+using namespace HX;
+using namespace net;
+
+/**
+ * @brief 倾斜负载的压测: 少量长连接持续发送 CPU 密集的请求 (每个约 1ms),
+ *        连接数与线程数相同; 比较 SO_REUSEPORT 哈希分配与连接均衡下的请求延迟
+ * @note 用法: benchmarks_09_skewed_load [轮数=10] [每个连接的请求数=200]
+ *       每轮重新建立连接: 哈希分配时多个重连接常落在同一线程上, 使其请求排队.
+ *       同时统计各连接分别落在不同线程上的轮数 (单核机器上延迟无差别, 可看该项)
+ */
+
+#if defined(__linux__)
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t kThreadNum = 4;
+
+int connectTo(std::uint16_t port) {
+    ::sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0 || ::connect(fd, reinterpret_cast<::sockaddr*>(&addr), sizeof(addr)) != 0) [[unlikely]] {
+        std::abort();
+    }
+    return fd;
+}
+
+void bench(char const* name, bool balance, std::uint16_t port, std::size_t rounds, std::size_t n) {
+    HttpServer serv{port};
+    serv.addEndpoint<GET>("/", [] ENDPOINT {
+        // 模拟 CPU 密集的端点
+        auto const end = Clock::now() + std::chrono::milliseconds{1};
+        while (Clock::now() < end)
+            ;
+        std::ostringstream oss;
+        oss << std::this_thread::get_id();
+        co_await res.setStatusAndContent(Status::CODE_200, oss.str())
+                    .sendRes();
+    });
+    HttpServerOptions options{};
+    options.balanceConnections = balance;
+    serv.asyncRun(kThreadNum, [] {}, 5_s, options);
+    std::this_thread::sleep_for(std::chrono::milliseconds{300});
+
+    constexpr std::string_view req = "GET / HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n";
+    std::vector<Clock::duration> lat;
+    lat.reserve(rounds * n * kThreadNum);
+    std::size_t spread = 0;
+    auto const t0 = Clock::now();
+    for (std::size_t r = 0; r < rounds; ++r) {
+        std::vector<int> fds;
+        for (std::size_t i = 0; i < kThreadNum; ++i) {
+            fds.push_back(connectTo(port));
+        }
+        std::vector<std::vector<Clock::duration>> lats(kThreadNum);
+        std::vector<std::string> servedBy(kThreadNum);
+        std::vector<std::thread> clients;
+        for (std::size_t i = 0; i < kThreadNum; ++i) {
+            clients.emplace_back([&, i] {
+                char buf[1024];
+                for (std::size_t k = 0; k < n; ++k) {
+                    auto const begin = Clock::now();
+                    ::send(fds[i], req.data(), req.size(), 0);
+                    auto len = ::recv(fds[i], buf, sizeof(buf), 0);
+                    lats[i].push_back(Clock::now() - begin);
+                    if (k == 0 && len > 0) {
+                        std::string_view resp{buf, static_cast<std::size_t>(len)};
+                        servedBy[i] = resp.substr(resp.find("\r\n\r\n") + 4);
+                    }
+                }
+            });
+        }
+        for (auto& t : clients) {
+            t.join();
+        }
+        spread += std::set<std::string>{servedBy.begin(), servedBy.end()}.size() == kThreadNum;
+        for (std::size_t i = 0; i < kThreadNum; ++i) {
+            ::close(fds[i]);
+            lat.insert(lat.end(), lats[i].begin(), lats[i].end());
+        }
+        // 等待服务端处理完断开
+        std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    }
+    auto const sec = std::chrono::duration<double>(Clock::now() - t0).count();
+    std::sort(lat.begin(), lat.end());
+    auto ms = [](Clock::duration d) {
+        return std::chrono::duration<double, std::milli>(d).count();
+    };
+    log::hxLog.info(name,
+        static_cast<double>(lat.size()) / sec, "req/s,",
+        "p50:", ms(lat[lat.size() / 2]), "ms,",
+        "p99:", ms(lat[lat.size() * 99 / 100]), "ms,",
+        "max:", ms(lat.back()), "ms,",
+        "rounds with one connection per thread:", spread, "/", rounds);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t const rounds = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10;
+    std::size_t const n = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 200;
+    bench("SO_REUSEPORT:", false, 28217, rounds, n);
+    bench("balanced:", true, 28218, rounds, n);
+    return 0;
+}
+
+#else
+
+int main() {
+    log::hxLog.warning("this benchmark is only available on Linux");
+    return 0;
+}
+
+#endif
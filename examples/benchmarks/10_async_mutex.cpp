@@ -0,0 +1,103 @@
+#include <HXLibs/coroutine/awaiter/WhenAll.hpp>
+#include <HXLibs/coroutine/executor/SerialExecutor.hpp>
+#include <HXLibs/coroutine/loop/EventLoop.hpp>
+#include <HXLibs/coroutine/sync/AsyncMutex.hpp>
+#include <HXLibs/coroutine/sync/Channel.hpp>
+#include <HXLibs/log/Log.hpp>
+
+#include <chrono>
+#include <cstdlib>
+
+using namespace HX;
+
+/**
+ * @brief 协程互斥的压测: SerialExecutor 与 AsyncMutex 每次进出临界区的耗时
+ * @note 用法: benchmarks_10_async_mutex [每个协程的次数=100000]
+ *       1. 无竞争: 单个协程反复进出临界区
+ *       2. 有竞争: 4 个协程, 临界区内 yield 一次, 使其他协程排队等待
+ *       另测 Channel<int> (容量 64) 单生产者单消费者每条消息的耗时
+ */
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct State {
+    coroutine::EventLoop loop{};
+    coroutine::SerialExecutor serial{};
+    coroutine::AsyncMutex mtx{};
+    std::size_t counter = 0;
+};
+
+coroutine::Task<> criticalSection(State& st, bool yield) {
+    ++st.counter;
+    if (yield) {
+        co_await st.loop.makeTimer().yield();
+    }
+}
+
+coroutine::Task<> serialWorker(State& st, std::size_t n, bool yield) {
+    for (std::size_t i = 0; i < n; ++i) {
+        auto task = criticalSection(st, yield);
+        co_await st.serial.serial(task);
+    }
+}
+
+coroutine::Task<> mutexWorker(State& st, std::size_t n, bool yield) {
+    for (std::size_t i = 0; i < n; ++i) {
+        co_await st.mtx.lock();
+        co_await criticalSection(st, yield);
+        st.mtx.unlock();
+    }
+}
+
+template <typename Worker>
+void bench(char const* name, Worker worker, std::size_t n, bool contended) {
+    State st;
+    auto const t0 = Clock::now();
+    if (contended) {
+        st.loop.sync(coroutine::whenAll(
+            worker(st, n, true), worker(st, n, true), worker(st, n, true), worker(st, n, true)));
+    } else {
+        st.loop.sync(worker(st, n, false));
+    }
+    auto const ns = std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+    log::hxLog.info(name, ns / static_cast<double>(st.counter), "ns/op");
+}
+
+coroutine::Task<> produce(coroutine::Channel<int>& ch, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        co_await ch.send(static_cast<int>(i));
+    }
+    ch.close();
+}
+
+coroutine::Task<> consume(coroutine::Channel<int>& ch, std::size_t& cnt) {
+    for (;;) {
+        // GCC 12 对 while 条件中的 co_await 生成错误代码, 故拆开
+        auto v = co_await ch.recv();
+        if (!v) {
+            break;
+        }
+        ++cnt;
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t const n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    bench("SerialExecutor (uncontended):", serialWorker, n, false);
+    bench("AsyncMutex     (uncontended):", mutexWorker, n, false);
+    bench("SerialExecutor (4 contending):", serialWorker, n, true);
+    bench("AsyncMutex     (4 contending):", mutexWorker, n, true);
+
+    coroutine::EventLoop loop;
+    coroutine::Channel<int> ch{64};
+    std::size_t cnt = 0;
+    auto const t0 = Clock::now();
+    loop.sync(coroutine::whenAll(produce(ch, n), consume(ch, cnt)));
+    auto const ns = std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+    log::hxLog.info("Channel<int> (cap 64):", ns / static_cast<double>(cnt), "ns/msg");
+    return 0;
+}
@@ -0,0 +1,96 @@
+#include <HXLibs/coroutine/awaiter/WhenAny.hpp>
+#include <HXLibs/coroutine/loop/EventLoop.hpp>
+#include <HXLibs/log/Log.hpp>
+
+#include <chrono>
+#include <cstdlib>
+
+#if defined(__linux__)
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace HX;
+using namespace std::chrono;
+
+/**
+ * @brief whenAny 落败任务取消的压测: recv 与定时器反复竞争, 观察环的占用是否保持平稳
+ * @note 用法: benchmarks_11_when_any_race [轮数=1000]
+ *       每 16 个连接为一组, 其中 1 个有数据可读 (recv 获胜), 其余由定时器获胜;
+ *       每隔 1/10 的轮数打印一次未完成的 SQE 数与已析构但尚未回收的任务数.
+ */
+
+namespace {
+
+using Clock = steady_clock;
+
+constexpr int kConns = 16;
+
+coroutine::Task<int> recvOnce(coroutine::EventLoop& loop, int fd, std::span<char> buf) {
+    co_return co_await loop.makeAioTask().prepRecv(fd, buf, 0);
+}
+
+coroutine::Task<> race(coroutine::EventLoop& loop, int fd, std::size_t& recvWins) {
+    char buf[64];
+    auto res = co_await coroutine::whenAny(
+        recvOnce(loop, fd, buf), loop.makeTimer().sleepFor(20us));
+    recvWins += res.index() == 0;
+}
+
+coroutine::Task<> bench(coroutine::EventLoop& loop, int (&fds)[kConns][2], std::size_t rounds) {
+    auto& drive = loop.getEventDrive();
+    std::size_t recvWins = 0;
+    std::size_t maxPending = 0;
+    auto const t0 = Clock::now();
+    for (std::size_t i = 0; i < rounds; ++i) {
+        int const hot = static_cast<int>(i % kConns);
+        if (::write(fds[hot][1], "x", 1) != 1) [[unlikely]] {
+            throw std::runtime_error{"write failed"};
+        }
+        co_await race(loop, fds[hot][0], recvWins);
+        for (int c = 0; c < kConns; ++c) {
+            if (c != hot) {
+                co_await race(loop, fds[c][0], recvWins);
+            }
+        }
+        maxPending = std::max(maxPending, drive.pendingSqes());
+        if ((i + 1) % (rounds / 10 ? rounds / 10 : 1) == 0) {
+            log::hxLog.info("round", i + 1, "pending SQEs:", drive.pendingSqes(),
+                "abandoned:", drive.abandonedTasks(), "max pending:", maxPending);
+        }
+    }
+    auto const ns = duration<double, std::nano>(Clock::now() - t0).count();
+    log::hxLog.info("races:", rounds * kConns, "recv wins:", recvWins,
+        ns / static_cast<double>(rounds * kConns), "ns/race");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t const rounds = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000;
+    int fds[kConns][2];
+    for (auto& fd : fds) {
+        if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fd)) {
+            return 1;
+        }
+    }
+    {
+        coroutine::EventLoop loop;
+        loop.sync(bench(loop, fds, rounds));
+        log::hxLog.info("after drain, pending SQEs:", loop.getEventDrive().pendingSqes(),
+            "abandoned:", loop.getEventDrive().abandonedTasks());
+    }
+    for (auto& fd : fds) {
+        ::close(fd[0]);
+        ::close(fd[1]);
+    }
+    return 0;
+}
+
+#else
+
+int main() {
+    return 0;
+}
+
+#endif // defined(__linux__)
@@ -0,0 +1,125 @@
+#include <HXLibs/net/ApiMacro.hpp>
+#include <HXLibs/net/client/HttpClient.hpp>
+#include <HXLibs/coroutine/awaiter/AsCompleted.hpp>
+#include <HXLibs/coroutine/awaiter/WhenAll.hpp>
+#include <HXLibs/coroutine/sync/Channel.hpp>
+#include <HXLibs/log/Log.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace HX;
+using namespace net;
+
+/**
+ * @brief 动态数量 whenAll 的压测: 经由共享事件循环上的 K 个 HttpClient (各一条连接),
+ *        向本机服务端扇出 N 个请求
+ * @note 用法: benchmarks_12_fan_out [请求数=10000] [连接数=16]
+ *       1. whenAll(std::vector<Task>): N 个请求同时启动, 在连接池 (Channel) 上排队
+ *       2. whenAll(range, K): 至多 K 个请求同时进行
+ *       3. asCompleted(range, K): 同上, 按完成顺序逐个取得结果
+ */
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Clients {
+    Clients(std::shared_ptr<coroutine::EventLoop> loop, std::size_t k)
+        : pool{k}
+    {
+        for (std::size_t i = 0; i < k; ++i) {
+            clients.push_back(std::make_unique<HttpClient<NoneProxy>>(
+                HttpClientOptions<NoneProxy>{}, loop));
+            pool.trySend(i);
+        }
+    }
+
+    std::vector<std::unique_ptr<HttpClient<NoneProxy>>> clients;
+    coroutine::Channel<std::size_t> pool; // 空闲连接的下标
+};
+
+coroutine::Task<int> fetch(Clients& cs, std::string const& url) {
+    auto idx = *co_await cs.pool.recv();
+    auto res = co_await cs.clients[idx]->coGet(url);
+    cs.pool.trySend(idx);
+    co_return res ? res.get().status : -1;
+}
+
+std::vector<coroutine::Task<int>> makeRequests(Clients& cs, std::string const& url, std::size_t n) {
+    std::vector<coroutine::Task<int>> reqs;
+    reqs.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        reqs.push_back(fetch(cs, url));
+    }
+    return reqs;
+}
+
+template <typename F>
+void bench(char const* name, std::size_t n, F&& f) {
+    auto const t0 = Clock::now();
+    std::size_t ok = f();
+    auto const sec = std::chrono::duration<double>(Clock::now() - t0).count();
+    log::hxLog.info(name, static_cast<double>(n) / sec, "req/s,", ok, "/", n, "ok");
+}
+
+std::size_t countOk(std::vector<container::Try<int>>& res) {
+    std::size_t ok = 0;
+    for (auto& r : res) {
+        ok += r && r.get() == 200;
+    }
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t const n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000;
+    std::size_t const k = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 16;
+
+    HttpServer serv{28220};
+    serv.addEndpoint<GET>("/", [] ENDPOINT {
+        co_await res.setStatusAndContent(Status::CODE_200, "Hello World!")
+                    .sendRes();
+    });
+    serv.asyncRun(1);
+    std::this_thread::sleep_for(std::chrono::milliseconds{300});
+
+    std::string const url = "http://127.0.0.1:28220/";
+    auto loop = std::make_shared<coroutine::EventLoop>();
+    Clients cs{loop, k};
+
+    bench("whenAll(vector):      ", n, [&] {
+        auto res = loop->sync(coroutine::whenAll(makeRequests(cs, url, n)));
+        return countOk(res);
+    });
+    bench("whenAll(range, K):    ", n, [&] {
+        auto res = loop->sync(coroutine::whenAll(makeRequests(cs, url, n), k));
+        return countOk(res);
+    });
+    bench("asCompleted(range, K):", n, [&] {
+        return loop->sync([](Clients& cs, std::string const& url, std::size_t n,
+                             std::size_t k) -> coroutine::Task<std::size_t> {
+            auto stream = coroutine::asCompleted(makeRequests(cs, url, n), k);
+            std::size_t ok = 0;
+            for (;;) {
+                auto item = co_await stream.next();
+                if (!item) {
+                    break;
+                }
+                ok += item->second && item->second.get() == 200;
+            }
+            co_return ok;
+        }(cs, url, n, k));
+    });
+
+    loop->sync([](Clients& cs) -> coroutine::Task<> {
+        for (auto& cli : cs.clients) {
+            co_await cli->coClose();
+        }
+    }(cs));
+    return 0;
+}
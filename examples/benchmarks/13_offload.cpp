@@ -0,0 +1,131 @@
+#include <HXLibs/net/ApiMacro.hpp>
+#include <HXLibs/net/client/HttpClient.hpp>
+#include <HXLibs/coroutine/awaiter/WhenAll.hpp>
+#include <HXLibs/coroutine/executor/Offload.hpp>
+#include <HXLibs/log/Log.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace HX;
+using namespace net;
+
+/**
+ * @brief offload 的延迟压测: 单线程服务端同时处理 CPU 密集的请求与小请求,
+ *        比较 CPU 工作在事件循环中直接执行与 offload 到线程池时, 小请求的延迟
+ * @note 用法: benchmarks_13_offload [小请求数=500] [CPU 工作毫秒数=5] [并发 CPU 请求数=4]
+ */
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::uint64_t burn(std::chrono::milliseconds dur) {
+    std::uint64_t h = 1469598103934665603ull;
+    auto const end = Clock::now() + dur;
+    while (Clock::now() < end) {
+        for (int i = 0; i < 1024; ++i) {
+            h = (h ^ static_cast<std::uint64_t>(i)) * 1099511628211ull;
+        }
+    }
+    return h;
+}
+
+coroutine::Task<> cpuLoad(HttpClient<NoneProxy>& cli, std::string const& url,
+                          std::atomic_bool const& stop) {
+    while (!stop.load(std::memory_order_relaxed)) {
+        auto res = co_await cli.coGet(url);
+        if (!res) {
+            break;
+        }
+    }
+}
+
+coroutine::Task<> cpuLoads(std::vector<std::unique_ptr<HttpClient<NoneProxy>>>& clis,
+                           std::string const& url, std::atomic_bool const& stop) {
+    std::vector<coroutine::Task<>> tasks;
+    for (auto& cli : clis) {
+        tasks.push_back(cpuLoad(*cli, url, stop));
+    }
+    co_await coroutine::whenAll(std::move(tasks));
+    for (auto& cli : clis) {
+        co_await cli->coClose();
+    }
+}
+
+void bench(char const* name, std::string const& cpuUrl, std::size_t n, std::size_t conc) {
+    std::atomic_bool stop{false};
+    std::thread load{[&] {
+        auto loop = std::make_shared<coroutine::EventLoop>();
+        std::vector<std::unique_ptr<HttpClient<NoneProxy>>> clis;
+        for (std::size_t i = 0; i < conc; ++i) {
+            clis.push_back(std::make_unique<HttpClient<NoneProxy>>(
+                HttpClientOptions<NoneProxy>{}, loop));
+        }
+        loop->sync(cpuLoads(clis, cpuUrl, stop));
+    }};
+    std::this_thread::sleep_for(std::chrono::milliseconds{100});
+
+    HttpClient<NoneProxy> cli;
+    std::vector<double> lat;
+    lat.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        auto const t0 = Clock::now();
+        auto res = cli.get("http://127.0.0.1:28221/small").get();
+        lat.push_back(std::chrono::duration<double, std::milli>(Clock::now() - t0).count());
+        if (!res) {
+            log::hxLog.error("request failed");
+            break;
+        }
+    }
+    stop = true;
+    load.join();
+    cli.close();
+
+    std::sort(lat.begin(), lat.end());
+    auto pct = [&](double p) {
+        return lat.empty() ? 0.0 : lat[static_cast<std::size_t>(p * static_cast<double>(lat.size() - 1))];
+    };
+    log::hxLog.info(name, "small requests p50:", pct(0.5), "ms, p99:", pct(0.99), "ms, max:", pct(1), "ms");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t const n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 500;
+    std::chrono::milliseconds const work{argc > 2 ? std::strtol(argv[2], nullptr, 10) : 5};
+    std::size_t const conc = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 4;
+
+    container::ThreadPool pool;
+    pool.setFixedThreadNum(static_cast<uint32_t>(conc));
+    pool.run<container::ThreadPool::Model::FixedSizeAndNoCheck>();
+
+    HttpServer serv{28221};
+    serv.addEndpoint<GET>("/small", [] ENDPOINT {
+        co_await res.setStatusAndContent(Status::CODE_200, "ok")
+                    .sendRes();
+    });
+    serv.addEndpoint<GET>("/cpu/inline", [=] ENDPOINT {
+        auto h = burn(work);
+        co_await res.setStatusAndContent(Status::CODE_200, std::to_string(h))
+                    .sendRes();
+    });
+    serv.addEndpoint<GET>("/cpu/offload", [=, &pool] ENDPOINT {
+        auto h = co_await coroutine::offload(
+            static_cast<coroutine::EventLoop&>(req.getIO()), pool, [=] {
+                return burn(work);
+            });
+        co_await res.setStatusAndContent(Status::CODE_200, std::to_string(h))
+                    .sendRes();
+    });
+    serv.asyncRun(1);
+    std::this_thread::sleep_for(std::chrono::milliseconds{300});
+
+    bench("inline: ", "http://127.0.0.1:28221/cpu/inline", n, conc);
+    bench("offload:", "http://127.0.0.1:28221/cpu/offload", n, conc);
+    return 0;
+}
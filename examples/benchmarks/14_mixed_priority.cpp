@@ -0,0 +1,160 @@
+#include <HXLibs/net/ApiMacro.hpp>
+#include <HXLibs/net/client/HttpClient.hpp>
+#include <HXLibs/log/Log.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+#endif
+
+using namespace HX;
+using namespace net;
+
+/**
+ * @brief 混合负载的压测: 若干连接持续下载大文件 (分块传输, 以 Bulk 优先级恢复),
+ *        同时测量小请求的延迟; 比较不限制与限制每一轮恢复数 (resumeBudget) 时小请求的 p99
+ * @note 用法: benchmarks_14_mixed_priority [小请求数=500] [下载连接数=32] [文件 MiB=8]
+ */
+
+#if defined(__linux__)
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr char kFilePath[] = "/tmp/hxlibs_bench_14_big.bin";
+
+int connectTo(std::uint16_t port) {
+    ::sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0 || ::connect(fd, reinterpret_cast<::sockaddr*>(&addr), sizeof(addr)) != 0) [[unlikely]] {
+        std::abort();
+    }
+    return fd;
+}
+
+/**
+ * @brief 反复下载大文件, 直到 stop (文件内容不含 '0', 以分块编码的结束标记判断一次下载完成)
+ */
+void download(std::uint16_t port, std::atomic_bool const& stop, std::atomic_size_t& bytes) {
+    int fd = connectTo(port);
+    std::string_view const req = "GET /big HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n";
+    std::vector<char> buf(1 << 16);
+    while (!stop.load(std::memory_order_relaxed)) {
+        if (::send(fd, req.data(), req.size(), 0) != static_cast<ssize_t>(req.size())) {
+            break;
+        }
+        std::string tail;
+        for (;;) {
+            auto n = ::recv(fd, buf.data(), buf.size(), 0);
+            if (n <= 0) {
+                ::close(fd);
+                return;
+            }
+            bytes += static_cast<std::size_t>(n);
+            tail.append(buf.data(), static_cast<std::size_t>(n));
+            if (tail.size() > 5) {
+                tail.erase(0, tail.size() - 5);
+            }
+            if (tail == "0\r\n\r\n") {
+                break;
+            }
+        }
+    }
+    ::close(fd);
+}
+
+void bench(char const* name, std::uint16_t port, unsigned int budget,
+           std::size_t n, std::size_t conns) {
+    HttpServer serv{port};
+    serv.addEndpoint<GET>("/small", [] ENDPOINT {
+        co_await res.setStatusAndContent(Status::CODE_200, "ok")
+                    .sendRes();
+    });
+    serv.addEndpoint<GET>("/big", [] ENDPOINT {
+        co_await res.useChunkedEncodingTransferFile(kFilePath);
+    });
+    HttpServerOptions opt{};
+    opt.eventLoop.resumeBudget = budget;
+    serv.asyncRun(1, []{}, 30_s, opt);
+    std::this_thread::sleep_for(std::chrono::milliseconds{300});
+
+    std::atomic_bool stop{false};
+    std::atomic_size_t bytes{0};
+    std::vector<std::thread> loaders;
+    for (std::size_t i = 0; i < conns; ++i) {
+        loaders.emplace_back(download, port, std::cref(stop), std::ref(bytes));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds{200});
+
+    std::vector<double> lat;
+    lat.reserve(n);
+    auto const t0 = Clock::now();
+    {
+        HttpClient<NoneProxy> cli;
+        std::string const url = "http://127.0.0.1:" + std::to_string(port) + "/small";
+        for (std::size_t i = 0; i < n; ++i) {
+            auto const t = Clock::now();
+            auto res = cli.get(url).get();
+            lat.push_back(std::chrono::duration<double, std::milli>(Clock::now() - t).count());
+            if (!res) {
+                log::hxLog.error("request failed");
+                break;
+            }
+        }
+        cli.close();
+    }
+    auto const sec = std::chrono::duration<double>(Clock::now() - t0).count();
+    stop = true;
+    for (auto& t : loaders) {
+        t.join();
+    }
+
+    std::sort(lat.begin(), lat.end());
+    auto pct = [&](double p) {
+        return lat.empty() ? 0.0 : lat[static_cast<std::size_t>(p * static_cast<double>(lat.size() - 1))];
+    };
+    log::hxLog.info(name, "small p50:", pct(0.5), "ms, p99:", pct(0.99), "ms, max:", pct(1),
+        "ms; bulk:", static_cast<double>(bytes.load()) / sec / (1 << 20), "MiB/s");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t const n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 500;
+    std::size_t const conns = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 32;
+    std::size_t const mib = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 8;
+    {
+        std::ofstream out{kFilePath, std::ios::binary};
+        std::string const block(1 << 20, 'x');
+        for (std::size_t i = 0; i < mib; ++i) {
+            out << block;
+        }
+    }
+    bench("resumeBudget = 0: ", 28222, 0, n, conns);
+    bench("resumeBudget = 4: ", 28223, 4, n, conns);
+    ::unlink(kFilePath);
+    return 0;
+}
+
+#else
+
+int main() {
+    return 0;
+}
+
+#endif // defined(__linux__)
@@ -0,0 +1,153 @@
+#include <HXLibs/net/ApiMacro.hpp>
+#include <HXLibs/log/Log.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string_view>
+#include <thread>
+
+#if defined(__linux__)
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+#endif
+
+using namespace HX;
+using namespace net;
+
+/**
+ * @brief 每个请求的堆分配次数: 同一个 keep-alive 连接上反复发送浏览器的典型请求,
+ *        统计整个进程 (服务端) 在此期间调用 operator new 的次数 / 请求数
+ * @note 用法: benchmarks_16_header_alloc [请求数=20000]
+ *       /plain 不读取请求头; /headers 通过 getHeaders() 读取 3 个请求头.
+ *       客户端使用阻塞套接字与栈上的缓冲区, 本身不分配内存.
+ */
+
+#if defined(__linux__)
+
+namespace {
+
+std::atomic_size_t gNewCount{0};
+
+constexpr std::string_view kReqTail =
+    " HTTP/1.1\r\n"
+    "Host: 127.0.0.1\r\n"
+    "User-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/126.0.0.0 Safari/537.36\r\n"
+    "Accept: text/html,application/xhtml+xml,application/xml;q=0.9,image/avif,image/webp,*/*;q=0.8\r\n"
+    "Accept-Language: en-US,en;q=0.9\r\n"
+    "Accept-Encoding: gzip, deflate, br, zstd\r\n"
+    "Cache-Control: max-age=0\r\n"
+    "Sec-Ch-Ua: \"Chromium\";v=\"126\", \"Google Chrome\";v=\"126\"\r\n"
+    "Sec-Ch-Ua-Mobile: ?0\r\n"
+    "Sec-Ch-Ua-Platform: \"Linux\"\r\n"
+    "Sec-Fetch-Dest: document\r\n"
+    "Sec-Fetch-Mode: navigate\r\n"
+    "Sec-Fetch-Site: none\r\n"
+    "Upgrade-Insecure-Requests: 1\r\n"
+    "Cookie: session=0123456789abcdef; theme=dark\r\n"
+    "Connection: keep-alive\r\n"
+    "\r\n";
+
+int connectTo(std::uint16_t port) {
+    ::sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0 || ::connect(fd, reinterpret_cast<::sockaddr*>(&addr), sizeof(addr)) != 0) [[unlikely]] {
+        std::abort();
+    }
+    return fd;
+}
+
+/**
+ * @brief 发送一个请求, 读到完整的响应 (响应体固定为 "ok")
+ */
+void roundTrip(int fd, std::string_view path) {
+    char req[1024];
+    std::memcpy(req, "GET ", 4);
+    std::memcpy(req + 4, path.data(), path.size());
+    std::memcpy(req + 4 + path.size(), kReqTail.data(), kReqTail.size());
+    std::size_t const len = 4 + path.size() + kReqTail.size();
+    if (::send(fd, req, len, 0) != static_cast<ssize_t>(len)) [[unlikely]] {
+        std::abort();
+    }
+    char buf[4096];
+    std::size_t n = 0;
+    while (!std::string_view{buf, n}.ends_with("\r\n\r\nok")) {
+        auto r = ::recv(fd, buf + n, sizeof(buf) - n, 0);
+        if (r <= 0) [[unlikely]] {
+            std::abort();
+        }
+        n += static_cast<std::size_t>(r);
+    }
+}
+
+double allocsPerRequest(std::uint16_t port, std::string_view path, std::size_t n) {
+    int fd = connectTo(port);
+    for (std::size_t i = 0; i < 100; ++i) {
+        roundTrip(fd, path); // 预热: 连接上的缓冲区等只分配一次
+    }
+    auto const before = gNewCount.load();
+    for (std::size_t i = 0; i < n; ++i) {
+        roundTrip(fd, path);
+    }
+    auto const after = gNewCount.load();
+    ::close(fd);
+    return static_cast<double>(after - before) / static_cast<double>(n);
+}
+
+} // namespace
+
+// 不内联, 以免 GCC 把 new 与 free 配对检查 (-Wmismatched-new-delete)
+[[gnu::noinline]] void* operator new(std::size_t size) {
+    gNewCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+
+[[gnu::noinline]] void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+[[gnu::noinline]] void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+int main(int argc, char** argv) {
+    std::size_t const n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000;
+    constexpr std::uint16_t port = 28224;
+    HttpServer serv{port};
+    serv.addEndpoint<GET>("/plain", [] ENDPOINT {
+        co_await res.setStatusAndContent(Status::CODE_200, "ok")
+                    .sendRes();
+    });
+    serv.addEndpoint<GET>("/headers", [] ENDPOINT {
+        auto const& headers = req.getHeaders();
+        bool const ok = headers.find("user-agent") != headers.end()
+                     && headers.find("accept-encoding") != headers.end()
+                     && headers.find("x-missing") == headers.end();
+        co_await res.setStatusAndContent(Status::CODE_200, ok ? "ok" : "no")
+                    .sendRes();
+    });
+    serv.asyncRun(1, []{}, 30_s);
+    std::this_thread::sleep_for(std::chrono::milliseconds{300});
+
+    log::hxLog.info("/plain:  ", allocsPerRequest(port, "/plain", n), "allocations / request");
+    log::hxLog.info("/headers:", allocsPerRequest(port, "/headers", n), "allocations / request");
+    return 0;
+}
+
+#else
+
+int main() {
+    return 0;
+}
+
+#endif // defined(__linux__)
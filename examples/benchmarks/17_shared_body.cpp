@@ -0,0 +1,149 @@
+#include <HXLibs/net/ApiMacro.hpp>
+#include <HXLibs/log/Log.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#if defined(__linux__)
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <pthread.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+#endif
+
+using namespace HX;
+using namespace net;
+
+/**
+ * @brief 缓存的响应体: 对比 setBody (每请求复制到连接的 _body) 与
+ *        setBodyView (借用) / shared_ptr<const string> (共享所有权)
+ * @note 用法: benchmarks_17_shared_body [响应体 KB=64] [请求数=20000]
+ *       客户端在同一个 keep-alive 连接上顺序请求, 统计 req/s 与 服务端每请求的 CPU 时间.
+ */
+
+#if defined(__linux__)
+
+namespace {
+
+int connectTo(std::uint16_t port) {
+    ::sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0 || ::connect(fd, reinterpret_cast<::sockaddr*>(&addr), sizeof(addr)) != 0) [[unlikely]] {
+        std::abort();
+    }
+    return fd;
+}
+
+/**
+ * @brief 顺序发送 n 个请求, 每个响应读满 响应头 + 响应体
+ * @return double 每秒请求数
+ */
+double benchOnce(std::uint16_t port, std::string_view path, std::size_t bodySize, std::size_t n) {
+    std::string req = "GET ";
+    req += path;
+    req += " HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n";
+    std::string buf(256 * 1024, '\0');
+    int fd = connectTo(port);
+    auto roundTrip = [&] {
+        if (::send(fd, req.data(), req.size(), 0) != static_cast<ssize_t>(req.size())) [[unlikely]] {
+            std::abort();
+        }
+        std::size_t got = 0;
+        std::size_t total = std::string::npos;
+        while (got != total) {
+            auto r = ::recv(fd, buf.data() + got, buf.size() - got, 0);
+            if (r <= 0) [[unlikely]] {
+                std::abort();
+            }
+            got += static_cast<std::size_t>(r);
+            if (total == std::string::npos) {
+                // 响应头较短, 第一次读取即可读到; 响应体固定为 bodySize
+                if (auto pos = std::string_view{buf.data(), got}.find("\r\n\r\n");
+                    pos != std::string_view::npos
+                ) {
+                    total = pos + 4 + bodySize;
+                }
+            }
+        }
+    };
+    for (std::size_t i = 0; i < 200; ++i) {
+        roundTrip(); // 预热
+    }
+    auto t0 = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < n; ++i) {
+        roundTrip();
+    }
+    auto sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    ::close(fd);
+    return static_cast<double>(n) / sec;
+}
+
+/**
+ * @brief 服务端线程的 CPU 时间 (秒)
+ */
+double threadCpuTime(::clockid_t clk) {
+    ::timespec ts{};
+    ::clock_gettime(clk, &ts);
+    return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) * 1e-9;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t const bodySize = (argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 64) << 10;
+    std::size_t const n = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 20000;
+    // 缓存的响应体, 如启动时生成的 JSON
+    auto const cached = std::make_shared<std::string const>(bodySize, 'x');
+
+    constexpr std::uint16_t port = 28226;
+    HttpServer serv{port};
+    ::clockid_t serverClock{};
+    serv.addEndpoint<GET>("/copy", [&] ENDPOINT {
+        co_await res.setStatusAndContent(Status::CODE_200, *cached)
+                    .sendRes();
+    });
+    serv.addEndpoint<GET>("/view", [&] ENDPOINT {
+        co_await res.setResLine(Status::CODE_200)
+                    .setContentType(TEXT)
+                    .setBodyView(*cached)
+                    .sendRes();
+    });
+    serv.addEndpoint<GET>("/shared", [&] ENDPOINT {
+        co_await res.setStatusAndContent(Status::CODE_200, cached)
+                    .sendRes();
+    });
+    serv.addEndpoint<GET>("/clock", [&] ENDPOINT {
+        ::pthread_getcpuclockid(::pthread_self(), &serverClock);
+        co_await res.setStatusAndContent(Status::CODE_200, "ok")
+                    .sendRes();
+    });
+    serv.asyncRun(1, []{}, 120_s);
+    std::this_thread::sleep_for(std::chrono::milliseconds{300});
+    benchOnce(port, "/clock", 2, 1); // 取得服务端 (单个工作线程) 的 CPU 时钟
+
+    for (std::string_view path : {"/copy", "/view", "/shared"}) {
+        auto const cpu0 = threadCpuTime(serverClock);
+        auto const rps = benchOnce(port, path, bodySize, n);
+        auto const cpu1 = threadCpuTime(serverClock);
+        log::hxLog.info(path, bodySize >> 10, "KB body,", rps, "req/s,",
+            (cpu1 - cpu0) * 1e6 / static_cast<double>(n + 200), "us server CPU / request");
+    }
+    return 0;
+}
+
+#else
+
+int main() {
+    return 0;
+}
+
+#endif // defined(__linux__)
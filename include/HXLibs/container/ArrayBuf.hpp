@@ -19,6 +19,7 @@
  */
 
 #include <span>
+#include <memory>
 #include <cstring>
 
 namespace HX::container {
@@ -89,5 +90,84 @@ private:
     T _arr[N];
 };
 
+/**
+ * @brief 与 ArrayBuf 接口一致, 但存储在堆上, 并且只有在第一次写入 (非 const 的 `data()`) 时才分配;
+ *        可以通过 `release()` 归还内存. 用于大部分时间都不需要缓冲区的对象 (如空闲的连接)
+ */
+template <typename T, std::size_t N>
+struct HeapArrayBuf {
+    HeapArrayBuf()
+        : _nowSize{}
+        , _arr{}
+    {}
+
+    /**
+     * @brief 把 s 复制/移动到缓冲区头部
+     * @warning s.size() <= N; s 可以是缓冲区的子区间, 也可以是外部的数据
+     * @param s 
+     */
+    void moveToHead(std::span<T const> s) {
+        _nowSize = s.size();
+        if (s.empty()) {
+            return; // 不需要为空数据分配内存
+        }
+        std::memmove(data(), s.data(), s.size());
+    }
+
+    void resetSize(std::size_t size) noexcept {
+        _nowSize = size;
+    }
+
+    void addSize(std::size_t size) noexcept {
+        _nowSize += size;
+    }
+
+    constexpr std::size_t size() const {
+        return _nowSize;
+    }
+
+    constexpr static std::size_t max_size() noexcept {
+        return N;
+    }
+
+    /**
+     * @brief 是否已经分配了内存
+     */
+    bool isAllocated() const noexcept {
+        return static_cast<bool>(_arr);
+    }
+
+    T const* data() const noexcept {
+        return _arr.get();
+    }
+
+    /**
+     * @brief 获取缓冲区, 如果还没有分配则分配 (不初始化内容)
+     * @return T* 
+     */
+    T* data() {
+        if (!_arr) [[unlikely]] {
+            _arr = std::make_unique_for_overwrite<T[]>(N);
+        }
+        return _arr.get();
+    }
+
+    void clear() noexcept {
+        _nowSize = 0;
+    }
+
+    /**
+     * @brief 清空并归还内存
+     */
+    void release() noexcept {
+        _nowSize = 0;
+        _arr.reset();
+    }
+
+private:
+    std::size_t _nowSize;
+    std::unique_ptr<T[]> _arr;
+};
+
 } // namespace HX::container
 
@@ -113,9 +113,11 @@ private:
             auto* loop = self._coEventLoop.get();
             std::move(self).thenTry([this, raii = loop->makeTheradTask(), _loop = loop](auto t) mutable {
                 _res.set(std::move(t));
-                _coroutine.resume(); // 执行完毕后, self 已经被销毁了.
-                raii.notify();
-                _loop->makeNopAioTask();
+                // 回到事件循环线程再恢复协程 (此时 await_suspend 必然已经执行完毕)
+                _loop->post([this, _raii = std::move(raii)]() mutable {
+                    _raii.notify();
+                    _coroutine.resume(); // 执行完毕后, self 已经被销毁了.
+                });
             });
         }
 
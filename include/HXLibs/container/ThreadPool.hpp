@@ -142,11 +142,20 @@ struct ThreadPool {
                 ans->unhandledException();
             }
         };
-        _taskQueue.emplace(std::make_unique<MoveOnlyFunctionAny<decltype(cb)>>(std::move(cb)));
-        _cv.notify_one();
+        pushTask(std::make_unique<MoveOnlyFunctionAny<decltype(cb)>>(std::move(cb)));
         return res;
     }
 
+    /**
+     * @brief 添加任务, 不返回 FutureResult (结果与异常由任务自行交付, 如 coroutine::offload)
+     * @tparam Func `void()`, 不应抛出异常
+     * @param func 
+     */
+    template <typename Func>
+    void post(Func&& func) {
+        pushTask(std::make_unique<MoveOnlyFunctionAny<std::decay_t<Func>>>(std::forward<Func>(func)));
+    }
+
     /**
      * @brief 启动线程池
      * @tparam Md 运行模式 (默认为新建一个管理者线程 (异步))
@@ -190,6 +199,15 @@ struct ThreadPool {
         }
     }
 private:
+    void pushTask(std::unique_ptr<MoveOnlyFunction> task) {
+        _taskQueue.emplace(std::move(task));
+        {
+            // 与工作线程检查队列到进入等待之间互斥, 避免丢失唤醒
+            std::lock_guard _{_mtx};
+        }
+        _cv.notify_one();
+    }
+
     /**
      * @brief 管理者检查线程
      * @param checkTimer 检查 间隔的时间 (ms)
@@ -0,0 +1,183 @@
+#pragma once
+/*
+ * Copyright Heng_Xin. All rights reserved.
+ *
+ * @Author: Heng_Xin
+ * @Date: 2026-10-18 09:12:36
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *	  https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include <ranges>
+#include <optional>
+#include <algorithm>
+
+#include <HXLibs/coroutine/awaiter/WhenAll.hpp>
+
+namespace HX::coroutine {
+
+/**
+ * @brief 按完成的先后逐个取得范围内元素的结果:
+ *        `auto stream = asCompleted(tasks, 8); while (auto item = co_await stream.next()) { ... }`
+ * @note 至多 maxConcurrency 个元素同时进行, 第一次 next() 时才启动.
+ *       结果, 完成队列与工作协程在构造 / 启动时按组一次分配.
+ *       消费者正在等待时, 完成元素的工作协程把控制权直接交给消费者 (对称转移), 自身暂停,
+ *       在消费者下一次 next() 时继续领取下一个元素; 否则结果在完成队列中排队.
+ *       流对象可以提前析构, 尚未完成的元素随之析构 (左值范围需由调用方随后析构).
+ * @tparam R 范围类型 (左值引用或值)
+ */
+template <typename R>
+class AsCompleted {
+public:
+    using ValueType = internal::WhenAllRangeValueType<R>;
+
+    AsCompleted(R range, std::size_t maxConcurrency)
+        : _range{std::forward<R>(range)}
+        , _results(static_cast<std::size_t>(std::ranges::size(_range)))
+        , _ready(_results.size())
+        , _head{0}
+        , _tail{0}
+        , _next{0}
+        , _maxConcurrency{maxConcurrency ? std::min(maxConcurrency, _results.size()) : _results.size()}
+        , _workers{}
+        , _parked{}
+        , _waiting{}
+    {}
+
+    AsCompleted& operator=(AsCompleted&&) noexcept = delete;
+
+    struct NextAwaiter {
+        bool await_ready() const noexcept {
+            auto& self = _self;
+            return self._parked.empty() && !self._workers.empty()
+                && (self._head != self._tail || self._head == self._results.size());
+        }
+
+        bool await_suspend(std::coroutine_handle<> coroutine) {
+            auto& self = _self;
+            // 此时 _waiting 为空, 工作协程完成的结果只会入队, 不会恢复消费者
+            if (self._workers.empty()) {
+                self._workers.reserve(self._maxConcurrency);
+                self._parked.reserve(self._maxConcurrency);
+                for (std::size_t i = 0; i < self._maxConcurrency; ++i) {
+                    self._workers.push_back(work(self));
+                    static_cast<std::coroutine_handle<>>(self._workers.back()).resume();
+                }
+            } else {
+                while (!self._parked.empty()) {
+                    auto worker = self._parked.back();
+                    self._parked.pop_back();
+                    worker.resume();
+                }
+            }
+            if (self._head != self._tail || self._head == self._results.size()) {
+                return false;
+            }
+            self._waiting = coroutine;
+            return true;
+        }
+
+        /**
+         * @return std::optional<std::pair<std::size_t, ValueType>> 元素的下标与结果; 全部取完后为空
+         */
+        std::optional<std::pair<std::size_t, ValueType>> await_resume() {
+            auto& self = _self;
+            if (self._head == self._tail) {
+                return std::nullopt;
+            }
+            auto const i = self._ready[self._head++];
+            return std::pair<std::size_t, ValueType>{i, std::move(self._results[i])};
+        }
+
+        AsCompleted& _self;
+    };
+
+    /**
+     * @brief 取得下一个完成的元素
+     * @return NextAwaiter `co_await` 得到 std::optional<std::pair<下标, container::Try<T>>>
+     */
+    NextAwaiter next() noexcept {
+        return {*this};
+    }
+
+    /**
+     * @brief 元素总数
+     */
+    std::size_t size() const noexcept {
+        return _results.size();
+    }
+
+private:
+    /**
+     * @brief 把控制权交给正在等待的消费者, 自身暂停直到下一次 next()
+     */
+    struct HandOffAwaiter {
+        constexpr bool await_ready() const noexcept { return false; }
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> coroutine) noexcept {
+            _self._parked.push_back(coroutine); // 已预留, 不会分配
+            return std::exchange(_self._waiting, {});
+        }
+        constexpr void await_resume() const noexcept {}
+
+        AsCompleted& _self;
+    };
+
+    static Task<std::coroutine_handle<>, internal::WhenAllPromise> work(AsCompleted& self) {
+        auto const n = self._results.size();
+        for (std::size_t i = self._next++; i < n; i = self._next++) {
+            auto&& t = std::ranges::begin(self._range)[
+                static_cast<std::ranges::range_difference_t<R>>(i)];
+            try {
+                if constexpr (std::is_void_v<AwaiterReturnType<decltype(t)>>) {
+                    static_cast<void>(co_await t);
+                    self._results[i].setVal(container::NonVoidType<>{});
+                } else {
+                    self._results[i].setVal(co_await t);
+                }
+            } catch (...) {
+                self._results[i].setException(std::current_exception());
+            }
+            self._ready[self._tail++] = i;
+            if (self._waiting) {
+                co_await HandOffAwaiter{self};
+            }
+        }
+        co_return std::noop_coroutine();
+    }
+
+    R _range;
+    std::vector<ValueType> _results;
+    std::vector<std::size_t> _ready;  // 完成队列 (每个下标只入队一次, 故无需环形)
+    std::size_t _head;
+    std::size_t _tail;
+    std::size_t _next;                // 下一个待启动的下标
+    std::size_t _maxConcurrency;
+    std::vector<Task<std::coroutine_handle<>, internal::WhenAllPromise>> _workers;
+    std::vector<std::coroutine_handle<>> _parked; // 已把控制权交给消费者的工作协程
+    std::coroutine_handle<> _waiting; // 正在等待的消费者
+};
+
+/**
+ * @brief 按完成的先后逐个取得范围内元素的结果, 见 AsCompleted
+ * @param range 可随机访问的范围, 元素可被 co_await; 传入右值则由返回的对象持有
+ * @param maxConcurrency 同时进行的元素数上限, 0 表示不限
+ */
+template <std::ranges::random_access_range R>
+    requires (std::ranges::sized_range<R>
+           && AwaitableLike<std::ranges::range_reference_t<R>>)
+[[nodiscard]] AsCompleted<R> asCompleted(R&& range, std::size_t maxConcurrency = 0) {
+    return {std::forward<R>(range), maxConcurrency};
+}
+
+} // namespace HX::coroutine
@@ -19,6 +19,9 @@
  */
 
 #include <span>
+#include <vector>
+#include <ranges>
+#include <algorithm>
 
 #include <HXLibs/coroutine/task/Task.hpp>
 #include <HXLibs/coroutine/concepts/Awaiter.hpp>
@@ -142,6 +145,83 @@ auto whenAll(Ts&&... ts) {
 
 namespace internal {
 
+/**
+ * @brief 动态数量的 WhenAll 中每个元素的结果类型
+ */
+template <typename R>
+using WhenAllRangeValueType = container::Try<
+    AwaiterReturnType<std::ranges::range_reference_t<R>>
+>;
+
+/**
+ * @brief 动态数量的 WhenAll 的工作协程: 依次领取下一个下标并等待该元素, 直到领完
+ */
+template <typename R, typename Res>
+Task<std::coroutine_handle<>, WhenAllPromise> allRangeWorker(
+    R& range, Res& res, std::size_t& next, WhenAllCtlBlock& ctlBlock
+) {
+    for (std::size_t i = next++; i < res.size(); i = next++) {
+        auto&& t = std::ranges::begin(range)[static_cast<std::ranges::range_difference_t<R>>(i)];
+        try {
+            if constexpr (std::is_void_v<AwaiterReturnType<decltype(t)>>) {
+                static_cast<void>(co_await t);
+                res[i].setVal(container::NonVoidType<>{});
+            } else {
+                res[i].setVal(co_await t);
+            }
+        } catch (...) {
+            res[i].setException(std::current_exception());
+        }
+    }
+    if (--ctlBlock.cnt) {
+        co_return std::noop_coroutine();
+    }
+    co_return ctlBlock.previous;
+}
+
+/**
+ * @param range 右值时移入协程帧, 左值时为引用
+ */
+template <typename R, typename Res = std::vector<WhenAllRangeValueType<R>>>
+Task<Res> whenAllRange(R range, std::size_t maxConcurrency) {
+    // 1. 结果, 控制块与工作协程都按组分配, 而不是按元素
+    Res res(static_cast<std::size_t>(std::ranges::size(range)));
+    if (res.empty()) {
+        co_return res;
+    }
+    WhenAllCtlBlock block;
+    block.cnt = maxConcurrency ? std::min(maxConcurrency, res.size()) : res.size();
+    std::size_t next = 0;
+
+    // 2. 至多 maxConcurrency 个工作协程, 每个依次等待若干个元素
+    std::vector<Task<std::coroutine_handle<>, WhenAllPromise>> cos;
+    cos.reserve(block.cnt);
+    for (std::size_t i = 0; i < block.cnt; ++i) {
+        cos.push_back(allRangeWorker(range, res, next, block));
+    }
+
+    // 3. 启动并等待全部完成
+    co_await WhenAllAwaiter{cos, block};
+    co_return res;
+}
+
+} // namespace internal
+
+/**
+ * @brief 等待范围内的所有元素 (数量在运行时确定), 如 `whenAll(std::vector<Task<T>>)`
+ * @param range 可随机访问的范围, 元素可被 co_await; 传入右值则由返回的协程持有
+ * @param maxConcurrency 同时进行的元素数上限, 0 表示不限; 元素按下标顺序启动
+ * @return Task<std::vector<container::Try<T>>> 与范围的下标一一对应
+ */
+template <std::ranges::random_access_range R>
+    requires (std::ranges::sized_range<R>
+           && AwaitableLike<std::ranges::range_reference_t<R>>)
+auto whenAll(R&& range, std::size_t maxConcurrency = 0) {
+    return internal::whenAllRange<R>(std::forward<R>(range), maxConcurrency);
+}
+
+namespace internal {
+
 template <AwaitableLike... Ts>
 struct [[nodiscard]] WhenAllWrap {
 private:
@@ -20,6 +20,10 @@
 
 #include <utility>
 #include <span>
+#include <vector>
+#include <ranges>
+#include <optional>
+#include <stdexcept>
 
 #include <HXLibs/container/Uninitialized.hpp>
 #include <HXLibs/container/UninitializedNonVoidVariant.hpp>
@@ -147,6 +151,11 @@ Task<ResType> whenAny(std::index_sequence<Idx...>, Ts&&... ts) {
 
 } // namespace internal
 
+/**
+ * @brief 等待其中任意一个完成
+ * @note 返回时落败的分支随协程帧一并析构; 其中仍在内核中的 AioTask 会按 user_data 提交取消,
+ *       CQE 到达后由事件循环回收, 不会再恢复落败的分支.
+ */
 template <AwaitableLike... Ts>
 [[nodiscard]] auto whenAny(Ts&&... ts) {
     return internal::whenAny(
@@ -157,6 +166,76 @@ template <AwaitableLike... Ts>
 
 namespace internal {
 
+/**
+ * @brief 动态数量的 WhenAny 的结果: 最先完成的元素的下标与值
+ */
+template <typename R>
+using WhenAnyRangeReturnType = std::pair<
+    std::size_t,
+    container::NonVoidType<AwaiterReturnType<std::ranges::range_reference_t<R>>>
+>;
+
+template <typename R, typename Res>
+Task<std::coroutine_handle<>, WhenAnyPromise> anyRangeStart(
+    R& range, std::size_t idx, Res& res, WhenAnyCtlBlock& ctlBlock
+) {
+    try {
+        auto&& t = std::ranges::begin(range)[static_cast<std::ranges::range_difference_t<R>>(idx)];
+        if constexpr (std::is_void_v<AwaiterReturnType<decltype(t)>>) {
+            static_cast<void>(co_await t);
+            res.emplace(idx, container::NonVoidType<>{});
+        } else {
+            res.emplace(idx, co_await t);
+        }
+    } catch (...) {
+        ctlBlock._exception = std::current_exception();
+    }
+    if (ctlBlock.isInit) [[likely]] {
+        co_return ctlBlock.previous;
+    }
+    ctlBlock.isBrack = true;
+    co_return std::noop_coroutine();
+}
+
+template <typename R, typename Res = WhenAnyRangeReturnType<R>>
+Task<Res> whenAnyRange(R range) {
+    auto const n = static_cast<std::size_t>(std::ranges::size(range));
+    if (!n) [[unlikely]] {
+        throw std::invalid_argument{"whenAny: the range is empty"};
+    }
+    // 持有的范围移为局部变量, 使落败的元素在 co_return 时 (而非协程帧析构时) 随 cos 一并析构,
+    // 否则它们仍可能完成, 并恢复已析构的 anyRangeStart
+    R owned = std::forward<R>(range);
+    std::optional<Res> res;
+    WhenAnyCtlBlock block;
+    std::vector<Task<std::coroutine_handle<>, WhenAnyPromise>> cos;
+    cos.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        cos.push_back(anyRangeStart(owned, i, res, block));
+    }
+    co_await WhenAnyAwaiter{cos, block};
+    if (block._exception) [[unlikely]] {
+        std::rethrow_exception(block._exception);
+    }
+    co_return std::move(*res);
+}
+
+} // namespace internal
+
+/**
+ * @brief 等待范围内任意一个元素完成 (数量在运行时确定); 落败的元素处理同 whenAny
+ * @param range 非空, 可随机访问的范围, 元素可被 co_await; 传入右值则由返回的协程持有
+ * @return Task<std::pair<std::size_t, T>> 最先完成的元素的下标与值
+ */
+template <std::ranges::random_access_range R>
+    requires (std::ranges::sized_range<R>
+           && AwaitableLike<std::ranges::range_reference_t<R>>)
+[[nodiscard]] auto whenAny(R&& range) {
+    return internal::whenAnyRange<R>(std::forward<R>(range));
+}
+
+namespace internal {
+
 template <AwaitableLike... Ts>
 struct [[nodiscard]] WhenAnyWrap {
 private:
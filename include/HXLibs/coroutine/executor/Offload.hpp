@@ -0,0 +1,245 @@
+#pragma once
+/*
+ * Copyright Heng_Xin. All rights reserved.
+ *
+ * @Author: Heng_Xin
+ * @Date: 2026-10-18 10:26:51
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *	  https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <coroutine>
+#include <optional>
+#include <stop_token>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <HXLibs/container/ThreadPool.hpp>
+#include <HXLibs/container/Try.hpp>
+#include <HXLibs/coroutine/loop/EventLoop.hpp>
+
+namespace HX::coroutine {
+
+namespace internal {
+
+template <typename Func>
+struct OffloadResult {
+    using Type = std::invoke_result_t<Func&>;
+};
+
+template <typename Func>
+    requires (std::is_invocable_v<Func&, std::stop_token>)
+struct OffloadResult<Func> {
+    using Type = std::invoke_result_t<Func&, std::stop_token>;
+};
+
+/**
+ * @brief offload 的共享状态 (堆上), 由 awaiter 与线程池中的工作各持有一个引用
+ * @note 自身即为投递节点: 工作线程执行完毕后经 EventLoop::postNode (无锁入队 + eventfd 唤醒)
+ *       交回事件循环, 不经过 FutureResult 的互斥锁与条件变量.
+ *       awaiter 先于工作析构 (如 whenAny 中落败) 时标记为已放弃, 迟到的结果被直接丢弃.
+ * @tparam Func
+ */
+template <typename Func>
+struct OffloadState : PostNode {
+    using ResType = typename OffloadResult<Func>::Type;
+
+    template <typename Fn>
+    OffloadState(EventLoop& loop, Fn&& func, std::stop_token token)
+        : PostNode{nullptr, &OffloadState::invoke}
+        , _loop{loop}
+        , _func{std::forward<Fn>(func)}
+        , _stop{}
+        , _onStop{std::move(token), StopForwarder{&_stop}}
+        , _res{}
+        , _coroutine{}
+        , _keepAlive{}
+        , _refs{1}
+        , _abandoned{false}
+    {}
+
+    OffloadState& operator=(OffloadState&&) noexcept = delete;
+
+    void addRef() noexcept {
+        _refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void release() noexcept {
+        if (_refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete this;
+        }
+    }
+
+    /**
+     * @brief 在线程池中执行
+     */
+    void work() noexcept {
+        try {
+            if (_abandoned.load(std::memory_order_acquire) || _stop.stop_requested()) {
+                throw std::system_error{std::make_error_code(std::errc::operation_canceled)};
+            }
+            if constexpr (std::is_invocable_v<Func&, std::stop_token>) {
+                if constexpr (std::is_void_v<ResType>) {
+                    _func(_stop.get_token());
+                    _res.setVal(container::NonVoidType<>{});
+                } else {
+                    _res.setVal(_func(_stop.get_token()));
+                }
+            } else {
+                if constexpr (std::is_void_v<ResType>) {
+                    _func();
+                    _res.setVal(container::NonVoidType<>{});
+                } else {
+                    _res.setVal(_func());
+                }
+            }
+        } catch (...) {
+            _res.setException(std::current_exception());
+        }
+        // 之后 *this 可能已被释放
+        _loop.postNode(this);
+    }
+
+    static void invoke(PostNode* node, bool isRun) {
+        auto* self = static_cast<OffloadState*>(node);
+        if (isRun) {
+            self->_keepAlive->notify();
+        }
+        auto const coroutine = self->_abandoned.load(std::memory_order_acquire)
+            ? std::coroutine_handle<>{}
+            : self->_coroutine;
+        self->release(); // 工作持有的引用
+        if (isRun && coroutine) {
+            coroutine.resume();
+        }
+    }
+
+    /**
+     * @brief 把调用方的 stop_token 转发到内部的 stop_source (awaiter 析构时也会请求停止)
+     */
+    struct StopForwarder {
+        std::stop_source* _stop;
+        void operator()() const noexcept {
+            _stop->request_stop();
+        }
+    };
+
+    EventLoop& _loop;
+    Func _func;
+    std::stop_source _stop;
+    std::stop_callback<StopForwarder> _onStop;
+    container::Try<ResType> _res;
+    std::coroutine_handle<> _coroutine;
+    std::optional<decltype(std::declval<EventLoop&>().makeTheradTask())> _keepAlive;
+    std::atomic_uint _refs;
+    std::atomic_bool _abandoned;
+};
+
+} // namespace internal
+
+/**
+ * @brief 把阻塞的工作交给线程池执行, 完成后在原事件循环中恢复, 见 offload
+ * @note 工作与结果位于 internal::OffloadState 中, 不随协程帧析构;
+ *       awaiter 在工作完成前析构时, 请求停止并放弃结果, 不会再恢复协程.
+ * @tparam Func
+ */
+template <typename Func>
+class OffloadAwaiter {
+    using State = internal::OffloadState<Func>;
+public:
+    using ResType = typename State::ResType;
+
+    template <typename Fn>
+    OffloadAwaiter(EventLoop& loop, container::ThreadPool& pool, Fn&& func, std::stop_token token)
+        : _pool{pool}
+        , _state{new State{loop, std::forward<Fn>(func), std::move(token)}}
+    {}
+
+    OffloadAwaiter(OffloadAwaiter&& that) noexcept
+        : _pool{that._pool}
+        , _state{std::exchange(that._state, nullptr)}
+    {}
+
+    OffloadAwaiter& operator=(OffloadAwaiter&&) noexcept = delete;
+
+    ~OffloadAwaiter() noexcept {
+        if (_state) {
+            // 工作可能仍在执行: 请求停止, 迟到的结果由事件循环丢弃
+            _state->_abandoned.store(true, std::memory_order_release);
+            _state->_stop.request_stop();
+            _state->release();
+        }
+    }
+
+    constexpr bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> coroutine) {
+        _state->_coroutine = coroutine;
+        // 工作执行期间让事件循环保持运行
+        _state->_keepAlive.emplace(_state->_loop.makeTheradTask());
+        _state->addRef();
+        try {
+            _pool.post([state = _state] { state->work(); });
+        } catch (...) {
+            _state->_keepAlive->notify();
+            _state->_keepAlive.reset();
+            _state->release();
+            throw;
+        }
+    }
+
+    ResType await_resume() {
+        if (!_state->_res) {
+            _state->_res.rethrow();
+        }
+        if constexpr (!std::is_void_v<ResType>) {
+            return _state->_res.move();
+        }
+    }
+
+private:
+    container::ThreadPool& _pool;
+    State* _state;
+};
+
+/**
+ * @brief 把阻塞的工作 (CPU 密集计算, 同步的文件 / 数据库调用等) 交给线程池执行,
+ *        完成后回到 loop 中恢复: `auto v = co_await offload(loop, pool, [] { return heavy(); });`
+ * @note 等待期间事件循环照常处理其他协程; 工作中抛出的异常在 co_await 处重新抛出.
+ *       取消: 工作开始前 token 已请求停止, 则不执行, co_await 抛出
+ *       std::system_error (std::errc::operation_canceled); 若 func 接受 std::stop_token,
+ *       则把 token 传给它, 由其在执行中自行检查.
+ *       awaiter 被放弃 (如 `whenAny(offload(...), timer)` 中超时先完成) 时同样请求停止,
+ *       工作的结果被丢弃; 事件循环会等到工作结束后才退出.
+ * @warning 在等待期间, func 由工作线程调用, 不应访问事件循环中的其他非线程安全的状态
+ * @param loop 恢复协程的事件循环 (即当前协程所在的事件循环)
+ * @param pool 执行工作的线程池
+ * @param func `T()` 或 `T(std::stop_token)`
+ * @param token
+ * @return OffloadAwaiter `co_await` 得到 func 的返回值
+ */
+template <typename Func>
+    requires (std::is_invocable_v<std::decay_t<Func>&>
+           || std::is_invocable_v<std::decay_t<Func>&, std::stop_token>)
+[[nodiscard]] OffloadAwaiter<std::decay_t<Func>> offload(
+    EventLoop& loop,
+    container::ThreadPool& pool,
+    Func&& func,
+    std::stop_token token = {}
+) {
+    return {loop, pool, std::forward<Func>(func), std::move(token)};
+}
+
+} // namespace HX::coroutine
@@ -0,0 +1,218 @@
+#pragma once
+/*
+ * Copyright Heng_Xin. All rights reserved.
+ *
+ * @Author: Heng_Xin
+ * @Date: 2026-10-17 11:02:48
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *	  https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <span>
+#include <memory>
+#include <utility>
+#include <cstdint>
+
+#include <HXLibs/platform/EventLoopApi.hpp>
+#include <HXLibs/coroutine/loop/EpollRing.hpp>
+
+#if defined(__linux__)
+
+namespace HX::coroutine {
+
+/**
+ * @brief io_uring 的提供缓冲区环 (provided buffer ring, io_uring_register_buf_ring)
+ * @note 所有缓冲区由事件循环共享, 内核只在数据到达时才从环中挑选一个缓冲区;
+ *       因此空闲连接不再需要常驻的读缓冲区. 缓冲区用完后需要归还 (见 ProvidedBuffer).
+ */
+class BufRing {
+public:
+    BufRing() noexcept
+        : _br{}
+        , _bufs{}
+        , _entries{}
+        , _bufSize{}
+        , _group{}
+    {}
+
+    BufRing& operator=(BufRing&&) noexcept = delete;
+
+    /**
+     * @brief 注册缓冲区环
+     * @param ring
+     * @param entries 缓冲区个数 (必须为 2 的幂, 且不大于 32768)
+     * @param bufSize 每个缓冲区的大小
+     * @param group 缓冲区组 id
+     * @return true 注册成功; false 内核不支持 (此时不启用)
+     */
+    bool init(::io_uring* ring, unsigned int entries, unsigned int bufSize, unsigned short group) {
+        int ret = 0;
+        return fill(::io_uring_setup_buf_ring(ring, entries, group, 0, &ret),
+                    entries, bufSize, group);
+    }
+
+    /**
+     * @brief 在 epoll 后端上创建缓冲区环 (由 EpollRing 在用户态模拟, 随其一起释放)
+     * @return true 成功; false 参数不合法 (此时不启用)
+     */
+    bool init(internal::EpollRing& ring, unsigned int entries, unsigned int bufSize,
+              unsigned short group) {
+        return fill(ring.setupBufRing(entries, group), entries, bufSize, group);
+    }
+
+    /**
+     * @brief 注销缓冲区环 (需要在 io_uring_queue_exit 之前调用)
+     * @param ring
+     */
+    void destroy(::io_uring* ring) noexcept {
+        if (_br) {
+            ::io_uring_free_buf_ring(ring, _br, _entries, _group);
+            _br = nullptr;
+        }
+    }
+
+    bool isEnabled() const noexcept {
+        return _br;
+    }
+
+    unsigned short group() const noexcept {
+        return _group;
+    }
+
+    unsigned int bufSize() const noexcept {
+        return _bufSize;
+    }
+
+    /**
+     * @brief 获取内核挑选的缓冲区
+     * @param bid 缓冲区 id (cqe->flags >> IORING_CQE_BUFFER_SHIFT)
+     * @param size 有效数据长度
+     * @return std::span<char>
+     */
+    std::span<char> buffer(unsigned short bid, std::size_t size) const noexcept {
+        return {_bufs.get() + std::size_t{bid} * _bufSize, size};
+    }
+
+    /**
+     * @brief 把缓冲区归还给内核
+     * @param bid 缓冲区 id
+     */
+    void release(unsigned short bid) noexcept {
+        ::io_uring_buf_ring_add(
+            _br, _bufs.get() + std::size_t{bid} * _bufSize, _bufSize, bid, mask(), 0);
+        ::io_uring_buf_ring_advance(_br, 1);
+    }
+
+private:
+    bool fill(::io_uring_buf_ring* br, unsigned int entries, unsigned int bufSize,
+              unsigned short group) {
+        _br = br;
+        if (!_br) [[unlikely]] {
+            return false;
+        }
+        _bufs = std::make_unique_for_overwrite<char[]>(std::size_t{entries} * bufSize);
+        _entries = entries;
+        _bufSize = bufSize;
+        _group = group;
+        for (unsigned int i = 0; i < entries; ++i) {
+            ::io_uring_buf_ring_add(
+                _br, _bufs.get() + std::size_t{i} * bufSize, bufSize,
+                static_cast<unsigned short>(i), mask(), static_cast<int>(i));
+        }
+        ::io_uring_buf_ring_advance(_br, static_cast<int>(entries));
+        return true;
+    }
+
+    int mask() const noexcept {
+        return ::io_uring_buf_ring_mask(_entries);
+    }
+
+    ::io_uring_buf_ring* _br;
+    std::unique_ptr<char[]> _bufs;  // 所有缓冲区的连续内存
+    unsigned int _entries;
+    unsigned int _bufSize;
+    unsigned short _group;
+};
+
+/**
+ * @brief 从缓冲区环中借出的缓冲区, 析构时自动归还给内核
+ * @note `res()` 与普通 recv 的返回值一致: `> 0` 为读取的字节数; `== 0` 为连接断开;
+ *       `< 0` 为错误码 (如 `-ENOBUFS` 表示缓冲区环已被借空; `-ETIME` 表示超时)
+ */
+class ProvidedBuffer {
+public:
+    explicit ProvidedBuffer(int res) noexcept
+        : _ring{}
+        , _bid{}
+        , _res{res}
+    {}
+
+    ProvidedBuffer(BufRing& ring, unsigned short bid, int res) noexcept
+        : _ring{&ring}
+        , _bid{bid}
+        , _res{res}
+    {}
+
+    ProvidedBuffer(ProvidedBuffer&& that) noexcept
+        : _ring{std::exchange(that._ring, nullptr)}
+        , _bid{that._bid}
+        , _res{that._res}
+    {}
+
+    ProvidedBuffer& operator=(ProvidedBuffer&& that) noexcept {
+        if (this != &that) {
+            release();
+            _ring = std::exchange(that._ring, nullptr);
+            _bid = that._bid;
+            _res = that._res;
+        }
+        return *this;
+    }
+
+    int res() const noexcept {
+        return _res;
+    }
+
+    /**
+     * @brief 获取读取到的数据
+     * @return std::span<char>
+     */
+    std::span<char> data() const noexcept {
+        if (!_ring) [[unlikely]] {
+            return {};
+        }
+        return _ring->buffer(_bid, static_cast<std::size_t>(_res));
+    }
+
+    /**
+     * @brief 提前归还缓冲区
+     */
+    void release() noexcept {
+        if (_ring) {
+            std::exchange(_ring, nullptr)->release(_bid);
+        }
+    }
+
+    ~ProvidedBuffer() noexcept {
+        release();
+    }
+
+private:
+    BufRing* _ring;
+    unsigned short _bid;
+    int _res;
+};
+
+} // namespace HX::coroutine
+
+#endif // defined(__linux__)
@@ -0,0 +1,829 @@
+#pragma once
+/*
+ * Copyright Heng_Xin. All rights reserved.
+ *
+ * @Author: Heng_Xin
+ * @Date: 2026-10-18 14:06:21
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *	  https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <map>
+#include <deque>
+#include <array>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <limits>
+#include <cerrno>
+#include <cstring>
+#include <cstdint>
+#include <utility>
+#include <optional>
+#include <algorithm>
+#include <system_error>
+#include <unordered_map>
+
+#include <HXLibs/platform/EventLoopApi.hpp>
+
+#if defined(__linux__)
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace HX::coroutine::internal {
+
+/**
+ * @brief epoll 后端产生的完成事件 (含义与 io_uring_cqe 一致)
+ */
+struct EpollCqe {
+    std::uint64_t userData;
+    int res;
+    unsigned int flags;
+};
+
+/**
+ * @brief 在 epoll 上模拟 io_uring 的 SQ / CQ, 用于内核不支持 (或被 seccomp 禁止) io_uring 的环境
+ * @note AioTask 照常填写 SQE; `submit` 时按顺序执行: 先乐观地直接调用系统调用,
+ *       返回 EAGAIN 时才在 fd 上等待 (边沿触发, 每个 fd 只注册一次), 就绪后按 FIFO 重试.
+ *       每个 SQE 恰好产生一个 CQE (多发 accept 除外, 同 io_uring). 普通文件的读写与
+ *       openat / statx / close 同步执行.
+ *       支持 IOSQE_IO_LINK 链, LINK_TIMEOUT, ASYNC_CANCEL, 多发 accept / recv,
+ *       注册文件表与提供缓冲区环 (均在用户态模拟); 零拷贝发送返回 -EOPNOTSUPP, 调用方会回退为普通发送.
+ * @warning fd 是否已注册到 epoll 是按 fd 号记录的 (经由 SQE 关闭 / 创建 fd 时会重置);
+ *          在事件循环之外 close 的 fd, 若其号被事件循环之外创建的 fd 复用, 则不能再在其上等待
+ */
+class EpollRing {
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief 系统调用返回 EAGAIN, 需要等待 fd 就绪
+     */
+    static constexpr int kWouldBlock = std::numeric_limits<int>::min();
+
+    enum class FdKind : std::uint8_t {
+        Unknown,
+        File,   // 普通文件 / 块设备: 同步读写
+        Socket, // 套接字: recv / send (MSG_DONTWAIT)
+        Stream, // 其他 (管道, eventfd 等): 设置 O_NONBLOCK 后 read / write
+    };
+
+    enum class WaitOn : std::uint8_t {
+        None,
+        Read,
+        Write,
+        Poll,
+    };
+
+    struct Op {
+        int fd;             // 实际的 fd (已解析注册文件表)
+        Op* next;           // 链中的下一个操作 (尚未开始)
+        Op* timeout;        // 链接在其后的 LINK_TIMEOUT
+        Op* target;         // LINK_TIMEOUT: 所限制的操作
+        Clock::duration dur;                               // LINK_TIMEOUT: 超时时间
+        std::multimap<Clock::time_point, Op*>::iterator timer; // LINK_TIMEOUT: 定时器
+        bool hasTimer;
+        bool inProgress;    // connect 已发起
+        WaitOn waitOn;
+        unsigned int cqeFlags; // 完成时的 cqe->flags (如 IORING_CQE_F_BUFFER)
+        std::unique_ptr<::io_uring_sqe> sqe; // SQE 的副本
+    };
+
+    /**
+     * @brief 模拟的提供缓冲区环: 应用推进 tail (io_uring_buf_ring_add / advance), 这里推进 head
+     */
+    struct ProvidedRing {
+        std::unique_ptr<::io_uring_buf[]> mem;
+        unsigned int entries;
+        unsigned short group;
+        std::uint16_t head;
+
+        ::io_uring_buf_ring* ring() const noexcept {
+            return reinterpret_cast<::io_uring_buf_ring*>(mem.get());
+        }
+    };
+
+    struct FdState {
+        FdKind kind = FdKind::Unknown;
+        bool registered = false;    // 已注册到 epoll
+        bool nonblock = false;      // 已设置 O_NONBLOCK
+        std::deque<Op*> readers{};  // 等待可读的操作
+        std::deque<Op*> writers{};  // 等待可写的操作
+        std::vector<Op*> pollers{}; // POLL_ADD
+    };
+
+public:
+    /**
+     * @brief 创建 epoll 实例
+     * @param entries SQ 的长度
+     * @param fixedFiles 模拟的注册文件表的槽位数
+     */
+    EpollRing(unsigned int entries, unsigned int fixedFiles)
+        : _epfd{::epoll_create1(EPOLL_CLOEXEC)}
+        , _sq(std::max(entries, 1U))
+        , _sqCount{}
+        , _cq{}
+        , _cqSpare{}
+        , _files(fixedFiles, -1)
+        , _bufRings{}
+        , _fds{}
+        , _pending{}
+        , _timers{}
+        , _ops{}
+        , _freeOps{}
+        , _events{}
+    {
+        if (_epfd < 0) [[unlikely]] {
+            throw std::system_error(errno, std::system_category(), "epoll_create1");
+        }
+    }
+
+    EpollRing& operator=(EpollRing&&) noexcept = delete;
+
+    ~EpollRing() noexcept {
+        for (int fd : _files) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+        ::close(_epfd);
+    }
+
+    /**
+     * @brief 获取一个 SQE
+     * @return ::io_uring_sqe* SQ 已满时为 nullptr (需要先 `submit`)
+     */
+    ::io_uring_sqe* getSqe() noexcept {
+        if (_sqCount == _sq.size()) [[unlikely]] {
+            return nullptr;
+        }
+        auto* sqe = &_sq[_sqCount++];
+        std::memset(sqe, 0, sizeof(*sqe));
+        return sqe;
+    }
+
+    unsigned int spaceLeft() const noexcept {
+        return static_cast<unsigned int>(_sq.size() - _sqCount);
+    }
+
+    unsigned int entries() const noexcept {
+        return static_cast<unsigned int>(_sq.size());
+    }
+
+    unsigned int fixedFiles() const noexcept {
+        return static_cast<unsigned int>(_files.size());
+    }
+
+    bool hasCqes() const noexcept {
+        return !_cq.empty();
+    }
+
+    /**
+     * @brief 创建提供缓冲区环 (对应 io_uring_setup_buf_ring, 内存由本对象持有)
+     * @param entries 缓冲区个数 (必须为 2 的幂, 且不大于 32768)
+     * @param group 缓冲区组 id
+     * @return ::io_uring_buf_ring* 参数不合法时为 nullptr
+     */
+    ::io_uring_buf_ring* setupBufRing(unsigned int entries, unsigned short group) {
+        if (!entries || entries > 32768U || (entries & (entries - 1))) [[unlikely]] {
+            return nullptr;
+        }
+        auto& br = _bufRings.emplace_back(ProvidedRing{
+            std::make_unique<::io_uring_buf[]>(entries), entries, group, 0});
+        ::io_uring_buf_ring_init(br.ring());
+        return br.ring();
+    }
+
+    /**
+     * @brief 按顺序执行 SQ 中的所有 SQE (链接的 SQE 作为一条链, 前一步完成后才开始下一步)
+     */
+    void submit() {
+        auto const n = std::exchange(_sqCount, 0U);
+        Op* head = nullptr;
+        Op* tail = nullptr;
+        for (std::size_t i = 0; i < n; ++i) {
+            auto* op = makeOp(_sq[i]);
+            bool const isLinked = op->sqe->flags & IOSQE_IO_LINK;
+            if (op->sqe->opcode == IORING_OP_LINK_TIMEOUT) {
+                auto const* ts = reinterpret_cast<::__kernel_timespec const*>(op->sqe->addr);
+                if (!tail || tail->timeout || !ts) [[unlikely]] {
+                    post(op->sqe->user_data, -EINVAL);
+                    releaseOp(op);
+                } else {
+                    // 与内核一致: 在提交时读取超时时间
+                    op->dur = std::chrono::duration_cast<Clock::duration>(
+                        std::chrono::seconds{ts->tv_sec} + std::chrono::nanoseconds{ts->tv_nsec});
+                    op->target = tail;
+                    tail->timeout = op;
+                }
+            } else if (!head) {
+                head = tail = op;
+            } else {
+                tail->next = op;
+                tail = op;
+            }
+            if (!isLinked && head) {
+                start(head);
+                head = tail = nullptr;
+            }
+        }
+        if (head) [[unlikely]] {
+            start(head); // 最后一个 SQE 仍带有 IOSQE_IO_LINK
+        }
+    }
+
+    /**
+     * @brief 等待 fd 就绪或定时器到期, 并执行就绪的操作
+     * @param timeout 最长等待时间 (nullopt 则无限等待); 已有完成事件时不阻塞
+     */
+    void wait(std::optional<std::chrono::system_clock::duration> timeout) {
+        int ms = -1;
+        if (!_cq.empty()) {
+            ms = 0;
+        } else {
+            std::optional<Clock::duration> dur;
+            if (timeout) {
+                dur = std::chrono::duration_cast<Clock::duration>(*timeout);
+            }
+            if (!_timers.empty()) {
+                auto const d = _timers.begin()->first - Clock::now();
+                dur = dur ? std::min(*dur, d) : d;
+            }
+            if (dur) {
+                // 向上取整, 以免在到期之前醒来而空转
+                auto const cnt = std::chrono::ceil<std::chrono::milliseconds>(*dur).count();
+                ms = static_cast<int>(std::clamp<decltype(cnt)>(
+                    cnt, 0, std::numeric_limits<int>::max()));
+            }
+        }
+        int n = ::epoll_wait(_epfd, _events.data(), static_cast<int>(_events.size()), ms);
+        if (n < 0) [[unlikely]] {
+            if (errno != EINTR) {
+                throw std::system_error(errno, std::system_category(), "epoll_wait");
+            }
+            n = 0;
+        }
+        for (int i = 0; i < n; ++i) {
+            onEvent(_events[static_cast<std::size_t>(i)].data.fd,
+                    _events[static_cast<std::size_t>(i)].events);
+        }
+        auto const now = Clock::now();
+        while (!_timers.empty() && _timers.begin()->first <= now) {
+            auto* lt = _timers.begin()->second;
+            _timers.erase(_timers.begin());
+            lt->hasTimer = false;
+            auto* op = lt->target;
+            op->timeout = nullptr;
+            post(lt->sqe->user_data, -ETIME);
+            releaseOp(lt);
+            finish(op, -ECANCELED);
+        }
+    }
+
+    /**
+     * @brief 依次处理并清空完成事件
+     * @note func 中可以继续获取 / 提交 SQE, 新的完成事件留到下一次
+     * @param func `void(EpollCqe const&)`
+     */
+    template <typename Func>
+    void forEachCqe(Func&& func) {
+        _cqSpare.swap(_cq);
+        for (auto const& cqe : _cqSpare) {
+            func(cqe);
+        }
+        _cqSpare.clear();
+    }
+
+private:
+    Op* makeOp(::io_uring_sqe const& sqe) {
+        Op* op;
+        if (_freeOps.empty()) {
+            op = _ops.emplace_back(std::make_unique<Op>()).get();
+            op->sqe = std::make_unique<::io_uring_sqe>();
+        } else {
+            op = _freeOps.back();
+            _freeOps.pop_back();
+        }
+        *op->sqe = sqe;
+        op->fd = sqe.fd;
+        op->next = nullptr;
+        op->timeout = nullptr;
+        op->target = nullptr;
+        op->dur = {};
+        op->hasTimer = false;
+        op->inProgress = false;
+        op->waitOn = WaitOn::None;
+        op->cqeFlags = 0;
+        return op;
+    }
+
+    void releaseOp(Op* op) {
+        _freeOps.push_back(op);
+    }
+
+    void post(std::uint64_t userData, int res, unsigned int flags = 0) {
+        _cq.push_back({userData, res, flags});
+    }
+
+    /**
+     * @brief 开始执行链的第一个操作
+     */
+    void start(Op* op) {
+        if (op->sqe->flags & IOSQE_FIXED_FILE) {
+            auto const idx = static_cast<std::size_t>(op->sqe->fd);
+            if (op->sqe->fd < 0 || idx >= _files.size() || _files[idx] < 0) [[unlikely]] {
+                finish(op, -EBADF);
+                return;
+            }
+            op->fd = _files[idx];
+        }
+        int res = perform(op);
+        if (res == kWouldBlock) {
+            res = waitFor(op);
+            if (res == 0) [[likely]] {
+                return;
+            }
+        }
+        finish(op, res);
+    }
+
+    /**
+     * @brief 操作完成: 投递 CQE, 并开始 (或取消) 链中的下一个操作
+     */
+    void finish(Op* op, int res) {
+        unwait(op);
+        if (auto* lt = std::exchange(op->timeout, nullptr)) {
+            post(lt->sqe->user_data, -ECANCELED);
+            releaseOp(lt);
+        }
+        post(op->sqe->user_data, res, op->cqeFlags);
+        // 与内核一致: 读写的字节数不足也视为失败
+        bool const failed = res < 0
+            || ((op->sqe->opcode == IORING_OP_READ || op->sqe->opcode == IORING_OP_WRITE)
+                && static_cast<unsigned int>(res) < op->sqe->len);
+        auto* next = op->next;
+        releaseOp(op);
+        if (!next) {
+            return;
+        }
+        if (!failed) {
+            start(next);
+            return;
+        }
+        for (auto* it = next; it; ) {
+            if (auto* lt = it->timeout) {
+                post(lt->sqe->user_data, -ECANCELED);
+                releaseOp(lt);
+            }
+            post(it->sqe->user_data, -ECANCELED);
+            releaseOp(std::exchange(it, it->next));
+        }
+    }
+
+    /**
+     * @brief 在 fd 上等待 (首次等待时以边沿触发注册到 epoll)
+     * @return int 0 或 -errno
+     */
+    int waitFor(Op* op) {
+        auto& st = _fds[op->fd];
+        if (!st.registered) {
+            ::epoll_event ev{};
+            ev.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+            ev.data.fd = op->fd;
+            if (::epoll_ctl(_epfd, EPOLL_CTL_ADD, op->fd, &ev) < 0 && errno != EEXIST) [[unlikely]] {
+                return -errno;
+            }
+            st.registered = true;
+        }
+        switch (op->sqe->opcode) {
+            case IORING_OP_POLL_ADD:
+                op->waitOn = WaitOn::Poll;
+                st.pollers.push_back(op);
+                break;
+            case IORING_OP_WRITE:
+            case IORING_OP_SEND:
+            case IORING_OP_SENDMSG:
+            case IORING_OP_CONNECT:
+                op->waitOn = WaitOn::Write;
+                st.writers.push_back(op);
+                break;
+            default:
+                op->waitOn = WaitOn::Read;
+                st.readers.push_back(op);
+                break;
+        }
+        if (op->sqe->user_data) {
+            _pending.insert_or_assign(op->sqe->user_data, op);
+        }
+        if (auto* lt = op->timeout) {
+            lt->timer = _timers.emplace(Clock::now() + lt->dur, lt);
+            lt->hasTimer = true;
+        }
+        return 0;
+    }
+
+    /**
+     * @brief 从等待队列 / 定时器中移除
+     */
+    void unwait(Op* op) {
+        if (op->waitOn == WaitOn::None) {
+            return;
+        }
+        if (auto it = _fds.find(op->fd); it != _fds.end()) {
+            auto& st = it->second;
+            auto erase = [op](auto& q) {
+                if (auto pos = std::find(q.begin(), q.end(), op); pos != q.end()) {
+                    q.erase(pos);
+                }
+            };
+            switch (op->waitOn) {
+                case WaitOn::Read:  erase(st.readers); break;
+                case WaitOn::Write: erase(st.writers); break;
+                default:            erase(st.pollers); break;
+            }
+        }
+        op->waitOn = WaitOn::None;
+        if (op->sqe->user_data) {
+            if (auto it = _pending.find(op->sqe->user_data); it != _pending.end() && it->second == op) {
+                _pending.erase(it);
+            }
+        }
+        if (op->timeout && op->timeout->hasTimer) {
+            _timers.erase(op->timeout->timer);
+            op->timeout->hasTimer = false;
+        }
+    }
+
+    /**
+     * @brief fd 就绪: 按 FIFO 重试等待的操作, 直到再次返回 EAGAIN
+     */
+    void onEvent(int fd, std::uint32_t events) {
+        if (events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+            retry(fd, WaitOn::Read);
+        }
+        if (events & (EPOLLOUT | EPOLLHUP | EPOLLERR)) {
+            retry(fd, WaitOn::Write);
+        }
+        auto it = _fds.find(fd);
+        if (it == _fds.end() || it->second.pollers.empty()) {
+            return;
+        }
+        auto pollers = it->second.pollers;
+        for (auto* op : pollers) {
+            // 之前的操作完成时, 可能已经关闭了该 fd
+            it = _fds.find(fd);
+            if (it == _fds.end()) {
+                return;
+            }
+            auto const& cur = it->second.pollers;
+            if (std::find(cur.begin(), cur.end(), op) == cur.end()) {
+                continue;
+            }
+            auto const revents = events & (op->sqe->poll32_events | POLLERR | POLLHUP);
+            if (revents) {
+                finish(op, static_cast<int>(revents));
+            }
+        }
+    }
+
+    void retry(int fd, WaitOn waitOn) {
+        for (;;) {
+            // 完成的操作可能开始链中的下一个, 从而修改 _fds, 故每次重新查找
+            auto it = _fds.find(fd);
+            if (it == _fds.end()) {
+                return;
+            }
+            auto& q = waitOn == WaitOn::Read ? it->second.readers : it->second.writers;
+            if (q.empty()) {
+                return;
+            }
+            auto* op = q.front();
+            int res = perform(op);
+            if (res == kWouldBlock) {
+                return;
+            }
+            finish(op, res);
+        }
+    }
+
+    template <typename Func>
+    static int sysCall(Func&& func) {
+        for (;;) {
+            auto res = func();
+            if (res >= 0) [[likely]] {
+                return static_cast<int>(res);
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return kWouldBlock;
+            }
+            if (errno != EINTR) {
+                return -errno;
+            }
+        }
+    }
+
+    /**
+     * @brief 执行一次操作
+     * @return int 结果 (同 cqe->res); 或 kWouldBlock
+     */
+    int perform(Op* op) {
+        auto const& s = *op->sqe;
+        switch (s.opcode) {
+            case IORING_OP_NOP:
+                return 0;
+            case IORING_OP_READ:
+            case IORING_OP_WRITE:
+                return readWrite(op);
+            case IORING_OP_RECV:
+                if (s.flags & IOSQE_BUFFER_SELECT) {
+                    return recvProvided(op);
+                }
+                if (s.ioprio & IORING_RECV_MULTISHOT) {
+                    return -EINVAL;
+                }
+                return sysCall([&] {
+                    return ::recv(op->fd, reinterpret_cast<void*>(s.addr), s.len,
+                                  static_cast<int>(s.msg_flags) | MSG_DONTWAIT);
+                });
+            case IORING_OP_SEND:
+                return sysCall([&] {
+                    return ::send(op->fd, reinterpret_cast<void const*>(s.addr), s.len,
+                                  static_cast<int>(s.msg_flags) | MSG_DONTWAIT);
+                });
+            case IORING_OP_SENDMSG:
+                return sysCall([&] {
+                    return ::sendmsg(op->fd, reinterpret_cast<::msghdr const*>(s.addr),
+                                     static_cast<int>(s.msg_flags) | MSG_DONTWAIT);
+                });
+            case IORING_OP_SEND_ZC:
+                return -EOPNOTSUPP;
+            case IORING_OP_ACCEPT:
+                return accept(op);
+            case IORING_OP_CONNECT:
+                return connect(op);
+            case IORING_OP_SOCKET: {
+                int fd = ::socket(s.fd, static_cast<int>(s.off), static_cast<int>(s.len));
+                return fd < 0 ? -errno : onNewFd(fd, s.file_index);
+            }
+            case IORING_OP_OPENAT: {
+                int fd = ::openat(s.fd, reinterpret_cast<char const*>(s.addr),
+                                  static_cast<int>(s.open_flags), static_cast<::mode_t>(s.len));
+                return fd < 0 ? -errno : onNewFd(fd, s.file_index);
+            }
+            case IORING_OP_STATX:
+                return ::statx(s.fd, reinterpret_cast<char const*>(s.addr),
+                               static_cast<int>(s.statx_flags), s.len,
+                               reinterpret_cast<struct ::statx*>(s.off)) < 0 ? -errno : 0;
+            case IORING_OP_CLOSE:
+                if (s.file_index) {
+                    auto const idx = static_cast<std::size_t>(s.file_index - 1);
+                    if (idx >= _files.size() || _files[idx] < 0) {
+                        return -EBADF;
+                    }
+                    closeFd(std::exchange(_files[idx], -1));
+                    return 0;
+                }
+                return closeFd(s.fd);
+            case IORING_OP_POLL_ADD: {
+                ::pollfd pfd{op->fd, static_cast<short>(s.poll32_events), 0};
+                int res = ::poll(&pfd, 1, 0);
+                if (res < 0) {
+                    return -errno;
+                }
+                return res ? static_cast<int>(static_cast<unsigned short>(pfd.revents)) : kWouldBlock;
+            }
+            case IORING_OP_ASYNC_CANCEL: {
+                auto it = _pending.find(s.addr);
+                if (it == _pending.end()) {
+                    return -ENOENT;
+                }
+                finish(it->second, -ECANCELED);
+                return 0;
+            }
+            default:
+                return -EINVAL;
+        }
+    }
+
+    int readWrite(Op* op) {
+        auto const& s = *op->sqe;
+        auto& st = _fds[op->fd];
+        if (st.kind == FdKind::Unknown) {
+            struct ::stat sb;
+            if (::fstat(op->fd, &sb) < 0) {
+                return -errno;
+            }
+            if (S_ISREG(sb.st_mode) || S_ISBLK(sb.st_mode)) {
+                st.kind = FdKind::File;
+            } else if (S_ISSOCK(sb.st_mode)) {
+                st.kind = FdKind::Socket;
+            } else {
+                if (!setNonblock(op->fd, st)) {
+                    return -errno;
+                }
+                st.kind = FdKind::Stream;
+            }
+        }
+        auto* buf = reinterpret_cast<char*>(s.addr);
+        bool const isRead = s.opcode == IORING_OP_READ;
+        switch (st.kind) {
+            case FdKind::File: {
+                // off 为 -1 时使用文件的当前位置
+                bool const usePos = s.off == static_cast<std::uint64_t>(-1);
+                auto const off = static_cast<::off_t>(s.off);
+                return sysCall([&] {
+                    return isRead
+                        ? (usePos ? ::read(op->fd, buf, s.len) : ::pread(op->fd, buf, s.len, off))
+                        : (usePos ? ::write(op->fd, buf, s.len) : ::pwrite(op->fd, buf, s.len, off));
+                });
+            }
+            case FdKind::Socket:
+                return sysCall([&] {
+                    return isRead
+                        ? ::recv(op->fd, buf, s.len, MSG_DONTWAIT)
+                        : ::send(op->fd, buf, s.len, MSG_DONTWAIT | MSG_NOSIGNAL);
+                });
+            default:
+                return sysCall([&] {
+                    return isRead ? ::read(op->fd, buf, s.len) : ::write(op->fd, buf, s.len);
+                });
+        }
+    }
+
+    /**
+     * @brief 读取到提供缓冲区环中的缓冲区 (数据到达后才挑选缓冲区; 未读到数据则不消耗)
+     */
+    int recvProvided(Op* op) {
+        auto const& s = *op->sqe;
+        auto it = std::find_if(_bufRings.begin(), _bufRings.end(), [&](ProvidedRing const& br) {
+            return br.group == s.buf_group;
+        });
+        if (it == _bufRings.end()) [[unlikely]] {
+            return -ENOBUFS;
+        }
+        bool const isMultishot = s.ioprio & IORING_RECV_MULTISHOT;
+        for (;;) {
+            auto* ring = it->ring();
+            if (it->head == ring->tail) {
+                return -ENOBUFS; // 缓冲区环已被借空 (多发请求随之终止, 同内核)
+            }
+            auto const& buf = ring->bufs[it->head & (it->entries - 1)];
+            int res = sysCall([&] {
+                return ::recv(op->fd, reinterpret_cast<void*>(buf.addr), buf.len,
+                              static_cast<int>(s.msg_flags) | MSG_DONTWAIT);
+            });
+            if (res <= 0) {
+                return res; // kWouldBlock / 连接断开 / 出错
+            }
+            ++it->head;
+            auto const flags = IORING_CQE_F_BUFFER
+                | (static_cast<unsigned int>(buf.bid) << IORING_CQE_BUFFER_SHIFT);
+            if (!isMultishot) {
+                op->cqeFlags = flags;
+                return res;
+            }
+            post(s.user_data, res, flags | IORING_CQE_F_MORE);
+        }
+    }
+
+    int accept(Op* op) {
+        auto const& s = *op->sqe;
+        if (!setNonblock(op->fd, _fds[op->fd])) [[unlikely]] {
+            return -errno;
+        }
+        bool const isMultishot = s.ioprio & IORING_ACCEPT_MULTISHOT;
+        for (;;) {
+            int res = sysCall([&] {
+                return ::accept4(op->fd, reinterpret_cast<::sockaddr*>(s.addr),
+                                 reinterpret_cast<::socklen_t*>(s.addr2),
+                                 static_cast<int>(s.accept_flags));
+            });
+            if (res >= 0) {
+                res = onNewFd(res, s.file_index);
+            }
+            if (!isMultishot || res < 0) {
+                return res; // 多发 accept 出错时终止, 同内核
+            }
+            post(s.user_data, res, IORING_CQE_F_MORE);
+        }
+    }
+
+    int connect(Op* op) {
+        auto const& s = *op->sqe;
+        if (op->inProgress) {
+            int err = 0;
+            ::socklen_t len = sizeof(err);
+            if (::getsockopt(op->fd, SOL_SOCKET, SO_ERROR, &err, &len) < 0) {
+                return -errno;
+            }
+            return -err;
+        }
+        if (!setNonblock(op->fd, _fds[op->fd])) [[unlikely]] {
+            return -errno;
+        }
+        if (::connect(op->fd, reinterpret_cast<::sockaddr const*>(s.addr),
+                      static_cast<::socklen_t>(s.off)) == 0) {
+            return 0;
+        }
+        if (errno == EINPROGRESS || errno == EAGAIN) {
+            op->inProgress = true;
+            return kWouldBlock;
+        }
+        return -errno;
+    }
+
+    static bool setNonblock(int fd, FdState& st) noexcept {
+        if (st.nonblock) [[likely]] {
+            return true;
+        }
+        int flags = ::fcntl(fd, F_GETFL);
+        if (flags < 0 || (!(flags & O_NONBLOCK) && ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0)) {
+            return false;
+        }
+        st.nonblock = true;
+        return true;
+    }
+
+    /**
+     * @brief 新创建的 fd: 清除复用同一 fd 号的旧状态; 若指定了文件表槽位, 则安装到文件表中
+     * @param fd
+     * @param fileIndex sqe->file_index (0 则不安装; IORING_FILE_INDEX_ALLOC 则自动分配)
+     * @return int fd; 自动分配的槽位; 0 (指定的槽位); 或 -errno
+     */
+    int onNewFd(int fd, std::uint32_t fileIndex) {
+        _fds.erase(fd);
+        if (!fileIndex) {
+            return fd;
+        }
+        if (fileIndex == IORING_FILE_INDEX_ALLOC) {
+            auto it = std::find(_files.begin(), _files.end(), -1);
+            if (it == _files.end()) {
+                ::close(fd);
+                return -ENFILE;
+            }
+            *it = fd;
+            return static_cast<int>(it - _files.begin());
+        }
+        auto const idx = static_cast<std::size_t>(fileIndex - 1);
+        if (idx >= _files.size()) {
+            ::close(fd);
+            return -EINVAL;
+        }
+        if (_files[idx] >= 0) {
+            closeFd(_files[idx]); // 同内核: 替换槽位中原有的文件
+        }
+        _files[idx] = fd;
+        return 0;
+    }
+
+    /**
+     * @brief 关闭 fd; 其上仍在等待的操作以 -EBADF 完成 (否则它们将永远等不到事件)
+     */
+    int closeFd(int fd) {
+        if (auto it = _fds.find(fd); it != _fds.end()) {
+            auto st = std::move(it->second);
+            _fds.erase(it);
+            for (auto* q : {&st.readers, &st.writers}) {
+                for (auto* op : *q) {
+                    finish(op, -EBADF);
+                }
+            }
+            for (auto* op : st.pollers) {
+                finish(op, -EBADF);
+            }
+        }
+        return ::close(fd) < 0 ? -errno : 0;
+    }
+
+    int _epfd;
+    std::vector<::io_uring_sqe> _sq;        // 模拟的 SQ (SQE 的地址在提交之前保持不变)
+    std::size_t _sqCount;                   // SQ 中已获取的 SQE 数
+    std::vector<EpollCqe> _cq;              // 模拟的 CQ
+    std::vector<EpollCqe> _cqSpare;         // forEachCqe 期间使用的 CQ
+    std::vector<int> _files;                // 模拟的注册文件表 (-1 为空位)
+    std::vector<ProvidedRing> _bufRings;    // 模拟的提供缓冲区环
+    std::unordered_map<int, FdState> _fds;  // fd 的状态
+    std::unordered_map<std::uint64_t, Op*> _pending;      // 等待中的操作 (按 user_data, 用于取消)
+    std::multimap<Clock::time_point, Op*> _timers;        // LINK_TIMEOUT 的定时器
+    std::vector<std::unique_ptr<Op>> _ops;  // 所有操作对象
+    std::vector<Op*> _freeOps;              // 空闲的操作对象
+    std::array<::epoll_event, 128> _events; // 一次 epoll_wait 至多取回的就绪事件
+};
+
+} // namespace HX::coroutine::internal
+
+#endif // defined(__linux__)
@@ -20,9 +20,17 @@
 
 #include <thread>
 #include <chrono>
+#include <memory>
+#include <vector>
+#include <cstdlib>
+#include <algorithm>
 #include <coroutine>
+#include <string_view>
 
-#if defined (_WIN32)
+#if defined(__linux__)
+#include <sys/eventfd.h>
+#include <unistd.h>
+#elif defined (_WIN32)
 #include <array>
 #endif
 
@@ -31,8 +39,12 @@
 #include <HXLibs/container/Try.hpp>
 #include <HXLibs/coroutine/task/Task.hpp>
 #include <HXLibs/coroutine/task/AioTask.hpp>
+#include <HXLibs/coroutine/task/AioChain.hpp>
 #include <HXLibs/coroutine/loop/TimerLoop.hpp>
 #include <HXLibs/coroutine/loop/ThreadLoop.hpp>
+#include <HXLibs/coroutine/loop/BufRing.hpp>
+#include <HXLibs/coroutine/loop/EpollRing.hpp>
+#include <HXLibs/coroutine/loop/EventLoopOptions.hpp>
 #include <HXLibs/coroutine/concepts/Awaiter.hpp>
 #include <HXLibs/coroutine/awaiter/WhenAny.hpp>
 #include <HXLibs/exception/ErrorHandlingTools.hpp>
@@ -96,26 +108,79 @@ inline unsigned int getIoUringMaxSize() {
     [[unlikely]] throw std::runtime_error{"IoUringMaxSize not find"}; // 找不到可用的大小
 }
 
+/**
+ * @brief 唤醒 eventfd 读取的 user_data (不是任何对象的地址)
+ */
+inline constexpr std::uint64_t kWakeupUserData = 8;
+
 struct IoUring {
-    explicit IoUring(unsigned int size = 1024U)
+    explicit IoUring(EventLoopOptions const& options = {})
         : _ring{}
         , _numSqesPending{}
+        , _profile{options.profile}
+        , _fixedFiles{}
+        , _fixedFilesInUse{}
+        , _bufRing{}
+        , _wakeupFd{exception::LinuxErrorHandlingTools::checkError(
+            "eventfd", ::eventfd(0, EFD_CLOEXEC))}
+        , _wakeupBuf{}
+        , _wakeupArmed{false}
+        , _resumeBudget{options.resumeBudget}
+        , _resuming{ResumePriority::Latency}
+        , _ready{}
+        , _tracker{_cancelQueue, _ready}
+        , _epoll{}
     {
-        unsigned int flags = 0;
-        exception::IoUringErrorHandlingTools::check(
-            ::io_uring_queue_init(size, &_ring, flags)
-        );
+        auto const backend = resolveBackend(options.backend);
+        if (backend == EventBackend::Epoll
+            || !initRing(options, backend == EventBackend::IoUring)
+        ) {
+            // 注册文件表在用户态模拟; 不使用提供缓冲区环 (读请求回退为使用连接自身的缓冲区)
+            _epoll = std::make_unique<EpollRing>(options.entries, options.fixedFiles);
+            _profile = IoUringProfile::Default;
+            _fixedFiles = options.fixedFiles;
+            if (options.bufRingEntries) {
+                _bufRing.init(*_epoll, options.bufRingEntries, options.bufRingBufSize, 0);
+            }
+            return;
+        }
+        if (options.fixedFiles) {
+            // 稀疏注册, 槽位由内核分配 (IORING_FILE_INDEX_ALLOC); 失败则不使用文件表
+            _fixedFiles = ::io_uring_register_files_sparse(&_ring, options.fixedFiles) == 0
+                ? options.fixedFiles
+                : 0U;
+        }
+        if (options.bufRingEntries) {
+            // 失败则不使用缓冲区环, 读请求回退为使用连接自身的缓冲区
+            _bufRing.init(&_ring, options.bufRingEntries, options.bufRingBufSize, 0);
+        }
     }
 
     ~IoUring() noexcept {
-        ::io_uring_queue_exit(&_ring);
+        if (_epoll) {
+            _epoll.reset();
+        } else {
+            _bufRing.destroy(&_ring);
+            ::io_uring_queue_exit(&_ring);
+        }
+        ::close(_wakeupFd);
     }
 
     AioTask makeAioTask() {
         // mandatory copy elision 场景
         // 编译器强制使用 RVO (返回值优化)
         // https://en.cppreference.com/w/cpp/language/copy_elision.html
-        return AioTask{getSqe()};
+        return AioTask{getSqe(), _tracker, _resuming};
+    }
+
+    MultishotAioTask makeMultishotAioTask() {
+        return MultishotAioTask{getSqe(), _cancelQueue, _closeQueue};
+    }
+
+    template <std::size_t N>
+    AioChain<N> makeAioChain() {
+        reserveSqes(static_cast<unsigned int>(N));
+        return {};
     }
 
     /**
@@ -125,17 +190,149 @@ struct IoUring {
         auto* sqe = getSqe();
         sqe->user_data = 0U;
         ::io_uring_prep_nop(sqe);
-        if (::io_uring_submit(&_ring) < 0) [[unlikely]] {
+        if (_epoll) {
+            _epoll->submit();
+        } else if (::io_uring_submit(&_ring) < 0) [[unlikely]] {
             // 环形队列已满
             throw std::runtime_error{"io_uring_submit: queue is full"};
         }
     }
 
     bool isRun() const noexcept {
+        return _numSqesPending || hasReady();
+    }
+
+    /**
+     * @brief 把协程加入恢复队列, 在之后的一轮中恢复 (见 EventLoop::yield)
+     * @param coroutine 
+     * @param priority 
+     */
+    void schedule(std::coroutine_handle<> coroutine, ResumePriority priority) {
+        _ready[static_cast<std::size_t>(priority)].items.push_back({coroutine, nullptr});
+    }
+
+    /**
+     * @brief 唤醒阻塞在 `run` 中的事件循环 (可在任意线程调用)
+     * @note 只写 eventfd, 不提交 SQE, 因此与 SINGLE_ISSUER / DEFER_TASKRUN 兼容
+     *       (IORING_OP_MSG_RING 需要发送方也持有 io_uring, 线程池线程并没有)
+     */
+    void wakeup() noexcept {
+        ::eventfd_write(_wakeupFd, 1);
+    }
+
+    /**
+     * @brief 获取实际使用的后端 (`EventBackend::IoUring` 或 `EventBackend::Epoll`)
+     * @return EventBackend
+     */
+    EventBackend backend() const noexcept {
+        return _epoll ? EventBackend::Epoll : EventBackend::IoUring;
+    }
+
+    /**
+     * @brief 获取实际生效的配置档 (内核不支持时会回退到 Default)
+     * @return IoUringProfile
+     */
+    IoUringProfile profile() const noexcept {
+        return _profile;
+    }
+
+    /**
+     * @brief 获取已注册的文件表槽位数 (0 表示未注册)
+     * @return unsigned int
+     */
+    unsigned int fixedFiles() const noexcept {
+        return _fixedFiles;
+    }
+
+    /**
+     * @brief 注册文件表是否还有空位
+     * @param reserve 额外预留的槽位数 (如多发 accept 在取消生效前仍可能继续占用槽位)
+     * @return true 有空位
+     */
+    bool hasFreeFixedFile(unsigned int reserve = 0U) const noexcept {
+        return _fixedFilesInUse + _closeQueue.size() + reserve < _fixedFiles;
+    }
+
+    /**
+     * @brief 记录一个槽位被占用 (如 accept 到注册文件表中)
+     */
+    void installFixedFile() noexcept {
+        ++_fixedFilesInUse;
+    }
+
+    /**
+     * @brief 记录一个槽位被释放 (如 close_direct)
+     */
+    void releaseFixedFile() noexcept {
+        --_fixedFilesInUse;
+    }
+
+    /**
+     * @brief 取消一个仍在内核中的任务 (需要 `setCancelable()`), 取消请求在下一轮提交;
+     *        若任务在此之前已经完成, 则取消无效果
+     * @param task 
+     */
+    void cancel(AioTask const& task) {
+        _cancelQueue.push_back(task._userData);
+    }
+
+    /**
+     * @brief 已析构但 CQE 尚未到达的任务数 (其取消请求已提交或将在下一轮提交)
+     * @return std::size_t
+     */
+    std::size_t abandonedTasks() const noexcept {
+        return _tracker.orphans();
+    }
+
+    /**
+     * @brief 已提交 (或即将提交) 但尚未完成的 SQE 数, 即环的占用
+     * @return std::size_t
+     */
+    std::size_t pendingSqes() const noexcept {
         return _numSqesPending;
     }
 
+    /**
+     * @brief 获取提供缓冲区环 (未注册时 `isEnabled() == false`)
+     * @return BufRing&
+     */
+    BufRing& bufRing() noexcept {
+        return _bufRing;
+    }
+
     void run(std::optional<std::chrono::system_clock::duration> timeout) {
+        armWakeup();
+
+        // 提交取消请求 (已析构的多发任务与普通任务, 超过截止时间的任务)
+        for (auto userData : _cancelQueue) {
+            auto* sqe = getSqe();
+            ::io_uring_prep_cancel64(sqe, userData, 0);
+            sqe->user_data = 0U;
+        }
+        _cancelQueue.clear();
+
+        // 关闭无人接管的注册文件表槽位 (如已析构的多发 accept 在取消生效前接受的连接)
+        for (auto fileIndex : _closeQueue) {
+            auto* sqe = getSqe();
+            ::io_uring_prep_close_direct(sqe, fileIndex);
+            sqe->user_data = 0U;
+        }
+        _closeQueue.clear();
+
+        _numSqesPending -= _epoll ? reapEpoll(timeout) : reapRing(timeout);
+
+        // 先恢复 Latency, 再以剩余的预算恢复 Bulk (至少一个)
+        std::size_t budget = _resumeBudget ? _resumeBudget : static_cast<std::size_t>(-1);
+        budget -= resumeReady(ResumePriority::Latency, budget);
+        resumeReady(ResumePriority::Bulk, budget ? budget : 1);
+    }
+
+private:
+    /**
+     * @brief 提交 SQE, 等待并处理 io_uring 的完成事件
+     * @return std::size_t 完成的任务数
+     */
+    std::size_t reapRing(std::optional<std::chrono::system_clock::duration> timeout) {
         ::io_uring_cqe* cqe = nullptr;
 
         ::__kernel_timespec timespec; // 设置超时为无限阻塞
@@ -145,47 +342,273 @@ struct IoUring {
             timespecPtr = &timespec;
         }
 
-        // 阻塞等待内核, 返回是错误码; cqe是完成队列, 为传出参数
-        int res = ::io_uring_submit_and_wait_timeout(
-            &_ring, &cqe, 1, timespecPtr, nullptr);
-        
-        // 超时
-        if (res == -ETIME) {
-            // 内部直接 if (nr) { ... }, 此处调用传参 0, 毫无作用
-            // ::io_uring_cq_advance(&_ring, 0); // 确保完成队列状态同步
-            return;
-        } else if (res < 0) [[unlikely]] { // 其他错误
-            if (res == -EINTR) { // 被信号中断
-                return;
-            }
+        int res;
+        if (hasReady()) {
+            // 上一轮超出预算的协程还未恢复: 只提交并收取已有的完成事件, 不阻塞
+            res = ::io_uring_submit_and_get_events(&_ring);
+        } else {
+            // 阻塞等待内核, 返回是错误码; cqe是完成队列, 为传出参数
+            res = ::io_uring_submit_and_wait_timeout(
+                &_ring, &cqe, 1, timespecPtr, nullptr);
+        }
+
+        // 超时 (-ETIME) 或被信号中断 (-EINTR) 时, 完成队列为空, 仍然恢复上一轮留下的协程
+        if (res < 0 && res != -ETIME && res != -EINTR) [[unlikely]] {
             throw std::system_error(-res, std::system_category());
         }
 
         unsigned head, numGot = 0;
+        std::size_t numDone = 0;
         io_uring_for_each_cqe(&_ring, head, cqe) {
             ++numGot;
-            if (cqe->res == -ECANCELED) { // 操作已取消 (比如超时了)
-                continue;
-            }
-            auto* task = reinterpret_cast<AioTask*>(cqe->user_data);
-            if (!task) [[unlikely]] {
-                continue; // 仅 prepNop
-            }
-            task->_res = cqe->res;
-            tasks.push_back(task->_previous);
+            numDone += onCqe(cqe->user_data, cqe->res, cqe->flags);
         }
 
         // 手动前进完成队列的头部 (相当于批量io_uring_cqe_seen)
         ::io_uring_cq_advance(&_ring, numGot);
-        _numSqesPending -= static_cast<std::size_t>(numGot);
-        for (const auto& it : tasks) {
-            it.resume();
+        return numDone;
+    }
+
+    /**
+     * @brief epoll 后端: 乐观地执行 SQE, 等待 fd 就绪, 并处理完成事件
+     * @return std::size_t 完成的任务数
+     */
+    std::size_t reapEpoll(std::optional<std::chrono::system_clock::duration> timeout) {
+        _epoll->submit();
+        if (hasReady()) {
+            timeout = std::chrono::system_clock::duration::zero();
         }
-        tasks.clear();
+        _epoll->wait(timeout);
+        std::size_t numDone = 0;
+        _epoll->forEachCqe([&](EpollCqe const& cqe) {
+            numDone += onCqe(cqe.userData, cqe.res, cqe.flags);
+        });
+        return numDone;
+    }
+
+    /**
+     * @brief 处理一个完成事件 (两种后端共用)
+     * @return std::size_t 是否完成了一个任务 (多发任务只有最后一个 CQE 才算完成)
+     */
+    std::size_t onCqe(std::uint64_t userData, int res, unsigned int flags) {
+        if (userData == internal::kWakeupUserData) {
+            _wakeupArmed = false; // 仅用于唤醒, 投递的任务由 EventLoop 执行
+            return 0;
+        }
+        std::size_t const numDone = !(flags & IORING_CQE_F_MORE);
+        if (userData & internal::kMultishotTag) {
+            auto* state = reinterpret_cast<internal::MultishotState*>(
+                userData & ~internal::kMultishotTag);
+            if (auto h = state->complete(res, flags)) {
+                schedule(h, ResumePriority::Latency);
+            }
+            return numDone;
+        }
+        if (userData & internal::kChainTag) {
+            // 链中被取消的操作 (-ECANCELED) 也需要计数, 因此在其之前处理
+            auto* slot = reinterpret_cast<internal::AioChainSlot*>(
+                userData & ~internal::kChainTag);
+            if (auto h = slot->complete(res, flags)) {
+                schedule(h, ResumePriority::Latency);
+            }
+            return numDone;
+        }
+        if (_tracker.reap(userData, flags & IORING_CQE_F_MORE)) {
+            return numDone; // 任务已析构 (如 whenAny 中落败的一方)
+        }
+        auto* task = reinterpret_cast<AioTask*>(userData & internal::kAioTaskPtrMask);
+        if (!task) [[unlikely]] {
+            return numDone; // 仅 prepNop 或取消请求
+        }
+        if (flags & IORING_CQE_F_NOTIF) {
+            // 零拷贝发送的通知: 内核已不再引用缓冲区, 此时才恢复 (结果已在第一个 CQE 中保存)
+            pushReady(task);
+            return numDone;
+        }
+        if (res == -ECANCELED && !(userData & internal::kCancelableTag)) {
+            task->_tracker = nullptr;
+            return numDone; // 操作已取消 (比如超时了)
+        }
+        task->_res = res;
+        task->_cqeFlags = flags;
+        if (flags & IORING_CQE_F_MORE) {
+            return numDone; // 零拷贝发送的结果: 还需要等待通知
+        }
+        pushReady(task);
+        return numDone;
+    }
+
+    bool hasReady() const noexcept {
+        return !_ready[0].empty() || !_ready[1].empty();
+    }
+
+    /**
+     * @brief 任务已完成, 加入其优先级的恢复队列 (从未被 co_await 的任务无需恢复)
+     */
+    void pushReady(AioTask* task) {
+        if (!task->_previous) [[unlikely]] {
+            task->_tracker = nullptr;
+            return;
+        }
+        auto& q = _ready[static_cast<std::size_t>(task->_priority)];
+        q.items.push_back({task->_previous, task});
+        task->_readySlot = internal::makeReadySlot(task->_priority, q.items.size() - 1);
+    }
+
+    /**
+     * @brief 按顺序恢复队列中至多 limit 个协程 (本轮恢复期间新加入的留到下一轮)
+     * @note 恢复的协程可能析构之后才恢复的任务 (它们的位置会被替换为空操作), 故按下标逐个读取;
+     *       恢复期间发起的 IO 沿用该队列的优先级
+     * @return std::size_t 恢复的个数
+     */
+    std::size_t resumeReady(ResumePriority priority, std::size_t limit) {
+        auto& q = _ready[static_cast<std::size_t>(priority)];
+        auto const begin = q.head;
+        auto const end = begin + std::min(limit, q.items.size() - begin);
+        _resuming = priority;
+        while (q.head < end) {
+            auto [coroutine, task] = q.items[q.head++];
+            if (task) {
+                task->_tracker = nullptr;
+                task->_readySlot = 0;
+            }
+            coroutine.resume();
+        }
+        _resuming = ResumePriority::Latency;
+        if (q.empty()) {
+            q.items.clear();
+            q.head = 0;
+        } else if (q.head >= q.items.size() - q.head) {
+            // 积压的部分整体前移, 并更新其中任务记录的位置
+            q.items.erase(q.items.begin(), q.items.begin() + static_cast<std::ptrdiff_t>(q.head));
+            q.head = 0;
+            for (std::size_t i = 0; i < q.items.size(); ++i) {
+                if (auto* task = q.items[i].task) {
+                    task->_readySlot = internal::makeReadySlot(priority, i);
+                }
+            }
+        }
+        return end - begin;
+    }
+
+    /**
+     * @brief 确定要使用的后端: Auto 时由环境变量 HXLIBS_EVENT_DRIVE (io_uring / epoll) 指定
+     * @return EventBackend 仍为 Auto 则先尝试 io_uring, 不可用时回退到 epoll
+     */
+    static EventBackend resolveBackend(EventBackend backend) noexcept {
+        if (backend != EventBackend::Auto) {
+            return backend;
+        }
+        if (char const* env = std::getenv("HXLIBS_EVENT_DRIVE")) {
+            std::string_view name{env};
+            if (name == toString(EventBackend::Epoll)) {
+                return EventBackend::Epoll;
+            }
+            if (name == toString(EventBackend::IoUring)) {
+                return EventBackend::IoUring;
+            }
+        }
+        return EventBackend::Auto;
+    }
+
+    /**
+     * @brief 初始化 io_uring (所选配置档不受支持时回退到默认配置)
+     * @param required 为 true 时, io_uring 不可用则抛出异常
+     * @return true 成功; false io_uring 不可用 (如内核过旧, 或被 seccomp 禁止)
+     */
+    bool initRing(EventLoopOptions const& options, bool required) {
+        ::io_uring_params params{};
+        params.flags = makeSetupFlags(options);
+        if (options.cqEntries) {
+            params.flags |= IORING_SETUP_CQSIZE;
+            params.cq_entries = options.cqEntries;
+        }
+        if (options.profile == IoUringProfile::SqPoll) {
+            params.sq_thread_idle = options.sqThreadIdleMs;
+            if (options.sqThreadCpu >= 0) {
+                params.sq_thread_cpu = static_cast<__u32>(options.sqThreadCpu);
+            }
+        }
+        if (::io_uring_queue_init_params(options.entries, &_ring, &params) < 0) [[unlikely]] {
+            // 内核不支持该配置 (或无权限), 回退到默认配置
+            _ring = {};
+            _profile = IoUringProfile::Default;
+            if (int res = ::io_uring_queue_init(options.entries, &_ring, 0); res < 0) {
+                _ring = {};
+                if (required) {
+                    exception::IoUringErrorHandlingTools::check(res);
+                }
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static unsigned int makeSetupFlags(EventLoopOptions const& options) noexcept {
+        switch (options.profile) {
+            case IoUringProfile::SqPoll:
+                return IORING_SETUP_SQPOLL
+                    | (options.sqThreadCpu >= 0 ? IORING_SETUP_SQ_AFF : 0U);
+            case IoUringProfile::SingleIssuer:
+                return IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_DEFER_TASKRUN;
+            case IoUringProfile::CoopTaskRun:
+                return IORING_SETUP_COOP_TASKRUN | IORING_SETUP_TASKRUN_FLAG;
+            default:
+                return 0U;
+        }
+    }
+
+    /**
+     * @brief 保证 SQ 中至少还有 n 个空位, 使之后获取的 n 个 SQE 在同一批中提交 (链接不会被拆开)
+     * @param n 
+     */
+    void reserveSqes(unsigned int n) {
+        if (_epoll) {
+            if (n > _epoll->entries()) [[unlikely]] {
+                throw std::invalid_argument{"io_uring: the chain is longer than the SQ"};
+            }
+            if (_epoll->spaceLeft() < n) {
+                _epoll->submit();
+            }
+            return;
+        }
+        if (n > _ring.sq.ring_entries) [[unlikely]] {
+            throw std::invalid_argument{"io_uring: the chain is longer than the SQ"};
+        }
+        while (::io_uring_sq_space_left(&_ring) < n) {
+            // 先提交已有的 SQE (SQPOLL 下还需要等待内核线程取走)
+            if (::io_uring_submit(&_ring) < 0) [[unlikely]] {
+                ::io_uring_submit_and_wait(&_ring, 1);
+            } else if (::io_uring_sq_space_left(&_ring) < n) {
+                ::io_uring_sqring_wait(&_ring);
+            }
+        }
+    }
+
+    /**
+     * @brief 若 eventfd 上没有挂起的读取, 则挂起一个 (不计入未完成的任务数, 否则事件循环无法退出)
+     */
+    void armWakeup() {
+        if (_wakeupArmed) {
+            return;
+        }
+        auto* sqe = getSqe();
+        --_numSqesPending;
+        ::io_uring_prep_read(sqe, _wakeupFd, &_wakeupBuf, sizeof(_wakeupBuf), 0);
+        ::io_uring_sqe_set_data64(sqe, internal::kWakeupUserData);
+        _wakeupArmed = true;
     }
 
-private:
     ::io_uring_sqe* getSqe() {
+        if (_epoll) {
+            auto* sqe = _epoll->getSqe();
+            if (!sqe) {
+                _epoll->submit(); // 先执行已有的 SQE, 腾出空位
+                sqe = _epoll->getSqe();
+            }
+            ++_numSqesPending;
+            return sqe;
+        }
         // 获取一个任务
         ::io_uring_sqe* sqe = ::io_uring_get_sqe(&_ring);
         while (!sqe) {
@@ -214,14 +637,27 @@ private:
 
     ::io_uring _ring;
     std::size_t _numSqesPending; // 未完成的任务数
-    std::vector<std::coroutine_handle<>> tasks; // 协程任务队列
-                                                // 提取为成员, 避免频繁构造临时变量导致频繁扩容
+    IoUringProfile _profile;     // 实际生效的配置档
+    unsigned int _fixedFiles;    // 已注册的文件表槽位数
+    unsigned int _fixedFilesInUse; // 已占用的文件表槽位数
+    std::vector<std::uint64_t> _cancelQueue; // 待取消的任务的 user_data
+    std::vector<unsigned int> _closeQueue;   // 待关闭的注册文件表槽位 (尚未计入 _fixedFilesInUse)
+    BufRing _bufRing;            // 提供缓冲区环
+    int _wakeupFd;               // 跨线程唤醒用的 eventfd
+    std::uint64_t _wakeupBuf;    // eventfd 读取的缓冲区
+    bool _wakeupArmed;           // eventfd 上是否已有挂起的读取
+    std::size_t _resumeBudget;   // 每一轮至多恢复的协程数 (0 则不限)
+    ResumePriority _resuming;    // 正在恢复的队列的优先级, 新建的 AioTask 沿用之
+    internal::ReadyQueue _ready[2]; // 按优先级划分的协程恢复队列
+                                    // 提取为成员, 避免频繁构造临时变量导致频繁扩容
+    internal::AioTaskTracker _tracker; // 在完成之前被析构的任务
+    std::unique_ptr<EpollRing> _epoll; // epoll 后端 (为空则使用 io_uring)
 };
 
 #elif defined(_WIN32)
 
 struct Iocp {
-    Iocp() 
+    explicit Iocp(EventLoopOptions const& = {}) 
         : _iocpHandle{exception::checkWinError(::CreateIoCompletionPort(
             INVALID_HANDLE_VALUE,
             nullptr,
@@ -229,6 +665,7 @@ struct Iocp {
             0))}
         , _taskCnt{}
         , _tasks{}
+        , _yielded{}
     {
         platform::internal::InitWin32Api::ensure();
     }
@@ -246,7 +683,15 @@ struct Iocp {
      * @return false 无任务
      */
     bool isRun() const {
-        return _taskCnt._numSqesPending;
+        return _taskCnt._numSqesPending || !_yielded.empty();
+    }
+
+    /**
+     * @brief 把协程加入恢复队列, 在下一轮中恢复 (见 EventLoop::yield)
+     * @note IOCP 下不区分优先级, 也不限制每一轮的恢复数
+     */
+    void schedule(std::coroutine_handle<> coroutine, ResumePriority) {
+        _yielded.push_back(coroutine);
     }
 
     void run(std::optional<std::chrono::system_clock::duration> timeout) {
@@ -274,7 +719,9 @@ BOOL GetQueuedCompletionStatusEx(
         std::array<::OVERLAPPED_ENTRY, 64> arr;
         ::ULONG n = 0;
         decltype(toDwMilliseconds(*timeout)) dw = INFINITE;
-        if (timeout) {
+        if (!_yielded.empty()) {
+            dw = 0; // 还有让出的协程等待恢复, 不阻塞
+        } else if (timeout) {
             dw = toDwMilliseconds(*timeout);
         }
         bool ok = ::GetQueuedCompletionStatusEx(
@@ -287,11 +734,17 @@ BOOL GetQueuedCompletionStatusEx(
         );
 
         if (!ok) [[unlikely]] { // 超时
+            resumeYielded();
             return;
         }
 
+        ::ULONG numWakeup = 0;
         for (::ULONG i = 0; i < n; ++i) {
             auto ptr = arr[i];
+            if (!ptr.lpOverlapped) {
+                ++numWakeup; // 仅用于唤醒 (见 wakeup)
+                continue;
+            }
             auto task = std::unique_ptr<AioTask::_AioIocpData>{
                 reinterpret_cast<AioTask::_AioIocpData*>(ptr.lpOverlapped)
             };
@@ -310,8 +763,9 @@ BOOL GetQueuedCompletionStatusEx(
             t.resume();
         }
         
-        _taskCnt._numSqesPending -= static_cast<std::size_t>(n);
+        _taskCnt._numSqesPending -= static_cast<std::size_t>(n - numWakeup);
         _tasks.clear();
+        resumeYielded();
     }
 
     void prepNop() {
@@ -328,6 +782,13 @@ BOOL GetQueuedCompletionStatusEx(
         }
     }
 
+    /**
+     * @brief 唤醒阻塞在 `run` 中的事件循环 (可在任意线程调用)
+     */
+    void wakeup() noexcept {
+        ::PostQueuedCompletionStatus(_iocpHandle, 0, 0, nullptr);
+    }
+
     ~Iocp() noexcept {
         if (_iocpHandle) {
             ::CloseHandle(_iocpHandle);
@@ -335,9 +796,19 @@ BOOL GetQueuedCompletionStatusEx(
     }
 
 private:
+    void resumeYielded() {
+        // 恢复期间再次让出的协程留到下一轮
+        auto yielded = std::move(_yielded);
+        _yielded.clear();
+        for (auto const& t : yielded) {
+            t.resume();
+        }
+    }
+
     ::HANDLE _iocpHandle;
     TaskCnt _taskCnt;
     std::vector<std::coroutine_handle<>> _tasks;
+    std::vector<std::coroutine_handle<>> _yielded; // 让出的协程
 };
 
 #else
@@ -360,14 +831,26 @@ using EventDrive
  * @brief 协程事件循环
  */
 struct EventLoop {
-    EventLoop() 
-        : _eventDrive{}
+    /**
+     * @brief 创建协程事件循环
+     * @param options 事件循环配置 (如 io_uring 配置档, 仅 Linux 有效)
+     */
+    explicit EventLoop(EventLoopOptions const& options = {}) 
+        : _eventDrive{options}
         , _timerLoop{}
         , _theradLoop{}
+        , _posting{0}
     {}
 
     EventLoop& operator=(EventLoop&&) noexcept = delete;
 
+    ~EventLoop() noexcept {
+        // 投递方 push 之后、唤醒之前, 事件循环可能已经执行完该节点并开始析构
+        while (_posting.load(std::memory_order_acquire)) [[unlikely]] {
+            std::this_thread::yield();
+        }
+    }
+
     /**
      * @brief 启动协程, 协程内部如果挂起, 应该调用 run() 进入事件循环, 以恢复挂起.
      * @tparam T 
@@ -460,20 +943,107 @@ struct EventLoop {
     
     /**
      * @brief 启动事件循环
+     * @note 仅剩定时器或线程任务时, 同样阻塞在事件驱动上, 以便被跨线程投递及时唤醒
      */
     void run() {
         for (;;) {
+            _theradLoop.runPosted();
             auto timeout = _timerLoop.run();
-            if (_eventDrive.isRun()) [[likely]] {
+            if (_eventDrive.isRun() || timeout || _theradLoop.isRun()) [[likely]] {
                 _eventDrive.run(timeout);
-            } else if (timeout) {
-                std::this_thread::sleep_for(*timeout);
-            } else if (!_theradLoop.isRun()) [[unlikely]] {
+            } else {
                 break;
             }
         }
     }
 
+    /**
+     * @brief 在事件循环线程中执行 func (可在任意线程调用, 无锁, 不会阻塞事件循环)
+     * @note 若事件循环已经退出 `run`, 则会在下一次 `run` 时执行;
+     *       如需让事件循环等待, 请配合 `makeTheradTask` 使用
+     * @tparam Func `void()`
+     * @param func 
+     */
+    template <typename Func>
+    void post(Func&& func) {
+        postNode(new internal::PostFuncNode<Func>{std::forward<Func>(func)});
+    }
+
+    /**
+     * @brief 投递一个侵入式节点 (可在任意线程调用, 不会分配内存)
+     * @warning push 之后节点可能已在事件循环线程中执行完毕, 调用方不可再访问它
+     * @param node 生命周期由调用方保证, 至少到其 `_invoke` 被调用
+     */
+    void postNode(internal::PostNode* node) noexcept {
+        _posting.fetch_add(1, std::memory_order_relaxed);
+        if (_theradLoop.push(node)) {
+            _eventDrive.wakeup();
+        }
+        _posting.fetch_sub(1, std::memory_order_release);
+    }
+
+    struct SwitchToAwaiter : internal::PostNode {
+        explicit SwitchToAwaiter(EventLoop& loop) noexcept
+            : PostNode{nullptr, &SwitchToAwaiter::invoke}
+            , _loop{loop}
+            , _coroutine{}
+        {}
+
+        constexpr bool await_ready() const noexcept { return false; }
+
+        void await_suspend(std::coroutine_handle<> coroutine) noexcept {
+            _coroutine = coroutine;
+            // push 之后协程可能已在事件循环线程中恢复并销毁了 *this
+            _loop.postNode(this);
+        }
+
+        constexpr void await_resume() const noexcept {}
+
+    private:
+        static void invoke(PostNode* node, bool isRun) {
+            if (isRun) {
+                static_cast<SwitchToAwaiter*>(node)->_coroutine.resume();
+            }
+        }
+
+        EventLoop& _loop;
+        std::coroutine_handle<> _coroutine;
+    };
+
+    /**
+     * @brief 切换到该事件循环的线程中继续执行当前协程: `co_await loop.switchTo();`
+     * @note 节点位于协程帧中, 不会分配内存
+     * @return SwitchToAwaiter 
+     */
+    SwitchToAwaiter switchTo() noexcept {
+        return SwitchToAwaiter{*this};
+    }
+
+    struct YieldAwaiter {
+        constexpr bool await_ready() const noexcept { return false; }
+
+        void await_suspend(std::coroutine_handle<> coroutine) {
+            _loop._eventDrive.schedule(coroutine, _priority);
+        }
+
+        constexpr void await_resume() const noexcept {}
+
+        EventLoop& _loop;
+        ResumePriority _priority;
+    };
+
+    /**
+     * @brief 让出事件循环, 排在本轮已完成的协程之后, 于下一轮以 priority 的优先级恢复:
+     *        `co_await loop.yield();`
+     * @note 用于长时间运行的协程的协作式让出点; `yield(ResumePriority::Bulk)` 之后,
+     *       本协程发起的 IO 完成后同样以 Bulk 恢复, 直到 `yield(ResumePriority::Latency)`
+     * @param priority 
+     * @return YieldAwaiter 
+     */
+    YieldAwaiter yield(ResumePriority priority = ResumePriority::Latency) noexcept {
+        return {*this, priority};
+    }
+
     /**
      * @brief 创建协程定时器
      * @return auto 
@@ -490,8 +1060,29 @@ struct EventLoop {
         return _eventDrive.makeAioTask();
     }
 
+#if defined(__linux__)
+    /**
+     * @brief 创建多发异步IO任务 (一个 SQE 对应多个 CQE)
+     * @return MultishotAioTask 
+     */
+    MultishotAioTask makeMultishotAioTask() {
+        return _eventDrive.makeMultishotAioTask();
+    }
+
+    /**
+     * @brief 创建链式异步IO任务: 之后依次 `add` 的 N 个任务会链接在一起, 一次提交, 只恢复一次
+     * @tparam N 链的长度
+     * @return AioChain<N> 
+     */
+    template <std::size_t N>
+    AioChain<N> makeAioChain() {
+        return _eventDrive.template makeAioChain<N>();
+    }
+#endif
+
     /**
-     * @brief 创建异步线程任务 (仅控制权)
+     * @brief 创建异步线程任务 (仅控制权): 在其 `notify` 之前, 事件循环不会退出 `run`
+     * @warning `notify` 需要在事件循环线程中调用, 一般放在 `post` 的任务中
      * @return decltype(auto) 
      */
     decltype(auto) makeTheradTask() {
@@ -516,6 +1107,7 @@ private:
     internal::EventDrive _eventDrive;
     TimerLoop _timerLoop;
     ThreadLoop _theradLoop;
+    std::atomic_size_t _posting; // 正在投递的线程数
 };
 
 } // namespace HX::coroutine
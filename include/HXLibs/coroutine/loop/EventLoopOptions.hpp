@@ -0,0 +1,126 @@
+#pragma once
+/*
+ * Copyright Heng_Xin. All rights reserved.
+ *
+ * @Author: Heng_Xin
+ * @Date: 2026-10-17 10:12:37
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *	  https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <string_view>
+
+namespace HX::coroutine {
+
+/**
+ * @brief io_uring 的初始化配置档 (仅 Linux 有效, Windows 下忽略)
+ */
+enum class IoUringProfile : std::uint8_t {
+    Default,        // 不设置任何 flag (与之前行为一致)
+    SqPoll,         // IORING_SETUP_SQPOLL: 内核线程轮询 SQ, 提交无需系统调用
+    SingleIssuer,   // IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_DEFER_TASKRUN
+                    // 仅创建 EventLoop 的线程可以提交, 完成事件延迟到 io_uring_enter 时处理
+    CoopTaskRun,    // IORING_SETUP_COOP_TASKRUN | IORING_SETUP_TASKRUN_FLAG
+                    // 完成时不再发送 IPI 打断用户态
+};
+
+/**
+ * @brief 获取配置档的名称
+ * @param profile
+ * @return constexpr std::string_view
+ */
+constexpr std::string_view toString(IoUringProfile profile) noexcept {
+    switch (profile) {
+        case IoUringProfile::SqPoll:       return "sqpoll";
+        case IoUringProfile::SingleIssuer: return "single-issuer";
+        case IoUringProfile::CoopTaskRun:  return "coop-taskrun";
+        default:                           return "default";
+    }
+}
+
+/**
+ * @brief 事件驱动的后端 (仅 Linux 有效, Windows 下忽略)
+ */
+enum class EventBackend : std::uint8_t {
+    Auto,       // 由环境变量 HXLIBS_EVENT_DRIVE (io_uring / epoll) 指定; 未指定则优先 io_uring,
+                // 内核不支持 (或被 seccomp 禁止) 时回退到 epoll
+    IoUring,    // 只使用 io_uring, 不可用时抛出异常
+    Epoll,      // 边沿触发的 epoll (在用户态模拟 io_uring 的 SQ / CQ)
+};
+
+/**
+ * @brief 获取后端的名称
+ * @param backend
+ * @return constexpr std::string_view
+ */
+constexpr std::string_view toString(EventBackend backend) noexcept {
+    switch (backend) {
+        case EventBackend::IoUring: return "io_uring";
+        case EventBackend::Epoll:   return "epoll";
+        default:                    return "auto";
+    }
+}
+
+/**
+ * @brief 协程恢复的优先级 (事件循环每一轮先恢复 Latency, 再恢复 Bulk)
+ * @note 协程以 Bulk 恢复期间发起的 IO, 完成后同样以 Bulk 恢复, 直到其 `yield(Latency)`;
+ *       定时器与跨线程投递的恢复不区分优先级
+ */
+enum class ResumePriority : std::uint8_t {
+    Latency, // 延迟敏感 (默认): 如普通的请求 / 响应
+    Bulk,    // 批量传输: 如大文件的分块发送
+};
+
+/**
+ * @brief 协程事件循环的配置
+ * @note 当内核不支持所选配置档时, 会自动回退到 `IoUringProfile::Default`,
+ *       可以通过 `EventLoop::getEventDrive().profile()` 查看实际生效的配置档;
+ *       实际使用的后端可以通过 `EventLoop::getEventDrive().backend()` 查看.
+ */
+struct EventLoopOptions {
+    // SQ 的长度
+    unsigned int entries = 1024U;
+
+    // CQ 的长度 (0 则使用内核默认值, 即 2 * entries)
+    unsigned int cqEntries = 0U;
+
+    // io_uring 的初始化配置档
+    IoUringProfile profile = IoUringProfile::Default;
+
+    // SqPoll: 内核轮询线程空闲多少毫秒后休眠
+    unsigned int sqThreadIdleMs = 1000U;
+
+    // SqPoll: 内核轮询线程绑定的 CPU (-1 则不绑定)
+    int sqThreadCpu = -1;
+
+    // 注册文件表 (direct descriptor) 的槽位数 (0 则不注册)
+    unsigned int fixedFiles = 0U;
+
+    // 提供缓冲区环的缓冲区个数 (0 则不注册; 必须为 2 的幂, 且不大于 32768)
+    // 注册后, 服务端的读请求由内核在数据到达时才挑选缓冲区, 空闲连接不再持有读缓冲区
+    unsigned int bufRingEntries = 0U;
+
+    // 提供缓冲区环中每个缓冲区的大小
+    unsigned int bufRingBufSize = 4096U;
+
+    // 每一轮至多恢复多少个 IO 完成的协程 (0 则不限); 超出的留到下一轮 (下一轮不阻塞等待),
+    // 其间穿插新的完成事件, 以免批量传输的协程占满一轮, 使小请求排在其后.
+    // Bulk 每一轮至少恢复一个, 不会饿死
+    unsigned int resumeBudget = 0U;
+
+    // 事件驱动的后端 (epoll 下不使用 io_uring 的配置档, 注册文件表与提供缓冲区环在用户态模拟)
+    EventBackend backend = EventBackend::Auto;
+};
+
+} // namespace HX::coroutine
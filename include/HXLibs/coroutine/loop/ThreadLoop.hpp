@@ -18,13 +18,58 @@
  * limitations under the License.
  */
 
-#include <mutex>
-#include <condition_variable>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
 
 namespace HX::coroutine {
 
+namespace internal {
+
+/**
+ * @brief 跨线程投递的任务节点 (侵入式单链表)
+ */
+struct PostNode {
+    /**
+     * @brief 执行或丢弃该节点
+     * @param node 节点自身
+     * @param isRun true: 执行; false: 事件循环析构时仍未执行, 仅释放
+     */
+    using InvokeFunc = void (*)(PostNode* node, bool isRun);
+
+    PostNode* _next{nullptr};
+    InvokeFunc _invoke{nullptr};
+};
+
+/**
+ * @brief 持有任意可调用对象的节点, 执行后释放自身
+ * @tparam Func 
+ */
+template <typename Func>
+struct PostFuncNode : PostNode {
+    explicit PostFuncNode(Func&& func)
+        : PostNode{nullptr, &PostFuncNode::invoke}
+        , _func{std::forward<Func>(func)}
+    {}
+
+    static void invoke(PostNode* node, bool isRun) {
+        std::unique_ptr<PostFuncNode> self{static_cast<PostFuncNode*>(node)};
+        if (isRun) {
+            self->_func();
+        }
+    }
+
+    std::remove_cvref_t<Func> _func;
+};
+
+} // namespace internal
+
 /**
- * @brief 线程循环 (实际上仅是控制器)
+ * @brief 线程循环: 其他线程向事件循环投递任务的无锁 MPSC 队列
+ * @note 生产者使用 CAS 压栈, 消费者 (事件循环线程) 一次取走整个链表并反转为 FIFO 顺序,
+ *       因此不存在 ABA 问题. 唤醒由事件循环负责 (`push` 返回 true 时需要唤醒).
  */
 struct ThreadLoop {
 private:
@@ -32,8 +77,7 @@ private:
         _hx_ThreadLoopController(ThreadLoop& self) noexcept
             : _self{self}
         {
-            std::unique_lock _{_self._mtx};
-            ++_self._threadTaskCnt;
+            _self._threadTaskCnt.fetch_add(1, std::memory_order_relaxed);
         }
 
         _hx_ThreadLoopController(_hx_ThreadLoopController const&) = delete;
@@ -46,46 +90,86 @@ private:
             return *this;
         }
 
+        /**
+         * @brief 线程任务已结束
+         * @warning 需要在事件循环线程中调用 (一般放在投递的任务中), 否则事件循环可能不会被唤醒
+         */
         void notify() noexcept {
-            std::unique_lock _{_self._mtx};
-            --_self._threadTaskCnt;
-            _self.notify();
+            _self._threadTaskCnt.fetch_sub(1, std::memory_order_release);
         }
     private:
         ThreadLoop& _self;  
     };
 public:
     ThreadLoop()
-        : _mtx{}
-        , _cv{}
+        : _head{nullptr}
         , _threadTaskCnt{0}
     {}
 
-    bool isRun() noexcept {
-        std::size_t cnt = 0;
-        std::unique_lock lock{_mtx};
-        if (_threadTaskCnt == 0) {
-            return false;
+    ThreadLoop& operator=(ThreadLoop&&) noexcept = delete;
+
+    ~ThreadLoop() noexcept {
+        for (auto* node = _head.exchange(nullptr, std::memory_order_acquire); node;) {
+            auto* next = node->_next;
+            node->_invoke(node, false);
+            node = next;
         }
-        cnt = _threadTaskCnt;
-        _cv.wait(lock, [&] {
-            return cnt > _threadTaskCnt;
-        });
-        return true;
+    }
+
+    /**
+     * @brief 是否还有未完成的线程任务, 或尚未执行的投递 (不会阻塞)
+     * @return true 
+     */
+    bool isRun() const noexcept {
+        return _threadTaskCnt.load(std::memory_order_acquire)
+            || _head.load(std::memory_order_acquire);
     }
 
     auto makeThreadTask() noexcept {
         return _hx_ThreadLoopController{*this};
     }
 
-private:
-    void notify() noexcept {
-        _cv.notify_one();
+    /**
+     * @brief 投递一个节点 (任意线程)
+     * @param node 
+     * @return true 队列原先为空, 需要唤醒事件循环
+     */
+    bool push(internal::PostNode* node) noexcept {
+        auto* head = _head.load(std::memory_order_relaxed);
+        do {
+            node->_next = head;
+        } while (!_head.compare_exchange_weak(
+            head, node, std::memory_order_release, std::memory_order_relaxed));
+        return !head;
     }
 
-    mutable std::mutex _mtx;
-    std::condition_variable _cv;
-    std::size_t _threadTaskCnt;
+    /**
+     * @brief 执行所有已投递的任务 (仅事件循环线程)
+     * @return true 执行了至少一个任务
+     */
+    bool runPosted() {
+        auto* node = _head.exchange(nullptr, std::memory_order_acquire);
+        if (!node) {
+            return false;
+        }
+        internal::PostNode* fifo = nullptr;
+        while (node) {
+            auto* next = node->_next;
+            node->_next = fifo;
+            fifo = node;
+            node = next;
+        }
+        while (fifo) {
+            auto* next = fifo->_next;
+            fifo->_invoke(fifo, true);
+            fifo = next;
+        }
+        return true;
+    }
+
+private:
+    std::atomic<internal::PostNode*> _head;
+    std::atomic<std::size_t> _threadTaskCnt;
 };
 
-} // namespace HX::coroutine
\ No newline at end of file
+} // namespace HX::coroutine
@@ -18,84 +18,205 @@
  * limitations under the License.
  */
 
+#include <array>
+#include <bit>
 #include <chrono>
-#include <map>
+#include <cstdint>
 #include <list>
+#include <optional>
 #include <coroutine>
 
 namespace HX::coroutine {
 
 /**
- * @brief 定时器循环
+ * @brief 定时器循环 (分层时间轮)
+ * @note 时间基准为单调时钟 `steady_clock`, 精度为 1ms (只会晚于、不会早于过期时间触发).
+ *       共 kLevels 层, 每层 64 个槽位; 第 k 层的一个槽位跨度为 64^k ms,
+ *       定时器按 过期 tick 与 当前 tick 的最高不同位 放入对应层, 因此插入与取消都是 O(1);
+ *       进入高层槽位的时间段时, 再将其中的定时器下放到低层 (级联).
+ *       超过 64^kLevels ms (约 2.2 年) 的定时器放在溢出链表中, 在最高层进位时重新插入.
  */
 struct TimerLoop {
-    using TimerTree = std::multimap<std::chrono::system_clock::time_point, std::coroutine_handle<>>;
+    using Clock = std::chrono::steady_clock;
     using YieldQueue = std::list<std::coroutine_handle<>>;
 
+    inline static constexpr std::size_t kLevels = 6;
+    inline static constexpr std::size_t kSlotBits = 6;
+    inline static constexpr std::size_t kSlots = 1ULL << kSlotBits;
+
+    /**
+     * @brief 侵入式双向链表节点, 由 TimerAwaiter 持有; 槽位的头节点为循环的哨兵节点
+     */
+    struct TimerNode {
+        void initSentinel() noexcept {
+            _prev = _next = this;
+        }
+
+        bool isLinked() const noexcept {
+            return _next;
+        }
+
+        bool isEmpty() const noexcept {
+            return _next == this;
+        }
+
+        TimerNode* _prev = nullptr;
+        TimerNode* _next = nullptr;
+        std::uint64_t _expireTick = 0;      // 过期的 tick (ms)
+        std::coroutine_handle<> _coroutine{};
+        std::uint8_t _level = 0;            // 所在的层 (kLevels 表示溢出链表)
+        std::uint8_t _index = 0;            // 所在的槽位
+    };
+
+    TimerLoop() noexcept
+        : _wheel{}
+        , _bitmap{}
+        , _overflow{}
+        , _startTime{Clock::now()}
+        , _curTick{0}
+        , _yieldQueue{}
+    {
+        for (auto& level : _wheel) {
+            for (auto& slot : level) {
+                slot.initSentinel();
+            }
+        }
+        _overflow.initSentinel();
+    }
+
     TimerLoop& operator=(TimerLoop&&) = delete;
 
     std::optional<std::chrono::system_clock::duration> run() {
-        while (_timerTree.size()) {
-            auto nowTime = std::chrono::system_clock::now();
-            auto it = _timerTree.begin();
-            if (it->first <= nowTime) {
-                it->second.resume();
-                _timerTree.erase(it);
-            } else {
-                return it->first - nowTime;
+        // 每轮只读取一次时间, 同一 tick 内过期的定时器批量恢复
+        auto const now = Clock::now();
+        auto const nowTick = toTickFloor(now);
+        for (auto next = nextTick(); next && *next <= nowTick; next = nextTick()) {
+            _curTick = *next;
+            for (std::size_t k = kLevels; k > 0; --k) {
+                if (!(_curTick & ((1ULL << (kSlotBits * k)) - 1))) {
+                    cascade(k);
+                }
             }
+            auto& slot = _wheel[0][_curTick & (kSlots - 1)];
+            while (!slot.isEmpty()) {
+                // 恢复的协程可能插入或取消同一槽位中的定时器, 因此每次只取出头部
+                auto* node = slot._next;
+                unlink(node);
+                node->_coroutine.resume();
+            }
+        }
+        if (_curTick < nowTick) {
+            _curTick = nowTick;
         }
         while (_yieldQueue.size()) {
             _yieldQueue.front().resume();
             _yieldQueue.pop_front();
         }
+        if (auto next = nextTick()) {
+            auto const expireTime = _startTime + std::chrono::milliseconds{
+                static_cast<std::chrono::milliseconds::rep>(*next)};
+            return std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                expireTime > now ? expireTime - now : Clock::duration{});
+        }
         return {};
     }
 
-    TimerTree::iterator addTimer(
-        std::chrono::system_clock::time_point expireTime,
-        std::coroutine_handle<> coroutine
-    ) {
-        return _timerTree.insert({expireTime, coroutine});
+    /**
+     * @brief 插入定时器
+     * @param node 节点 (需要已设置 `_expireTick` 与 `_coroutine`)
+     */
+    void addTimer(TimerNode* node) noexcept {
+        link(node);
+    }
+
+    /**
+     * @brief 取消定时器
+     * @param node 已插入的节点
+     */
+    void cancelTimer(TimerNode* node) noexcept {
+        unlink(node);
+    }
+
+    /**
+     * @brief 将时间点转换为 tick (向上取整, 保证不会提前触发)
+     * @param time 
+     * @return std::uint64_t 
+     */
+    std::uint64_t toTickCeil(Clock::time_point time) const noexcept {
+        if (time <= _startTime) {
+            return 0;
+        }
+        return static_cast<std::uint64_t>(
+            std::chrono::ceil<std::chrono::milliseconds>(time - _startTime).count());
     }
 
     struct [[nodiscard]] TimerAwaiter {
         TimerAwaiter(TimerLoop* timerLoop)
             : _timerLoop{timerLoop}
             , _expireTime{}
-            , _it{}
+            , _node{}
         {}
 
         TimerAwaiter(TimerAwaiter const&) = delete;
         TimerAwaiter& operator=(TimerAwaiter const&) noexcept = delete;
 
-        TimerAwaiter(TimerAwaiter&&) = default;
-        TimerAwaiter& operator=(TimerAwaiter&&) noexcept = default;
+        TimerAwaiter(TimerAwaiter&& that) noexcept
+            : _timerLoop{that._timerLoop}
+            , _expireTime{that._expireTime}
+            , _node{}
+        {
+            takeNode(that);
+        }
+
+        TimerAwaiter& operator=(TimerAwaiter&& that) noexcept {
+            if (this != &that) [[likely]] {
+                cancel();
+                _timerLoop = that._timerLoop;
+                _expireTime = that._expireTime;
+                takeNode(that);
+            }
+            return *this;
+        }
 
         bool await_ready() const noexcept {
             return false;
         }
         void await_suspend(std::coroutine_handle<> coroutine) const noexcept {
-            _it = _timerLoop->addTimer(_expireTime, coroutine);
+            _node._coroutine = coroutine;
+            _node._expireTick = _timerLoop->toTickCeil(_expireTime);
+            _timerLoop->addTimer(&_node);
         }
         void await_resume() const noexcept {
-            _it.reset(); // 如果继续, 说明是从 TimerTree::run() 来的
-                         // 之后外界会执行 _timerTree.erase(_it)
-                         // 因此内部要执行 _it = {}, 防止多次 erase
+            // 如果继续, 说明是从 TimerLoop::run() 来的, 节点已经被移出时间轮
         }
-        TimerAwaiter&& setExpireTime(std::chrono::system_clock::time_point expireTime) && noexcept {
+        TimerAwaiter&& setExpireTime(Clock::time_point expireTime) && noexcept {
             _expireTime = expireTime;
             return std::move(*this);
         }
         ~TimerAwaiter() noexcept {
-            if (_it) {
-                _timerLoop->_timerTree.erase(*_it);
-            }
+            cancel();
         }
     private:
+        void cancel() noexcept {
+            if (_node.isLinked()) {
+                _timerLoop->cancelTimer(&_node);
+            }
+        }
+
+        void takeNode(TimerAwaiter& that) noexcept {
+            if (!that._node.isLinked()) {
+                return;
+            }
+            // 已在时间轮中: 由新对象的节点接替原节点的位置
+            _node = that._node;
+            _node._prev->_next = &_node;
+            _node._next->_prev = &_node;
+            that._node._prev = that._node._next = nullptr;
+        }
+
         TimerLoop* _timerLoop;
-        std::chrono::system_clock::time_point _expireTime;  // 过期时间
-        mutable std::optional<TimerTree::iterator> _it;     // 红黑树迭代器
+        Clock::time_point _expireTime;  // 过期时间
+        mutable TimerNode _node;        // 时间轮中的节点
     };
 
     struct [[nodiscard]] YieldAwaiter {
@@ -117,7 +238,7 @@ struct TimerLoop {
             _it = _timerLoop->_yieldQueue.insert(_timerLoop->_yieldQueue.end(), coroutine);
         }
         void await_resume() const noexcept {
-            _it.reset(); // 如果继续, 说明是从 TimerTree::run() 来的
+            _it.reset(); // 如果继续, 说明是从 TimerLoop::run() 来的
                          // 之后外界会执行 _yieldQueue.erase(_it)
                          // 因此内部要执行 _it = {}, 防止多次 erase
         }
@@ -144,7 +265,7 @@ private:
          */
         TimerAwaiter sleepFor(std::chrono::system_clock::duration duration) && {
             return TimerAwaiter{_timerLoop}.setExpireTime(
-                std::chrono::system_clock::now() + duration);
+                Clock::now() + std::chrono::duration_cast<Clock::duration>(duration));
         }
         /**
          * @brief 暂停指定时间点
@@ -152,6 +273,23 @@ private:
          * @param expireTime 时间点, 如 2024-8-4 22:12:23
          */
         TimerAwaiter sleepUntil(std::chrono::system_clock::time_point expireTime) && {
+            // 换算到单调时钟; 之后修改系统时间不会影响该定时器
+            auto const sysNow = std::chrono::system_clock::now();
+            auto const steadyNow = Clock::now();
+            if (expireTime <= sysNow) {
+                return TimerAwaiter{_timerLoop}.setExpireTime(steadyNow);
+            }
+            auto const dur = std::chrono::duration_cast<Clock::duration>(expireTime - sysNow);
+            return TimerAwaiter{_timerLoop}.setExpireTime(
+                dur < Clock::time_point::max() - steadyNow
+                    ? steadyNow + dur
+                    : Clock::time_point::max());
+        }
+        /**
+         * @brief 暂停到单调时钟的指定时间点
+         * @param expireTime 时间点
+         */
+        TimerAwaiter sleepUntil(Clock::time_point expireTime) && {
             return TimerAwaiter{_timerLoop}.setExpireTime(expireTime);
         }
         /**
@@ -172,7 +310,103 @@ public:
         return {&timerLoop};
     }
 private:
-    TimerTree _timerTree;
+    std::uint64_t toTickFloor(Clock::time_point time) const noexcept {
+        return static_cast<std::uint64_t>(
+            std::chrono::floor<std::chrono::milliseconds>(time - _startTime).count());
+    }
+
+    void pushBack(TimerNode& head, TimerNode* node) noexcept {
+        node->_prev = head._prev;
+        node->_next = &head;
+        head._prev->_next = node;
+        head._prev = node;
+    }
+
+    void link(TimerNode* node) noexcept {
+        auto const tick = node->_expireTick < _curTick ? _curTick : node->_expireTick;
+        auto const diff = tick ^ _curTick;
+        if (diff >> (kSlotBits * kLevels)) [[unlikely]] {
+            node->_level = static_cast<std::uint8_t>(kLevels);
+            pushBack(_overflow, node);
+            return;
+        }
+        // 最高不同位所在的层; 同一层中, 其槽位一定在当前槽位之后
+        auto const level = diff
+            ? (static_cast<std::size_t>(std::bit_width(diff)) - 1) / kSlotBits
+            : 0;
+        auto const index = (tick >> (kSlotBits * level)) & (kSlots - 1);
+        node->_level = static_cast<std::uint8_t>(level);
+        node->_index = static_cast<std::uint8_t>(index);
+        pushBack(_wheel[level][index], node);
+        _bitmap[level] |= 1ULL << index;
+    }
+
+    void unlink(TimerNode* node) noexcept {
+        node->_prev->_next = node->_next;
+        node->_next->_prev = node->_prev;
+        node->_prev = node->_next = nullptr;
+        if (node->_level < kLevels && _wheel[node->_level][node->_index].isEmpty()) {
+            _bitmap[node->_level] &= ~(1ULL << node->_index);
+        }
+    }
+
+    /**
+     * @brief 进入第 k 层的新槽位 (k == kLevels 则为溢出链表) 时, 将其中的定时器重新插入到低层
+     * @param k 
+     */
+    void cascade(std::size_t k) noexcept {
+        auto& slot = k < kLevels
+            ? _wheel[k][(_curTick >> (kSlotBits * k)) & (kSlots - 1)]
+            : _overflow;
+        if (slot.isEmpty()) {
+            return;
+        }
+        TimerNode list;
+        list._prev = slot._prev;
+        list._next = slot._next;
+        list._next->_prev = list._prev->_next = &list;
+        slot.initSentinel();
+        if (k < kLevels) {
+            _bitmap[k] &= ~(1ULL << ((_curTick >> (kSlotBits * k)) & (kSlots - 1)));
+        }
+        while (list._next != &list) {
+            auto* node = list._next;
+            list._next = node->_next;
+            node->_next->_prev = &list;
+            link(node);
+        }
+    }
+
+    /**
+     * @brief 下一个需要处理 (过期或级联) 的 tick
+     * @note 第 0 层包含当前槽位 (过期时间不晚于当前 tick 的定时器);
+     *       低层的候选一定早于高层, 因此找到第一个非空的层即可
+     * @return std::optional<std::uint64_t> 无定时器则为空
+     */
+    std::optional<std::uint64_t> nextTick() const noexcept {
+        for (std::size_t k = 0; k < kLevels; ++k) {
+            auto const shift = kSlotBits * k;
+            auto const index = (_curTick >> shift) & (kSlots - 1);
+            auto const mask = k == 0
+                ? ~0ULL << index
+                : (index == kSlots - 1 ? 0ULL : ~0ULL << (index + 1));
+            if (auto bits = _bitmap[k] & mask) {
+                auto const j = static_cast<std::uint64_t>(std::countr_zero(bits));
+                return ((_curTick >> (shift + kSlotBits)) << (shift + kSlotBits)) | (j << shift);
+            }
+        }
+        if (!_overflow.isEmpty()) {
+            auto const shift = kSlotBits * kLevels;
+            return ((_curTick >> shift) + 1) << shift;
+        }
+        return {};
+    }
+
+    std::array<std::array<TimerNode, kSlots>, kLevels> _wheel;  // 时间轮
+    std::array<std::uint64_t, kLevels> _bitmap;                 // 每层非空槽位的位图
+    TimerNode _overflow;                                        // 超出时间轮范围的定时器
+    Clock::time_point _startTime;                               // tick 0 对应的时间点
+    std::uint64_t _curTick;                                     // 当前 tick (ms)
     YieldQueue _yieldQueue;
 };
 
@@ -0,0 +1,183 @@
+#pragma once
+/*
+ * Copyright Heng_Xin. All rights reserved.
+ *
+ * @Author: Heng_Xin
+ * @Date: 2026-10-17 18:42:10
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *	  https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <new>
+
+namespace HX::coroutine {
+
+/**
+ * @brief 协程帧分配器: 每个线程一个按大小分级的空闲链表缓存
+ * @note 帧大小向上取整到 2 的幂 (64 B ~ 16 KiB), 更大的帧直接使用全局堆.
+ *       每个块都是独立从全局堆分配的, 因此可以在任意线程释放: 释放的块进入 *释放线程* 的缓存
+ *       (超过缓存上限则归还全局堆), 不需要找回分配它的线程.
+ *       定义 `HXLIBS_DISABLE_FRAME_POOL` 可关闭 (如使用 ASan 排查协程帧的释放后使用时).
+ */
+struct FrameAllocator {
+    inline static constexpr std::size_t kMinSizeLog2 = 6;  // 64 B
+    inline static constexpr std::size_t kMaxSizeLog2 = 14; // 16 KiB
+    inline static constexpr std::size_t kClassNum = kMaxSizeLog2 - kMinSizeLog2 + 1;
+    inline static constexpr std::size_t kMaxCachedBytes = 256 * 1024; // 每个大小级别最多缓存的字节数
+
+    /**
+     * @brief 分配协程帧
+     * @param size
+     * @return void*
+     */
+    static void* allocate(std::size_t size) {
+        auto const idx = sizeClass(size);
+        if (idx < kClassNum) [[likely]] {
+            if (!tCacheDead) [[likely]] {
+                if (void* ptr = cache().pop(idx)) [[likely]] {
+                    return ptr;
+                }
+            }
+            // 总是分配整个级别的大小: 该块可能在其他线程释放, 进入其缓存后被用于同级别的更大的帧
+            size = classSize(idx);
+        }
+        sHeapAllocations.fetch_add(1, std::memory_order_relaxed);
+        return ::operator new(size);
+    }
+
+    /**
+     * @brief 释放协程帧 (可以不是分配时的线程)
+     * @param ptr
+     * @param size 与分配时相同的大小
+     */
+    static void deallocate(void* ptr, std::size_t size) noexcept {
+        auto const idx = sizeClass(size);
+        if (idx < kClassNum && !tCacheDead) [[likely]] {
+            if (cache().push(idx, ptr)) [[likely]] {
+                return;
+            }
+        }
+        ::operator delete(ptr);
+    }
+
+    /**
+     * @brief 从全局堆分配的次数 (所有线程; 缓存未命中 + 超大帧)
+     * @return std::size_t
+     */
+    static std::size_t heapAllocations() noexcept {
+        return sHeapAllocations.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct FreeBlock {
+        FreeBlock* _next;
+    };
+
+    struct ThreadCache {
+        ThreadCache() noexcept
+            : _heads{}
+            , _counts{}
+        {}
+
+        ThreadCache& operator=(ThreadCache&&) noexcept = delete;
+
+        ~ThreadCache() noexcept {
+            tCacheDead = true; // 之后 (其他 thread_local 析构时) 释放的帧直接归还全局堆
+            for (auto* head : _heads) {
+                while (head) {
+                    auto* next = head->_next;
+                    ::operator delete(head);
+                    head = next;
+                }
+            }
+        }
+
+        void* pop(std::size_t idx) noexcept {
+            auto* block = _heads[idx];
+            if (block) [[likely]] {
+                _heads[idx] = block->_next;
+                --_counts[idx];
+            }
+            return block;
+        }
+
+        bool push(std::size_t idx, void* ptr) noexcept {
+            if (_counts[idx] >= maxCached(idx)) [[unlikely]] {
+                return false;
+            }
+            auto* block = static_cast<FreeBlock*>(ptr);
+            block->_next = _heads[idx];
+            _heads[idx] = block;
+            ++_counts[idx];
+            return true;
+        }
+
+        std::array<FreeBlock*, kClassNum> _heads;
+        std::array<std::size_t, kClassNum> _counts;
+    };
+
+    /**
+     * @brief 大小级别, 超出范围时 >= kClassNum
+     */
+    static constexpr std::size_t sizeClass(std::size_t size) noexcept {
+        if (size <= (std::size_t{1} << kMinSizeLog2)) {
+            return 0;
+        }
+        return static_cast<std::size_t>(std::bit_width(size - 1)) - kMinSizeLog2;
+    }
+
+    static constexpr std::size_t classSize(std::size_t idx) noexcept {
+        return std::size_t{1} << (idx + kMinSizeLog2);
+    }
+
+    /**
+     * @brief 每个大小级别最多缓存的块数 (至少 16 个)
+     */
+    static constexpr std::size_t maxCached(std::size_t idx) noexcept {
+        auto const n = kMaxCachedBytes / classSize(idx);
+        return n < 16 ? 16 : n;
+    }
+
+    static ThreadCache& cache() noexcept {
+        thread_local ThreadCache tCache{};
+        return tCache;
+    }
+
+    inline static thread_local bool tCacheDead = false; // 平凡析构, 线程退出期间依然可读
+    inline static std::atomic<std::size_t> sHeapAllocations{0};
+};
+
+namespace internal {
+
+/**
+ * @brief 协程帧使用 FrameAllocator 分配 (Promise 继承之)
+ */
+struct PooledFrame {
+#if !defined(HXLIBS_DISABLE_FRAME_POOL)
+    static void* operator new(std::size_t size) {
+        return FrameAllocator::allocate(size);
+    }
+
+    static void operator delete(void* ptr, std::size_t size) noexcept {
+        FrameAllocator::deallocate(ptr, size);
+    }
+#endif
+};
+
+} // namespace internal
+
+} // namespace HX::coroutine
@@ -23,6 +23,7 @@
 
 #include <HXLibs/coroutine/awaiter/StopAwaiter.hpp>
 #include <HXLibs/coroutine/awaiter/PreviousAwaiter.hpp>
+#include <HXLibs/coroutine/promise/FrameAllocator.hpp>
 #include <HXLibs/container/Uninitialized.hpp>
 
 namespace HX::coroutine {
@@ -32,13 +33,14 @@ namespace HX::coroutine {
  * @tparam T 返回类型
  * @tparam Init 初始化体 (initial_suspend)
  * @tparam Dele 删除体 (final_suspend)
+ * @note 协程帧由 FrameAllocator 分配
  */
 template <
     typename T, 
     typename Init = StopAwaiter<true>,
     typename Dele = PreviousAwaiter
 >
-struct Promise {
+struct Promise : internal::PooledFrame {
     using InitStrategy = Init;
     using DeleStrategy = Dele;
 
@@ -100,7 +102,7 @@ private:
 };
 
 template <typename Init, typename Dele>
-struct Promise<void, Init, Dele> {
+struct Promise<void, Init, Dele> : internal::PooledFrame {
     using InitStrategy = Init;
     using DeleStrategy = Dele;
 
@@ -0,0 +1,186 @@
+#pragma once
+/*
+ * Copyright Heng_Xin. All rights reserved.
+ *
+ * @Author: Heng_Xin
+ * @Date: 2026-10-17 22:20:45
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *	  https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+
+#include <HXLibs/coroutine/sync/_AsyncWaiter.hpp>
+
+namespace HX::coroutine {
+
+/**
+ * @brief 协程互斥锁: `co_await mtx.lock(); ... mtx.unlock();`
+ * @note 完全无锁: 状态为 未加锁 / 已加锁无等待者 / 新等待者栈顶指针.
+ *       新等待者 CAS 入栈; 持有者解锁时把栈整体取走并反转为 FIFO 队列 (仅持有者访问), 依次移交锁.
+ *       `lock()` 的等待者由解锁方直接恢复; `lock(loop)` 的等待者在 loop 中恢复, 可跨事件循环使用.
+ * @warning 加锁不可取消: 等待者位于无锁栈中, 无法出队, 挂起后的 awaiter 在获得锁之前不能被析构
+ *          (不要用于 `whenAny(mtx.lock(), timer)`); 需要超时请使用 AsyncSemaphore{1}.
+ */
+class AsyncMutex {
+    inline static constexpr std::uintptr_t kLockedNoWaiters = 0;
+    inline static constexpr std::uintptr_t kNotLocked = 1;
+
+public:
+    AsyncMutex() noexcept
+        : _state{kNotLocked}
+        , _waiters{nullptr}
+    {}
+
+    AsyncMutex& operator=(AsyncMutex&&) noexcept = delete;
+
+    struct LockAwaiter : internal::AsyncWaiter {
+        LockAwaiter(AsyncMutex& mtx, EventLoop* loop) noexcept
+            : AsyncWaiter{loop}
+            , _mtx{mtx}
+        {}
+
+        bool await_ready() noexcept {
+            return _mtx.tryLock();
+        }
+
+        bool await_suspend(std::coroutine_handle<> coroutine) noexcept {
+            prepare(coroutine);
+            auto old = _mtx._state.load(std::memory_order_acquire);
+            for (;;) {
+                if (old == kNotLocked) {
+                    if (_mtx._state.compare_exchange_weak(
+                        old, kLockedNoWaiters,
+                        std::memory_order_acquire, std::memory_order_acquire)
+                    ) {
+                        cancelPrepare();
+                        return false;
+                    }
+                } else {
+                    _nextWaiter = reinterpret_cast<AsyncWaiter*>(old);
+                    if (_mtx._state.compare_exchange_weak(
+                        old, reinterpret_cast<std::uintptr_t>(static_cast<AsyncWaiter*>(this)),
+                        std::memory_order_release, std::memory_order_acquire)
+                    ) {
+                        return true;
+                    }
+                }
+            }
+        }
+
+        constexpr void await_resume() const noexcept {}
+
+    protected:
+        AsyncMutex& _mtx;
+    };
+
+    /**
+     * @brief 持有锁的 RAII 对象, 析构时解锁
+     */
+    struct [[nodiscard]] LockGuard {
+        explicit LockGuard(AsyncMutex& mtx) noexcept
+            : _mtx{&mtx}
+        {}
+
+        LockGuard(LockGuard&& that) noexcept
+            : _mtx{std::exchange(that._mtx, nullptr)}
+        {}
+
+        LockGuard& operator=(LockGuard&&) noexcept = delete;
+
+        ~LockGuard() noexcept {
+            if (_mtx) {
+                _mtx->unlock();
+            }
+        }
+
+    private:
+        AsyncMutex* _mtx;
+    };
+
+    struct ScopedLockAwaiter : LockAwaiter {
+        using LockAwaiter::LockAwaiter;
+
+        LockGuard await_resume() const noexcept {
+            return LockGuard{_mtx};
+        }
+    };
+
+    /**
+     * @brief 尝试加锁 (不会挂起)
+     * @return true 成功
+     */
+    bool tryLock() noexcept {
+        auto old = kNotLocked;
+        return _state.compare_exchange_strong(
+            old, kLockedNoWaiters, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 加锁, 由解锁方直接恢复 (同一事件循环内使用)
+     * @warning 不可取消, 见类的说明
+     */
+    LockAwaiter lock() noexcept {
+        return {*this, nullptr};
+    }
+
+    /**
+     * @brief 加锁, 在 loop 中恢复 (跨事件循环使用, loop 为当前协程所在的事件循环)
+     */
+    LockAwaiter lock(EventLoop& loop) noexcept {
+        return {*this, &loop};
+    }
+
+    /**
+     * @brief 加锁并返回 RAII 对象: `auto guard = co_await mtx.scopedLock();`
+     */
+    ScopedLockAwaiter scopedLock() noexcept {
+        return {*this, nullptr};
+    }
+
+    ScopedLockAwaiter scopedLock(EventLoop& loop) noexcept {
+        return {*this, &loop};
+    }
+
+    /**
+     * @brief 解锁; 有等待者时, 锁直接移交给最早的等待者
+     */
+    void unlock() {
+        auto* head = _waiters;
+        if (!head) {
+            auto old = kLockedNoWaiters;
+            if (_state.compare_exchange_strong(
+                old, kNotLocked, std::memory_order_release, std::memory_order_relaxed)
+            ) {
+                return;
+            }
+            // 有新的等待者: 取走整个栈并反转为 FIFO
+            auto* node = reinterpret_cast<internal::AsyncWaiter*>(
+                _state.exchange(kLockedNoWaiters, std::memory_order_acquire));
+            do {
+                auto* next = node->_nextWaiter;
+                node->_nextWaiter = head;
+                head = node;
+                node = next;
+            } while (node);
+        }
+        _waiters = head->_nextWaiter;
+        head->wake();
+    }
+
+private:
+    std::atomic<std::uintptr_t> _state;
+    internal::AsyncWaiter* _waiters; // 已按 FIFO 排好的等待者, 仅持有者访问
+};
+
+} // namespace HX::coroutine
@@ -0,0 +1,171 @@
+#pragma once
+/*
+ * Copyright Heng_Xin. All rights reserved.
+ *
+ * @Author: Heng_Xin
+ * @Date: 2026-10-17 22:20:45
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *	  https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstddef>
+#include <mutex>
+
+#include <HXLibs/coroutine/sync/_AsyncWaiter.hpp>
+
+namespace HX::coroutine {
+
+/**
+ * @brief 协程计数信号量, 用于限制并发数: `co_await sem.acquire(); ... sem.release();`
+ * @note 计数为正时, acquire / release 只有一次原子操作; 计数为负表示有 (或即将有) 等待者,
+ *       此时才进入自旋锁保护的侵入式等待队列. release 时若等待者尚未入队, 记为待领取的许可.
+ *       可以放弃等待 (如 whenAny 中落败), 等待者出队并归还计数.
+ */
+class AsyncSemaphore {
+public:
+    explicit AsyncSemaphore(std::ptrdiff_t count) noexcept
+        : _count{count}
+        , _lock{}
+        , _waiters{}
+        , _pending{0}
+    {}
+
+    AsyncSemaphore& operator=(AsyncSemaphore&&) noexcept = delete;
+
+    struct AcquireAwaiter : internal::AsyncWaiter {
+        AcquireAwaiter(AsyncSemaphore& sem, EventLoop* loop) noexcept
+            : AsyncWaiter{loop}
+            , _sem{sem}
+        {}
+
+        AcquireAwaiter& operator=(AcquireAwaiter&&) noexcept = delete;
+
+        ~AcquireAwaiter() noexcept {
+            if (isPrepared()) {
+                std::lock_guard _{_sem._lock};
+                if (_sem._waiters.erase(this)) {
+                    cancelPrepare();
+                    _sem.cancelWaiter();
+                }
+            }
+        }
+
+        bool await_ready() noexcept {
+            return _sem.tryAcquire();
+        }
+
+        bool await_suspend(std::coroutine_handle<> coroutine) {
+            if (_sem._count.fetch_sub(1, std::memory_order_acquire) > 0) {
+                return false;
+            }
+            prepare(coroutine);
+            {
+                std::lock_guard _{_sem._lock};
+                if (_sem._pending) {
+                    --_sem._pending;
+                } else {
+                    _sem._waiters.push(this);
+                    return true;
+                }
+            }
+            cancelPrepare();
+            return false;
+        }
+
+        constexpr void await_resume() const noexcept {}
+
+    private:
+        AsyncSemaphore& _sem;
+    };
+
+    /**
+     * @brief 尝试获取一个许可 (不会挂起)
+     * @return true 成功
+     */
+    bool tryAcquire() noexcept {
+        auto cnt = _count.load(std::memory_order_relaxed);
+        while (cnt > 0) {
+            if (_count.compare_exchange_weak(
+                cnt, cnt - 1, std::memory_order_acquire, std::memory_order_relaxed)
+            ) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief 获取一个许可, 由释放方直接恢复 (同一事件循环内使用)
+     */
+    AcquireAwaiter acquire() noexcept {
+        return {*this, nullptr};
+    }
+
+    /**
+     * @brief 获取一个许可, 在 loop 中恢复 (跨事件循环使用, loop 为当前协程所在的事件循环)
+     */
+    AcquireAwaiter acquire(EventLoop& loop) noexcept {
+        return {*this, &loop};
+    }
+
+    /**
+     * @brief 释放 n 个许可, 依次移交给最早的等待者
+     */
+    void release(std::ptrdiff_t n = 1) {
+        for (; n > 0; --n) {
+            if (_count.fetch_add(1, std::memory_order_release) >= 0) {
+                continue;
+            }
+            internal::AsyncWaiter* waiter;
+            {
+                std::lock_guard _{_lock};
+                waiter = _waiters.pop();
+                if (!waiter) {
+                    ++_pending; // 等待者已扣减计数, 但尚未入队
+                    continue;
+                }
+            }
+            waiter->wake();
+        }
+    }
+
+    /**
+     * @brief 当前可用的许可数 (负数表示等待者的数量)
+     */
+    std::ptrdiff_t available() const noexcept {
+        return _count.load(std::memory_order_relaxed);
+    }
+
+private:
+    /**
+     * @brief 等待者放弃等待, 归还其扣减的计数 (持有 _lock 时调用)
+     */
+    void cancelWaiter() noexcept {
+        auto cnt = _count.load(std::memory_order_relaxed);
+        while (cnt < 0) {
+            if (_count.compare_exchange_weak(
+                cnt, cnt + 1, std::memory_order_relaxed, std::memory_order_relaxed)
+            ) {
+                return;
+            }
+        }
+        // 计数已被 release 补上: 该 release 拿锁后找不到等待者, 会记为待领取的许可
+    }
+
+    std::atomic<std::ptrdiff_t> _count;
+    internal::SpinLock _lock;
+    internal::WaiterQueue _waiters;
+    std::ptrdiff_t _pending;
+};
+
+} // namespace HX::coroutine
@@ -0,0 +1,238 @@
+#pragma once
+/*
+ * Copyright Heng_Xin. All rights reserved.
+ *
+ * @Author: Heng_Xin
+ * @Date: 2026-10-17 22:20:45
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *	  https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <mutex>
+
+#include <HXLibs/coroutine/sync/_AsyncWaiter.hpp>
+
+namespace HX::coroutine {
+
+/**
+ * @brief 协程读写锁: `co_await mtx.lockShared(); ... mtx.unlockShared();`
+ * @note 状态字 = 读者数 << 2 | 有等待者 | 写者持有. 无等待者时, 加解锁都只是一次 CAS;
+ *       一旦有等待者, 新来的读者也要排队 (避免写者饿死), 最后一个持有者离开时按 FIFO 移交:
+ *       队首是写者则只唤醒它, 否则唤醒队首连续的所有读者. 可以放弃等待 (如 whenAny 中落败).
+ */
+class AsyncSharedMutex {
+    inline static constexpr std::uint64_t kWriter = 1;
+    inline static constexpr std::uint64_t kWaiters = 2;
+    inline static constexpr std::uint64_t kReader = 4;
+
+public:
+    AsyncSharedMutex() noexcept
+        : _state{0}
+        , _lock{}
+        , _waiters{}
+    {}
+
+    AsyncSharedMutex& operator=(AsyncSharedMutex&&) noexcept = delete;
+
+private:
+    struct Waiter : internal::AsyncWaiter {
+        Waiter(EventLoop* loop, bool isShared) noexcept
+            : AsyncWaiter{loop}
+            , _isShared{isShared}
+        {}
+
+        bool _isShared;
+    };
+
+public:
+    template <bool IsShared>
+    struct LockAwaiter : Waiter {
+        LockAwaiter(AsyncSharedMutex& mtx, EventLoop* loop) noexcept
+            : Waiter{loop, IsShared}
+            , _mtx{mtx}
+        {}
+
+        LockAwaiter& operator=(LockAwaiter&&) noexcept = delete;
+
+        ~LockAwaiter() noexcept {
+            if (this->isPrepared()) {
+                // 放弃等待; 状态字不变, 队列因此为空时由最后离开的持有者复位
+                std::lock_guard _{_mtx._lock};
+                if (_mtx._waiters.erase(this)) {
+                    this->cancelPrepare();
+                }
+            }
+        }
+
+        bool await_ready() noexcept {
+            if constexpr (IsShared) {
+                return _mtx.tryLockShared();
+            } else {
+                return _mtx.tryLock();
+            }
+        }
+
+        bool await_suspend(std::coroutine_handle<> coroutine) {
+            this->prepare(coroutine);
+            {
+                std::lock_guard _{_mtx._lock};
+                auto state = _mtx._state.load(std::memory_order_relaxed);
+                for (;;) {
+                    if (!_mtx._waiters.empty() || !canAcquire(state)) {
+                        // 队列非空时 kWaiters 已置位, 这里的 CAS 只为与持有者的解锁同步
+                        if (_mtx._state.compare_exchange_weak(
+                            state, state | kWaiters,
+                            std::memory_order_release, std::memory_order_relaxed)
+                        ) {
+                            _mtx._waiters.push(this);
+                            return true;
+                        }
+                    } else if (_mtx._state.compare_exchange_weak(
+                        state, IsShared ? state + kReader : kWriter,
+                        std::memory_order_acquire, std::memory_order_relaxed)
+                    ) {
+                        break;
+                    }
+                }
+            }
+            this->cancelPrepare();
+            return false;
+        }
+
+        constexpr void await_resume() const noexcept {}
+
+    private:
+        static constexpr bool canAcquire(std::uint64_t state) noexcept {
+            if constexpr (IsShared) {
+                return !(state & kWriter);
+            } else {
+                return state == 0;
+            }
+        }
+
+        AsyncSharedMutex& _mtx;
+    };
+
+    /**
+     * @brief 尝试加写锁 (不会挂起)
+     */
+    bool tryLock() noexcept {
+        std::uint64_t state = 0;
+        return _state.compare_exchange_strong(
+            state, kWriter, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 尝试加读锁 (不会挂起); 有等待者时失败
+     */
+    bool tryLockShared() noexcept {
+        auto state = _state.load(std::memory_order_relaxed);
+        while (!(state & (kWriter | kWaiters))) {
+            if (_state.compare_exchange_weak(
+                state, state + kReader, std::memory_order_acquire, std::memory_order_relaxed)
+            ) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief 加写锁; 传入 loop 则在 loop 中恢复 (跨事件循环使用)
+     */
+    LockAwaiter<false> lock() noexcept {
+        return {*this, nullptr};
+    }
+
+    LockAwaiter<false> lock(EventLoop& loop) noexcept {
+        return {*this, &loop};
+    }
+
+    /**
+     * @brief 加读锁; 传入 loop 则在 loop 中恢复 (跨事件循环使用)
+     */
+    LockAwaiter<true> lockShared() noexcept {
+        return {*this, nullptr};
+    }
+
+    LockAwaiter<true> lockShared(EventLoop& loop) noexcept {
+        return {*this, &loop};
+    }
+
+    void unlock() {
+        auto state = kWriter;
+        if (_state.compare_exchange_strong(
+            state, 0, std::memory_order_release, std::memory_order_relaxed)
+        ) [[likely]] {
+            return;
+        }
+        wakeWaiters();
+    }
+
+    void unlockShared() {
+        auto state = _state.fetch_sub(kReader, std::memory_order_release) - kReader;
+        if (state == kWaiters) [[unlikely]] {
+            wakeWaiters();
+        }
+    }
+
+private:
+    /**
+     * @brief 最后一个持有者离开且有等待者时调用 (此时只有本函数能修改状态字)
+     */
+    void wakeWaiters() {
+        internal::AsyncWaiter* head;
+        {
+            std::lock_guard _{_lock};
+            head = _waiters.pop();
+            if (!head) [[unlikely]] {
+                // 等待者都已放弃等待
+                _state.store(0, std::memory_order_release);
+                return;
+            }
+            std::uint64_t state;
+            if (isSharedWaiter(head)) {
+                state = kReader;
+                auto* tail = head;
+                while (isSharedWaiter(_waiters.front())) {
+                    tail = tail->_nextWaiter = _waiters.pop();
+                    state += kReader;
+                }
+                tail->_nextWaiter = nullptr;
+            } else {
+                head->_nextWaiter = nullptr;
+                state = kWriter;
+            }
+            if (!_waiters.empty()) {
+                state |= kWaiters;
+            }
+            _state.store(state, std::memory_order_release);
+        }
+        while (head) {
+            auto* next = head->_nextWaiter;
+            head->wake();
+            head = next;
+        }
+    }
+
+    static bool isSharedWaiter(internal::AsyncWaiter* waiter) noexcept {
+        return waiter && static_cast<Waiter*>(waiter)->_isShared;
+    }
+
+    std::atomic<std::uint64_t> _state;
+    internal::SpinLock _lock;
+    internal::WaiterQueue _waiters;
+};
+
+} // namespace HX::coroutine
@@ -0,0 +1,302 @@
+#pragma once
+/*
+ * Copyright Heng_Xin. All rights reserved.
+ *
+ * @Author: Heng_Xin
+ * @Date: 2026-10-17 22:20:45
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *	  https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+#include <HXLibs/coroutine/sync/_AsyncWaiter.hpp>
+
+namespace HX::coroutine {
+
+/**
+ * @brief 有界通道 (多生产者多消费者): 缓冲区满时 send 挂起 (背压), 为空时 recv 挂起
+ * @note 缓冲区在构造时一次分配; 等待中的发送者/接收者是协程帧中的侵入式节点, 不分配内存.
+ *       有等待的接收者时, send 直接把值交给它; 缓冲区满且有等待的发送者时, recv 取走队首后把发送者的值补入.
+ *       容量为 0 时, 每次 send 都要等到一个 recv 与之会合.
+ *       状态由自旋锁保护, 临界区只有几次移动, 协程总在锁外恢复.
+ *       可以放弃等待: `co_await whenAny(ch.recv(), timer)` 中超时先完成时, 接收者出队, 不会丢失数据.
+ * @tparam T
+ */
+template <typename T>
+class Channel {
+public:
+    explicit Channel(std::size_t capacity)
+        : _buf{std::make_unique<std::optional<T>[]>(capacity ? capacity : 1)}
+        , _capacity{capacity}
+        , _head{0}
+        , _size{0}
+        , _closed{false}
+        , _lock{}
+        , _senders{}
+        , _receivers{}
+    {}
+
+    Channel& operator=(Channel&&) noexcept = delete;
+
+    struct SendAwaiter : internal::AsyncWaiter {
+        SendAwaiter(Channel& ch, T&& value, EventLoop* loop)
+            : AsyncWaiter{loop}
+            , _ch{ch}
+            , _value{std::move(value)}
+            , _ok{false}
+        {}
+
+        SendAwaiter& operator=(SendAwaiter&&) noexcept = delete;
+
+        ~SendAwaiter() noexcept {
+            if (isPrepared()) {
+                // 放弃等待: 值未被取走, 随 awaiter 一并丢弃
+                std::lock_guard _{_ch._lock};
+                if (_ch._senders.erase(this)) {
+                    cancelPrepare();
+                }
+            }
+        }
+
+        constexpr bool await_ready() const noexcept { return false; }
+
+        bool await_suspend(std::coroutine_handle<> coroutine) {
+            prepare(coroutine);
+            RecvAwaiter* receiver = nullptr;
+            {
+                std::lock_guard _{_ch._lock};
+                if (_ch._closed) {
+                    _ok = false;
+                } else if ((receiver = static_cast<RecvAwaiter*>(_ch._receivers.pop()))) {
+                    receiver->_value.emplace(std::move(_value));
+                    _ok = true;
+                } else if (_ch._size < _ch._capacity) {
+                    _ch.pushBuf(std::move(_value));
+                    _ok = true;
+                } else {
+                    _ch._senders.push(this);
+                    return true;
+                }
+            }
+            cancelPrepare();
+            if (receiver) {
+                receiver->wake();
+            }
+            return false;
+        }
+
+        /**
+         * @return true 已发送
+         * @return false 通道已关闭
+         */
+        bool await_resume() const noexcept {
+            return _ok;
+        }
+
+    private:
+        friend Channel;
+        Channel& _ch;
+        T _value;
+        bool _ok;
+    };
+
+    struct RecvAwaiter : internal::AsyncWaiter {
+        RecvAwaiter(Channel& ch, EventLoop* loop) noexcept
+            : AsyncWaiter{loop}
+            , _ch{ch}
+            , _value{}
+        {}
+
+        RecvAwaiter& operator=(RecvAwaiter&&) noexcept = delete;
+
+        ~RecvAwaiter() noexcept {
+            if (isPrepared()) {
+                // 放弃等待: 之后的 send 不会再把值交给它
+                std::lock_guard _{_ch._lock};
+                if (_ch._receivers.erase(this)) {
+                    cancelPrepare();
+                }
+            }
+        }
+
+        constexpr bool await_ready() const noexcept { return false; }
+
+        bool await_suspend(std::coroutine_handle<> coroutine) {
+            prepare(coroutine);
+            SendAwaiter* sender = nullptr;
+            {
+                std::lock_guard _{_ch._lock};
+                if (_ch._size) {
+                    _value.emplace(_ch.popBuf());
+                    if ((sender = static_cast<SendAwaiter*>(_ch._senders.pop()))) {
+                        _ch.pushBuf(std::move(sender->_value));
+                        sender->_ok = true;
+                    }
+                } else if ((sender = static_cast<SendAwaiter*>(_ch._senders.pop()))) {
+                    _value.emplace(std::move(sender->_value));
+                    sender->_ok = true;
+                } else if (!_ch._closed) {
+                    _ch._receivers.push(this);
+                    return true;
+                }
+            }
+            cancelPrepare();
+            if (sender) {
+                sender->wake();
+            }
+            return false;
+        }
+
+        /**
+         * @return std::optional<T> 通道已关闭且没有剩余数据时为 std::nullopt
+         */
+        std::optional<T> await_resume() noexcept(std::is_nothrow_move_constructible_v<T>) {
+            return std::move(_value);
+        }
+
+    private:
+        friend Channel;
+        Channel& _ch;
+        std::optional<T> _value;
+    };
+
+    /**
+     * @brief 发送, 缓冲区满时挂起直到有空位; 传入 loop 则在 loop 中恢复 (跨事件循环使用)
+     * @return SendAwaiter `co_await` 得到 bool, false 表示通道已关闭
+     */
+    SendAwaiter send(T value) {
+        return {*this, std::move(value), nullptr};
+    }
+
+    SendAwaiter send(T value, EventLoop& loop) {
+        return {*this, std::move(value), &loop};
+    }
+
+    /**
+     * @brief 接收, 没有数据时挂起; 传入 loop 则在 loop 中恢复 (跨事件循环使用)
+     * @return RecvAwaiter `co_await` 得到 std::optional<T>, 为空表示通道已关闭且已读完
+     */
+    RecvAwaiter recv() noexcept {
+        return {*this, nullptr};
+    }
+
+    RecvAwaiter recv(EventLoop& loop) noexcept {
+        return {*this, &loop};
+    }
+
+    /**
+     * @brief 尝试发送 (不会挂起)
+     * @return true 已发送 (交给了等待的接收者或放入缓冲区)
+     */
+    bool trySend(T& value) {
+        RecvAwaiter* receiver;
+        {
+            std::lock_guard _{_lock};
+            if (_closed) {
+                return false;
+            }
+            if (!(receiver = static_cast<RecvAwaiter*>(_receivers.pop()))) {
+                if (_size == _capacity) {
+                    return false;
+                }
+                pushBuf(std::move(value));
+                return true;
+            }
+            receiver->_value.emplace(std::move(value));
+        }
+        receiver->wake();
+        return true;
+    }
+
+    /**
+     * @brief 尝试接收 (不会挂起)
+     */
+    std::optional<T> tryRecv() {
+        std::optional<T> res;
+        SendAwaiter* sender;
+        {
+            std::lock_guard _{_lock};
+            if (_size) {
+                res.emplace(popBuf());
+                if ((sender = static_cast<SendAwaiter*>(_senders.pop()))) {
+                    pushBuf(std::move(sender->_value));
+                }
+            } else if ((sender = static_cast<SendAwaiter*>(_senders.pop()))) {
+                res.emplace(std::move(sender->_value));
+            }
+            if (sender) {
+                sender->_ok = true;
+            }
+        }
+        if (sender) {
+            sender->wake();
+        }
+        return res;
+    }
+
+    /**
+     * @brief 关闭通道: 之后的 send 失败, 等待中的发送者得到 false;
+     *        接收者读完缓冲区后得到 std::nullopt
+     */
+    void close() {
+        internal::AsyncWaiter* senders;
+        internal::AsyncWaiter* receivers;
+        {
+            std::lock_guard _{_lock};
+            _closed = true;
+            senders = _senders.popAll();
+            receivers = _receivers.popAll(); // 有等待的接收者时缓冲区必为空
+        }
+        for (auto* list : {senders, receivers}) {
+            while (list) {
+                auto* next = list->_nextWaiter;
+                list->wake();
+                list = next;
+            }
+        }
+    }
+
+    std::size_t capacity() const noexcept {
+        return _capacity;
+    }
+
+private:
+    void pushBuf(T&& value) {
+        _buf[(_head + _size) % _capacity].emplace(std::move(value));
+        ++_size;
+    }
+
+    T popBuf() {
+        auto& slot = _buf[_head];
+        T res = std::move(*slot);
+        slot.reset();
+        _head = (_head + 1) % _capacity;
+        --_size;
+        return res;
+    }
+
+    std::unique_ptr<std::optional<T>[]> _buf;
+    std::size_t _capacity;
+    std::size_t _head;
+    std::size_t _size;
+    bool _closed;
+    internal::SpinLock _lock;
+    internal::WaiterQueue _senders;
+    internal::WaiterQueue _receivers;
+};
+
+} // namespace HX::coroutine
@@ -0,0 +1,206 @@
+#pragma once
+/*
+ * Copyright Heng_Xin. All rights reserved.
+ *
+ * @Author: Heng_Xin
+ * @Date: 2026-10-17 22:20:45
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *	  https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <coroutine>
+#include <optional>
+#include <thread>
+#include <utility>
+
+#include <HXLibs/coroutine/loop/EventLoop.hpp>
+
+namespace HX::coroutine::internal {
+
+/**
+ * @brief 协程同步原语的等待者 (位于 awaiter 中, 即协程帧中, 等待时不分配内存)
+ * @note loop 为 nullptr 时, 由唤醒方所在线程直接恢复 (同一事件循环内使用);
+ *       否则投递到 loop 中恢复, 并在等待期间让 loop 保持运行 (跨事件循环使用).
+ *       awaiter 在被唤醒前析构 (如 whenAny 中落败) 时, 由其析构函数从等待队列中移除.
+ * @warning 跨事件循环使用时, 被唤醒之后 (投递尚未执行) 不能再析构 awaiter
+ */
+struct AsyncWaiter : PostNode {
+    explicit AsyncWaiter(EventLoop* loop) noexcept
+        : PostNode{nullptr, &AsyncWaiter::invoke}
+        , _nextWaiter{nullptr}
+        , _prevWaiter{nullptr}
+        , _isQueued{false}
+        , _loop{loop}
+        , _coroutine{}
+        , _keepAlive{}
+    {}
+
+    AsyncWaiter& operator=(AsyncWaiter&&) noexcept = delete;
+
+    /**
+     * @brief 挂起前调用 (之后随时可能被唤醒)
+     */
+    void prepare(std::coroutine_handle<> coroutine) noexcept {
+        _coroutine = coroutine;
+        if (_loop) {
+            _keepAlive.emplace(_loop->makeTheradTask());
+        }
+    }
+
+    /**
+     * @brief prepare 之后没有挂起 (直接获取成功)
+     */
+    void cancelPrepare() noexcept {
+        _coroutine = {};
+        if (_keepAlive) {
+            _keepAlive->notify();
+            _keepAlive.reset();
+        }
+    }
+
+    /**
+     * @brief 唤醒等待者 (任意线程)
+     * @warning 之后 *this 可能已被销毁
+     */
+    void wake() {
+        if (auto* loop = _loop) {
+            loop->postNode(this);
+        } else {
+            _coroutine.resume();
+        }
+    }
+
+    /**
+     * @brief 是否调用过 prepare 且没有取消, 即可能仍在等待队列中 (仅等待者自身的线程访问)
+     */
+    bool isPrepared() const noexcept {
+        return static_cast<bool>(_coroutine);
+    }
+
+    AsyncWaiter* _nextWaiter;
+    AsyncWaiter* _prevWaiter; // 仅 WaiterQueue 使用
+    bool _isQueued;           // 是否仍在 WaiterQueue 中 (由其锁保护)
+
+private:
+    static void invoke(PostNode* node, bool isRun) {
+        if (isRun) {
+            auto* self = static_cast<AsyncWaiter*>(node);
+            self->_keepAlive->notify();
+            self->_coroutine.resume();
+        }
+    }
+
+    EventLoop* _loop;
+    std::coroutine_handle<> _coroutine;
+    std::optional<decltype(std::declval<EventLoop&>().makeTheradTask())> _keepAlive;
+};
+
+/**
+ * @brief 侵入式 FIFO 等待队列 (双向链表, 不加锁, 由使用者保护)
+ * @note 等待者放弃等待 (awaiter 在被唤醒前析构, 如 whenAny 中落败) 时以 O(1) 的 erase 出队
+ */
+struct WaiterQueue {
+    bool empty() const noexcept {
+        return !_head;
+    }
+
+    AsyncWaiter* front() const noexcept {
+        return _head;
+    }
+
+    void push(AsyncWaiter* waiter) noexcept {
+        waiter->_nextWaiter = nullptr;
+        waiter->_prevWaiter = _tail;
+        waiter->_isQueued = true;
+        if (_tail) {
+            _tail->_nextWaiter = waiter;
+        } else {
+            _head = waiter;
+        }
+        _tail = waiter;
+    }
+
+    AsyncWaiter* pop() noexcept {
+        auto* waiter = _head;
+        if (waiter) {
+            _head = waiter->_nextWaiter;
+            if (_head) {
+                _head->_prevWaiter = nullptr;
+            } else {
+                _tail = nullptr;
+            }
+            waiter->_isQueued = false;
+        }
+        return waiter;
+    }
+
+    /**
+     * @brief 移除仍在队列中的等待者
+     * @return true 已移除; false 不在队列中 (已被取走)
+     */
+    bool erase(AsyncWaiter* waiter) noexcept {
+        if (!waiter->_isQueued) {
+            return false;
+        }
+        if (waiter->_prevWaiter) {
+            waiter->_prevWaiter->_nextWaiter = waiter->_nextWaiter;
+        } else {
+            _head = waiter->_nextWaiter;
+        }
+        if (waiter->_nextWaiter) {
+            waiter->_nextWaiter->_prevWaiter = waiter->_prevWaiter;
+        } else {
+            _tail = waiter->_prevWaiter;
+        }
+        waiter->_isQueued = false;
+        return true;
+    }
+
+    /**
+     * @brief 取走全部等待者, 返回链表头 (经 `_nextWaiter` 串联)
+     */
+    AsyncWaiter* popAll() noexcept {
+        for (auto* waiter = _head; waiter; waiter = waiter->_nextWaiter) {
+            waiter->_isQueued = false;
+        }
+        _tail = nullptr;
+        return std::exchange(_head, nullptr);
+    }
+
+private:
+    AsyncWaiter* _head{nullptr};
+    AsyncWaiter* _tail{nullptr};
+};
+
+/**
+ * @brief 极短临界区使用的自旋锁 (只保护等待队列的出入队, 其中不会恢复协程)
+ */
+struct SpinLock {
+    void lock() noexcept {
+        while (_flag.exchange(true, std::memory_order_acquire)) [[unlikely]] {
+            while (_flag.load(std::memory_order_relaxed)) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void unlock() noexcept {
+        _flag.store(false, std::memory_order_release);
+    }
+
+private:
+    std::atomic_bool _flag{false};
+};
+
+} // namespace HX::coroutine::internal
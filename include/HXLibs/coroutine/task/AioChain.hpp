@@ -0,0 +1,164 @@
+#pragma once
+/*
+ * Copyright Heng_Xin. All rights reserved.
+ *
+ * @Author: Heng_Xin
+ * @Date: 2026-10-17 15:08:26
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *	  https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <coroutine>
+#include <stdexcept>
+
+#include <HXLibs/coroutine/task/AioTask.hpp>
+
+#if defined(__linux__)
+
+namespace HX::coroutine {
+
+namespace internal {
+
+/**
+ * @brief 链式任务的 user_data 标记位 (与 kMultishotTag 互斥)
+ */
+inline constexpr std::uint64_t kChainTag = 2;
+
+struct AioChainState {
+    std::size_t _remaining;             // 尚未完成的 SQE 数
+    std::coroutine_handle<> _previous;  // 等待整条链的协程
+};
+
+/**
+ * @brief 链中每个 SQE 的完成槽位, 其地址 (| kChainTag) 作为 user_data
+ */
+struct AioChainSlot {
+    /**
+     * @brief 投递一个完成事件
+     * @note 链中前面的操作失败 (或读写不足) 时, 后续操作会以 -ECANCELED 完成, 同样需要计数
+     * @param res cqe->res
+     * @param flags cqe->flags
+     * @return std::coroutine_handle<> 整条链都完成后, 需要恢复的协程 (否则为空)
+     */
+    std::coroutine_handle<> complete(int res, unsigned int flags) noexcept {
+        if (flags & IORING_CQE_F_NOTIF) {
+            // 零拷贝发送的通知, 结果已在第一个 CQE 中保存
+        } else {
+            _res = res;
+            if (flags & IORING_CQE_F_MORE) {
+                return {};
+            }
+        }
+        return --_state->_remaining ? std::coroutine_handle<>{} : _state->_previous;
+    }
+
+    AioChainState* _state;
+    int _res;
+};
+
+} // namespace internal
+
+/**
+ * @brief 链式异步任务: 多个 SQE 以 IOSQE_IO_LINK 链接, 一次提交, 内核按顺序执行,
+ *        整条链都完成后只恢复一次协程, 并返回每一步的结果
+ * @note 需要通过 `EventLoop::makeAioChain<N>()` 创建 (会预留 N 个 SQE, 保证整条链在同一批中提交),
+ *       并在同一个表达式中依次 `add`, 之间不能再创建其他的 AioTask:
+ * @code
+ * auto [openRes, readRes, closeRes] = co_await eventLoop.makeAioChain<3>()
+ *     .add(eventLoop.makeAioTask().prepOpenatDirect(AT_FDCWD, path, O_RDONLY, 0, 0))
+ *     .add(eventLoop.makeAioTask().prepRead(0, buf, size, 0).setFixedFile())
+ *     .add(eventLoop.makeAioTask().prepCloseDirect(0));
+ * @endcode
+ *       某一步失败 (读写的字节数不足也视为失败) 后, 其后的步骤的结果为 -ECANCELED, 需要自行清理;
+ *       普通 fd 无法在链中传递, 因此 openat 需要使用 `prepOpenatDirect` 打开到注册文件表的指定槽位.
+ * @tparam N 链的长度
+ */
+template <std::size_t N>
+struct AioChain {
+    static_assert(N > 0, "AioChain: N must be greater than 0");
+
+    AioChain() noexcept
+        : _state{}
+        , _slots{}
+        , _lastSqe{nullptr}
+        , _size{0}
+    {
+        for (auto& slot : _slots) {
+            slot._state = &_state;
+            slot._res = -ENOSYS;
+        }
+    }
+
+    AioChain& operator=(AioChain&&) noexcept = delete;
+
+    /**
+     * @brief 将任务追加到链的末尾
+     * @param task prepXxx 之后的任务
+     * @return AioChain&&
+     */
+    [[nodiscard]] AioChain&& add(AioTask&& task) && {
+        if (_size == N) [[unlikely]] {
+            throw std::logic_error{"AioChain: too many tasks"};
+        }
+        if (_lastSqe) {
+            _lastSqe->flags |= IOSQE_IO_LINK;
+        }
+        _lastSqe = task._sqe;
+        task._tracker = nullptr; // SQE 的完成事件归链所有
+        ::io_uring_sqe_set_data64(
+            _lastSqe,
+            reinterpret_cast<std::uint64_t>(&_slots[_size]) | internal::kChainTag);
+        ++_size;
+        return std::move(*this);
+    }
+
+    struct AioChainAwaiter {
+        constexpr bool await_ready() const noexcept { return !_chain->_size; }
+
+        void await_suspend(std::coroutine_handle<> coroutine) const noexcept {
+            _chain->_state._remaining = _chain->_size;
+            _chain->_state._previous = coroutine;
+        }
+
+        /**
+         * @brief 获取每一步的结果 (cqe->res), 未 add 的位置为 -ENOSYS
+         * @return std::array<int, N>
+         */
+        std::array<int, N> await_resume() const noexcept {
+            std::array<int, N> res;
+            for (std::size_t i = 0; i < N; ++i) {
+                res[i] = _chain->_slots[i]._res;
+            }
+            return res;
+        }
+
+        AioChain* _chain;
+    };
+
+    AioChainAwaiter operator co_await() && noexcept {
+        return {this};
+    }
+
+private:
+    internal::AioChainState _state;
+    std::array<internal::AioChainSlot, N> _slots;
+    ::io_uring_sqe* _lastSqe;
+    std::size_t _size;
+};
+
+} // namespace HX::coroutine
+
+#endif // defined(__linux__)
@@ -19,10 +19,18 @@
  */
 
 #include <span>
+#include <deque>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <coroutine>
+#include <unordered_set>
 
 #include <HXLibs/platform/EventLoopApi.hpp>
 #include <HXLibs/platform/LocalFdApi.hpp>
 #include <HXLibs/coroutine/awaiter/WhenAny.hpp>
+#include <HXLibs/coroutine/loop/BufRing.hpp>
+#include <HXLibs/coroutine/loop/EventLoopOptions.hpp>
 
 #if defined(__linux__)
 
@@ -32,13 +40,147 @@ namespace internal {
 
 struct IoUring;
 
+/**
+ * @brief 可被主动取消的任务的 user_data 标记位 (与 kMultishotTag / kChainTag 互斥)
+ */
+inline constexpr std::uint64_t kCancelableTag = 4;
+
+/**
+ * @brief AioTask 的 user_data 中序号所在的位置; 用户态地址不超过 48 位, 高 16 位用于存放序号
+ */
+inline constexpr unsigned kAioTaskSeqShift = 48;
+
+/**
+ * @brief 从 AioTask 的 user_data 中取出对象地址
+ */
+inline constexpr std::uint64_t kAioTaskPtrMask
+    = ((std::uint64_t{1} << kAioTaskSeqShift) - 1) & ~kCancelableTag;
+
 } // namespace internal
 
+struct AioTask;
+
+namespace internal {
+
+/**
+ * @brief 待恢复的协程; task 非空表示由该 AioTask 的完成事件产生
+ */
+struct Ready {
+    std::coroutine_handle<> coroutine;
+    AioTask* task;
+};
+
+/**
+ * @brief 某一优先级的恢复队列 (FIFO)
+ * @note 超出恢复预算的协程留到下一轮, 因此已恢复的部分只前进 head, 不立即移除,
+ *       以免 AioTask 记录的 `_readySlot` 失效; 积压过多时再整体前移 (见 IoUring::resumeReady)
+ */
+struct ReadyQueue {
+    bool empty() const noexcept {
+        return head == items.size();
+    }
+
+    std::vector<Ready> items;
+    std::size_t head = 0;
+};
+
+/**
+ * @brief 把队列与下标编码为 AioTask 的 `_readySlot` (0 表示不在恢复队列中)
+ */
+constexpr std::size_t makeReadySlot(ResumePriority priority, std::size_t index) noexcept {
+    return ((index + 1) << 1) | static_cast<std::size_t>(priority);
+}
+
+/**
+ * @brief 记录在内核完成之前就被析构的 AioTask (如 whenAny 中落败的一方), 由 IoUring 持有
+ * @note 析构时 CQE 尚未到达: 按 user_data 提交 IORING_OP_ASYNC_CANCEL, 并记下该 user_data,
+ *       之后到达的 CQE 直接回收, 不会再访问已析构的对象, 其占用的 SQE 名额也随之归还;
+ *       CQE 已到达但协程尚未恢复: 撤销这次恢复.
+ *       user_data 的高位是递增的序号, 因此同一地址上的新任务不会与尚未回收的旧任务混淆.
+ */
+struct AioTaskTracker {
+    AioTaskTracker(
+        std::vector<std::uint64_t>& cancelQueue,
+        ReadyQueue (&ready)[2]
+    ) noexcept
+        : _cancelQueue{cancelQueue}
+        , _ready{ready}
+        , _orphans{}
+        , _seq{0}
+    {}
+
+    AioTaskTracker& operator=(AioTaskTracker&&) noexcept = delete;
+
+    std::uint64_t makeUserData(AioTask const* task) noexcept {
+        return reinterpret_cast<std::uint64_t>(task)
+            | (static_cast<std::uint64_t>(++_seq) << kAioTaskSeqShift);
+    }
+
+    /**
+     * @brief 任务在完成 (或恢复) 之前被析构
+     * @param userData 任务的 user_data
+     * @param readySlot 在恢复队列中的位置 (见 makeReadySlot), 0 表示 CQE 尚未到达
+     */
+    void abandon(std::uint64_t userData, std::size_t readySlot) {
+        if (readySlot) {
+            _ready[readySlot & 1].items[(readySlot >> 1) - 1] = {std::noop_coroutine(), nullptr};
+            return;
+        }
+        _cancelQueue.push_back(userData);
+        _orphans.insert(userData);
+    }
+
+    /**
+     * @brief 若 CQE 属于已析构的任务, 则回收之
+     * @param userData cqe->user_data
+     * @param more 是否还会有后续的 CQE (IORING_CQE_F_MORE)
+     * @return true 已回收, 调用方不应再访问该任务
+     */
+    bool reap(std::uint64_t userData, bool more) {
+        if (_orphans.empty()) [[likely]] {
+            return false;
+        }
+        auto it = _orphans.find(userData);
+        if (it == _orphans.end()) {
+            return false;
+        }
+        if (!more) {
+            _orphans.erase(it);
+        }
+        return true;
+    }
+
+    /**
+     * @brief 已析构但 CQE 尚未到达的任务数
+     */
+    std::size_t orphans() const noexcept {
+        return _orphans.size();
+    }
+
+private:
+    std::vector<std::uint64_t>& _cancelQueue;
+    ReadyQueue (&_ready)[2];
+    std::unordered_set<std::uint64_t> _orphans;
+    std::uint16_t _seq;
+};
+
+} // namespace internal
+
+template <std::size_t N>
+struct AioChain;
+
 struct AioTask {
-    AioTask(::io_uring_sqe* sqe) noexcept
+    AioTask(
+        ::io_uring_sqe* sqe,
+        internal::AioTaskTracker& tracker,
+        ResumePriority priority = ResumePriority::Latency
+    ) noexcept
         : _sqe{sqe}
+        , _userData{tracker.makeUserData(this)}
+        , _tracker{&tracker}
+        , _priority{priority}
     {
-        ::io_uring_sqe_set_data(_sqe, this);
+        ::io_uring_sqe_set_data64(_sqe, _userData);
     }
 
 #if 0 // 注意: 不能存在`移动`, 否则 IoUring::makeAioTask 返回就是 构造的新对象; 屏蔽了移动, 反而是编译器优化!
@@ -67,14 +209,29 @@ struct AioTask {
         return {this};
     }
 
+    /**
+     * @brief 获取完成事件的 flags (如 IORING_CQE_F_BUFFER), 需要在 co_await 之后调用
+     * @return unsigned int cqe->flags
+     */
+    unsigned int cqeFlags() const noexcept {
+        return _cqeFlags;
+    }
+
 private:
     friend internal::IoUring;
+    template <std::size_t N>
+    friend struct AioChain;
 
     union {
         int _res;
         ::io_uring_sqe* _sqe;
     };
     std::coroutine_handle<> _previous;
+    unsigned int _cqeFlags{};
+    std::uint64_t _userData;            // 地址 | 标记 | 序号
+    internal::AioTaskTracker* _tracker; // 内核仍持有该任务, 或其协程尚待恢复时非空
+    std::size_t _readySlot{};           // 待恢复时在恢复队列中的位置 (见 internal::makeReadySlot)
+    ResumePriority _priority;           // 完成后进入哪一个恢复队列
 
 public:
     /**
@@ -95,6 +252,47 @@ public:
         return std::move(*this);
     }
 
+    /**
+     * @brief 异步打开文件到注册文件表的指定槽位
+     * @note 之后的操作以 fileIndex 作为 fd 并 `setFixedFile()`, 因此可以与 openat 链接在同一条链中
+     * @param dirfd 目录文件描述符, `AT_FDCWD` 则表示相对于当前工作目录
+     * @param path 文件路径
+     * @param flags 指定文件打开的方式, 比如 `O_RDONLY`
+     * @param mode 文件权限模式, 仅在文件创建时有效 (一般写`0644`)
+     * @param fileIndex 注册文件表的下标 (该槽位不能同时被 IORING_FILE_INDEX_ALLOC 分配)
+     * @return AioTask&& 
+     */
+    [[nodiscard]] AioTask&& prepOpenatDirect(
+        int dirfd, 
+        char const* path, 
+        int flags,
+        platform::ModeType mode,
+        unsigned int fileIndex
+    ) && {
+        ::io_uring_prep_openat_direct(_sqe, dirfd, path, flags, mode, fileIndex);
+        return std::move(*this);
+    }
+
+    /**
+     * @brief 异步获取文件信息
+     * @param dirfd 目录文件描述符, `AT_FDCWD` 则表示相对于当前工作目录
+     * @param path 文件路径
+     * @param flags 如 `AT_SYMLINK_NOFOLLOW`
+     * @param mask 需要获取的字段, 如 `STATX_SIZE`
+     * @param statxbuf [out] 文件信息
+     * @return AioTask&& 
+     */
+    [[nodiscard]] AioTask&& prepStatx(
+        int dirfd, 
+        char const* path, 
+        int flags,
+        unsigned int mask,
+        struct ::statx* statxbuf
+    ) && {
+        ::io_uring_prep_statx(_sqe, dirfd, path, flags, mask, statxbuf);
+        return std::move(*this);
+    }
+
     /**
      * @brief 异步创建一个套接字
      * @param domain 指定 socket 的协议族 (AF_INET(ipv4)/AF_INET6(ipv6)/AF_UNIX/AF_LOCAL(本地))
@@ -131,6 +329,25 @@ public:
         return std::move(*this);
     }
 
+    /**
+     * @brief 异步建立连接, 并直接安装到注册文件表 (槽位由内核分配)
+     * @warning 返回的是注册文件表的下标, 而不是 fd
+     * @param fd 服务端套接字
+     * @param addr [out] 客户端信息
+     * @param addrlen [out] 客户端信息长度指针
+     * @param flags 
+     * @return AioTask&& 
+     */
+    [[nodiscard]] AioTask&& prepAcceptDirect(
+        int fd, 
+        struct ::sockaddr *addr, 
+        ::socklen_t *addrlen,
+        int flags
+    ) && {
+        ::io_uring_prep_accept_direct(_sqe, fd, addr, addrlen, flags, IORING_FILE_INDEX_ALLOC);
+        return std::move(*this);
+    }
+
     /**
      * @brief 异步的向服务端创建连接
      * @param fd 客户端套接字
@@ -213,6 +430,26 @@ public:
         return std::move(*this);
     }
 
+    /**
+     * @brief 异步读取网络套接字文件, 由内核在数据到达时从提供缓冲区环中挑选缓冲区
+     * @note 完成后通过 `cqeFlags() >> IORING_CQE_BUFFER_SHIFT` 获取缓冲区 id;
+     *       缓冲区环被借空时返回 `-ENOBUFS`
+     * @param fd 文件描述符
+     * @param group 缓冲区组 id
+     * @param flags 
+     * @return AioTask&& 
+     */
+    [[nodiscard]] AioTask&& prepRecvProvided(
+        int fd,
+        unsigned short group,
+        int flags
+    ) && {
+        ::io_uring_prep_recv(_sqe, fd, nullptr, 0, flags);
+        _sqe->flags |= IOSQE_BUFFER_SELECT;
+        _sqe->buf_group = group;
+        return std::move(*this);
+    }
+
     /**
      * @brief 异步写入网络套接字文件
      * @param fd 文件描述符
@@ -229,6 +466,40 @@ public:
         return std::move(*this);
     }
 
+    /**
+     * @brief 零拷贝写入网络套接字文件 (IORING_OP_SEND_ZC), 内核直接引用 buf 的页, 不再复制到套接字缓冲区
+     * @note 会产生两个 CQE: 结果 (IORING_CQE_F_MORE) 与 通知 (IORING_CQE_F_NOTIF);
+     *       事件循环在通知到达后才恢复协程, 因此 co_await 返回后即可释放 buf
+     * @param fd 文件描述符
+     * @param buf [in] 写入的数据
+     * @param flags 
+     * @return AioTask&& 
+     */
+    [[nodiscard]] AioTask&& prepSendZc(
+        int fd, 
+        std::span<char const> buf, 
+        int flags
+    ) && {
+        ::io_uring_prep_send_zc(_sqe, fd, buf.data(), buf.size(), flags, 0);
+        return std::move(*this);
+    }
+
+    /**
+     * @brief 分散写入网络套接字文件 (一次写入 msg 中的多个缓冲区)
+     * @param fd 文件描述符
+     * @param msg [in] 待写入的缓冲区; 需要存活至 co_await 返回
+     * @param flags
+     * @return AioTask&&
+     */
+    [[nodiscard]] AioTask&& prepSendmsg(
+        int fd,
+        ::msghdr const* msg,
+        int flags
+    ) && {
+        ::io_uring_prep_sendmsg(_sqe, fd, msg, static_cast<unsigned int>(flags));
+        return std::move(*this);
+    }
+
     /**
      * @brief 异步关闭文件
      * @param fd 文件描述符
@@ -239,6 +510,40 @@ public:
         return std::move(*this);
     }
 
+    /**
+     * @brief 异步关闭注册文件表中的文件, 并释放其槽位
+     * @param fileIndex 注册文件表的下标
+     * @return AioTask&& 
+     */
+    [[nodiscard]] AioTask&& prepCloseDirect(unsigned int fileIndex) && {
+        ::io_uring_prep_close_direct(_sqe, fileIndex);
+        return std::move(*this);
+    }
+
+    /**
+     * @brief 将 prepXxx 传入的 fd 视为注册文件表的下标 (IOSQE_FIXED_FILE)
+     * @warning 需要在 prepXxx 之后调用 (prepXxx 会重置 sqe 的 flags)
+     * @param isFixedFile 是否为注册文件表的下标
+     * @return AioTask&& 
+     */
+    [[nodiscard]] AioTask&& setFixedFile(bool isFixedFile = true) && {
+        if (isFixedFile) {
+            _sqe->flags |= IOSQE_FIXED_FILE;
+        }
+        return std::move(*this);
+    }
+
+    /**
+     * @brief 允许该任务被 `IoUring::cancel` 主动取消, 取消后仍会恢复协程, 结果为 -ECANCELED
+     * @note 默认情况下被取消的 CQE 会被忽略 (whenAny / 链接超时中落败的一方已经没有等待者)
+     * @return AioTask&& 
+     */
+    [[nodiscard]] AioTask&& setCancelable() && {
+        _userData |= internal::kCancelableTag;
+        ::io_uring_sqe_set_data64(_sqe, _userData);
+        return std::move(*this);
+    }
+
     /**
      * @brief 监测一个fd的pool事件
      * @param fd 需要监测的fd
@@ -272,6 +577,7 @@ public:
      * @param task 任务
      * @param timeoutTask `prepLinkTimeout`的返回值
      * @return auto 
+     * @note 内核会取消落败的一方; 若其 CQE 在 whenAny 返回时仍未到达, 析构时还会显式取消并回收
      */
     [[nodiscard]] inline static auto linkTimeout(
         AioTask&& task, AioTask&& timeoutTask
@@ -280,7 +586,256 @@ public:
         return whenAny(std::move(task), std::move(timeoutTask));
     }
 
-    ~AioTask() noexcept = default;
+    ~AioTask() noexcept {
+        if (_tracker) [[unlikely]] {
+            // 在完成之前被析构 (如 whenAny 中落败的一方), 取消内核中的操作
+            _tracker->abandon(_userData, _readySlot);
+        }
+    }
+};
+
+namespace internal {
+
+/**
+ * @brief 多发 (multishot) 任务的 user_data 标记位
+ * @note 对象地址至少按 8 字节对齐, 因此可以使用最低位区分普通任务与多发任务
+ */
+inline constexpr std::uint64_t kMultishotTag = 1;
+
+/**
+ * @brief 多发任务的共享状态, 由 MultishotAioTask 持有;
+ *        若任务在内核仍可能投递 CQE 时被析构, 则所有权转交给 IoUring, 在最后一个 CQE 到达时释放
+ */
+struct MultishotState {
+    /**
+     * @brief 投递一个完成事件
+     * @param res cqe->res
+     * @param more 是否还会有后续的 CQE (IORING_CQE_F_MORE)
+     * @return std::coroutine_handle<> 需要恢复的协程 (可能为空)
+     */
+    std::coroutine_handle<> complete(int res, unsigned int flags) {
+        if (!(flags & IORING_CQE_F_MORE)) {
+            _armed = false;
+        }
+        if (_detached) [[unlikely]] {
+            drop({res, flags});
+            if (!_armed) {
+                delete this;
+            }
+            return {};
+        }
+        _results.push_back({res, flags});
+        return std::exchange(_previous, {});
+    }
+
+    struct Result {
+        int res;
+        unsigned int flags; // cqe->flags
+    };
+
+    void drop(Result result) noexcept {
+        if (_drop && result.res >= 0) {
+            _drop(_dropCtx, result.res, result.flags);
+        }
+    }
+
+    std::deque<Result> _results{};          // 尚未被消费的结果
+    std::coroutine_handle<> _previous{};    // 等待结果的协程
+    unsigned int _lastFlags{};              // 最近一次被消费的结果的 cqe->flags
+    // 无人消费时, 如何释放结果 (如关闭 fd, 归还缓冲区)
+    void (*_drop)(void* ctx, int res, unsigned int flags) noexcept = nullptr;
+    void* _dropCtx = nullptr;
+    bool _armed = true;                     // 内核是否还会投递 CQE
+    bool _detached = false;                 // 任务对象已析构
+};
+
+} // namespace internal
+
+/**
+ * @brief 多发异步任务: 一个 SQE 对应多个 CQE, 由同一个长生命周期的协程依次 co_await 获取
+ * @note 与 AioTask 不同, 该对象需要在整个使用期间保持存活, 因此 prepXxx 为左值方法.
+ *       析构时若内核仍会投递 CQE, 会自动提交取消请求, 并释放未被消费的结果.
+ */
+struct MultishotAioTask {
+    MultishotAioTask(
+        ::io_uring_sqe* sqe,
+        std::vector<std::uint64_t>& cancelQueue,
+        std::vector<unsigned int>& closeQueue
+    )
+        : _sqe{sqe}
+        , _state{new internal::MultishotState{}}
+        , _cancelQueue{cancelQueue}
+        , _closeQueue{closeQueue}
+    {
+        ::io_uring_sqe_set_data64(_sqe, userData());
+    }
+
+    MultishotAioTask& operator=(MultishotAioTask&&) noexcept = delete;
+
+    struct MultishotAwaiter {
+        explicit MultishotAwaiter(internal::MultishotState* state) noexcept
+            : _state{state}
+        {}
+
+        MultishotAwaiter& operator=(MultishotAwaiter&&) noexcept = delete;
+
+        bool await_ready() const noexcept {
+            return !_state->_results.empty() || !_state->_armed;
+        }
+        void await_suspend(std::coroutine_handle<> coroutine) noexcept {
+            _state->_previous = coroutine;
+            _isWaiting = true;
+        }
+        int await_resume() noexcept {
+            _isWaiting = false;
+            if (_state->_results.empty()) [[unlikely]] {
+                _state->_lastFlags = 0;
+                return -ECANCELED; // 已经不会再有结果了
+            }
+            auto [res, flags] = _state->_results.front();
+            _state->_results.pop_front();
+            _state->_lastFlags = flags;
+            return res;
+        }
+        ~MultishotAwaiter() noexcept {
+            if (_isWaiting) {
+                // 等待中被销毁 (如 whenAny 中超时先完成), 结果留给下一次 co_await
+                _state->_previous = {};
+            }
+        }
+    private:
+        internal::MultishotState* _state;
+        bool _isWaiting = false;
+    };
+
+    MultishotAwaiter operator co_await() noexcept {
+        return MultishotAwaiter{_state};
+    }
+
+    /**
+     * @brief 获取最近一次 co_await 得到的结果的 cqe->flags (如 IORING_CQE_F_BUFFER)
+     * @return unsigned int
+     */
+    unsigned int cqeFlags() const noexcept {
+        return _state->_lastFlags;
+    }
+
+    /**
+     * @brief 是否有尚未被消费的结果 (此时 co_await 不会挂起)
+     */
+    bool hasResult() const noexcept {
+        return !_state->_results.empty();
+    }
+
+    /**
+     * @brief 是否还能 co_await 到结果 (有未消费的结果, 或者内核还会继续投递)
+     * @note 为 false 时, 说明内核已经终止了该多发请求, 需要重新提交
+     */
+    bool hasMore() const noexcept {
+        return _state->_armed || !_state->_results.empty();
+    }
+
+    /**
+     * @brief 多发异步建立连接, 每有一个新连接就产生一个 CQE
+     * @param fd 服务端套接字
+     * @param addr [out] 客户端信息
+     * @param addrlen [out] 客户端信息长度指针
+     * @param flags 
+     * @return MultishotAioTask& 
+     */
+    MultishotAioTask& prepMultishotAccept(
+        int fd,
+        struct ::sockaddr* addr,
+        ::socklen_t* addrlen,
+        int flags
+    ) & {
+        ::io_uring_prep_multishot_accept(_sqe, fd, addr, addrlen, flags);
+        ::io_uring_sqe_set_data64(_sqe, userData());
+        _state->_drop = [](void*, int res, unsigned int) noexcept { ::close(res); };
+        return *this;
+    }
+
+    /**
+     * @brief 多发异步建立连接, 并直接安装到注册文件表 (direct descriptor) 中
+     * @warning 需要事件循环已经注册了文件表 (`EventLoopOptions::fixedFiles`),
+     *          返回的是文件表的下标, 需配合 IOSQE_FIXED_FILE 使用, 不能用于普通系统调用
+     * @param fd 服务端套接字
+     * @param addr [out] 客户端信息
+     * @param addrlen [out] 客户端信息长度指针
+     * @param flags 
+     * @return MultishotAioTask& 
+     */
+    MultishotAioTask& prepMultishotAcceptDirect(
+        int fd,
+        struct ::sockaddr* addr,
+        ::socklen_t* addrlen,
+        int flags
+    ) & {
+        ::io_uring_prep_multishot_accept_direct(_sqe, fd, addr, addrlen, flags);
+        ::io_uring_sqe_set_data64(_sqe, userData());
+        // 无人接管的连接已占用了槽位, 交给事件循环在下一轮 close_direct
+        _state->_drop = [](void* ctx, int res, unsigned int) noexcept {
+            static_cast<std::vector<unsigned int>*>(ctx)->push_back(
+                static_cast<unsigned int>(res));
+        };
+        _state->_dropCtx = &_closeQueue;
+        return *this;
+    }
+
+    /**
+     * @brief 多发读取网络套接字文件, 每次数据到达时由内核从提供缓冲区环中挑选缓冲区, 并产生一个 CQE;
+     *        直到连接断开 (res == 0), 出错, 或者缓冲区环被借空 (-ENOBUFS) 时终止
+     * @note 通过 `cqeFlags() >> IORING_CQE_BUFFER_SHIFT` 获取缓冲区 id, 使用完毕后需要归还给 bufRing
+     * @param fd 文件描述符
+     * @param bufRing 提供缓冲区环
+     * @param isFixedFile fd 是否为注册文件表的下标
+     * @return MultishotAioTask& 
+     */
+    MultishotAioTask& prepMultishotRecv(
+        int fd,
+        BufRing& bufRing,
+        bool isFixedFile = false
+    ) & {
+        ::io_uring_prep_recv_multishot(_sqe, fd, nullptr, 0, 0);
+        ::io_uring_sqe_set_data64(_sqe, userData());
+        _sqe->flags |= IOSQE_BUFFER_SELECT;
+        if (isFixedFile) {
+            _sqe->flags |= IOSQE_FIXED_FILE;
+        }
+        _sqe->buf_group = bufRing.group();
+        _state->_drop = [](void* ctx, int, unsigned int flags) noexcept {
+            if (flags & IORING_CQE_F_BUFFER) {
+                static_cast<BufRing*>(ctx)->release(
+                    static_cast<unsigned short>(flags >> IORING_CQE_BUFFER_SHIFT));
+            }
+        };
+        _state->_dropCtx = &bufRing;
+        return *this;
+    }
+
+    ~MultishotAioTask() noexcept {
+        for (auto const& res : _state->_results) {
+            _state->drop(res);
+        }
+        _state->_results.clear();
+        if (_state->_armed) {
+            // 交给 IoUring, 在最后一个 CQE (通常是 -ECANCELED) 到达时释放
+            _state->_detached = true;
+            _cancelQueue.push_back(userData());
+        } else {
+            delete _state;
+        }
+    }
+
+private:
+    std::uint64_t userData() const noexcept {
+        return reinterpret_cast<std::uint64_t>(_state) | internal::kMultishotTag;
+    }
+
+    ::io_uring_sqe* _sqe;
+    internal::MultishotState* _state;
+    std::vector<std::uint64_t>& _cancelQueue;
+    std::vector<unsigned int>& _closeQueue;
 };
 
 } // namespace HX::coroutine
@@ -838,6 +1393,14 @@ int WSASend(
         return std::move(*this);
     }
 
+    /**
+     * @brief Windows 下没有注册文件表, 仅为与 Linux 接口统一
+     * @return AioTask&& 
+     */
+    [[nodiscard]] AioTask&& setFixedFile(bool = true) && {
+        return std::move(*this);
+    }
+
     /**
      * @brief 异步关闭文件
      * @param fd 文件描述符
@@ -29,6 +29,7 @@
 #include <HXLibs/container/ThreadPool.hpp>
 #include <HXLibs/meta/ContainerConcepts.hpp>
 #include <HXLibs/utils/TimeNTTP.hpp>
+#include <HXLibs/utils/CpuAffinity.hpp>
 #include <HXLibs/exception/ErrorHandlingTools.hpp>
 
 #include <HXLibs/log/Log.hpp> // debug
@@ -76,6 +77,14 @@ public:
         // 所以, 使用线程池仅需要的是一个任务队列, 和一个任务线程.
         _pool.setFixedThreadNum(1);
         _pool.run<container::ThreadPool::Model::FixedSizeAndNoCheck>();
+        if (_options.cpu >= 0) {
+            // 唯一的工作线程会先执行该任务
+            _pool.addTask([cpu = _options.cpu] {
+                if (!utils::CpuAffinity::pinCurrentThread(cpu)) [[unlikely]] {
+                    log::hxLog.warning("绑核失败, cpu:", cpu);
+                }
+            });
+        }
     }
 
     /**
@@ -58,6 +58,9 @@ template <typename Proxy = NoneProxy>
 struct HttpClientOptions {
     // 代理地址
     ProxyType<Proxy> proxy = {};
+
+    // 内部工作线程绑定的 CPU, -1 则不绑核
+    int cpu = -1;
 };
 
 } // namespace HX::net
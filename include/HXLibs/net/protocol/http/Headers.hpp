@@ -0,0 +1,517 @@
+#pragma once
+/*
+ * Copyright Heng_Xin. All rights reserved.
+ *
+ * @Author: Heng_Xin
+ * @Date: 2026-10-18 14:06:12
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *	  https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <array>
+#include <span>
+#include <memory>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <algorithm>
+#include <functional>
+#include <string_view>
+
+#include <HXLibs/net/protocol/http/Http.hpp>
+
+namespace HX::net {
+
+/**
+ * @brief 常用的请求头 / 响应头, 在 HttpHeaders 中各有一个槽位, 查找时不需要遍历
+ */
+enum class KnownHeader : std::uint8_t {
+    Host,
+    Connection,
+    ContentLength,
+    ContentType,
+    TransferEncoding,
+    Accept,
+    AcceptEncoding,
+    AcceptLanguage,
+    UserAgent,
+    Cookie,
+    Authorization,
+    CacheControl,
+    Upgrade,
+    Origin,
+    Range,
+    IfNoneMatch,
+    IfModifiedSince,
+    Referer,
+    Date,
+    Server,
+    SetCookie,
+    Location,
+    ETag,
+    LastModified,
+    ContentEncoding,
+    SecWebSocketKey,
+    SecWebSocketAccept,
+    SecWebSocketVersion,
+    Unknown,    // 不是常用的 (只能遍历查找)
+};
+
+namespace internal {
+
+inline constexpr std::size_t kKnownHeaderCnt = static_cast<std::size_t>(KnownHeader::Unknown);
+
+// 与 KnownHeader 一一对应 (小写)
+inline constexpr std::array<std::string_view, kKnownHeaderCnt> kKnownHeaderNames {
+    "host",
+    "connection",
+    "content-length",
+    "content-type",
+    "transfer-encoding",
+    "accept",
+    "accept-encoding",
+    "accept-language",
+    "user-agent",
+    "cookie",
+    "authorization",
+    "cache-control",
+    "upgrade",
+    "origin",
+    "range",
+    "if-none-match",
+    "if-modified-since",
+    "referer",
+    "date",
+    "server",
+    "set-cookie",
+    "location",
+    "etag",
+    "last-modified",
+    "content-encoding",
+    "sec-websocket-key",
+    "sec-websocket-accept",
+    "sec-websocket-version",
+};
+
+/**
+ * @brief 常用请求头的完美哈希: 只取 长度 + 首 / 中 / 尾 三个字符 (转为小写),
+ *        乘以编译期搜索得到的种子后取高位, 常用请求头之间没有冲突
+ * @note 命中槽位后仍需完整比较一次, 以排除不常用的请求头
+ */
+inline constexpr std::uint32_t kKnownHeaderHashBits = 7;
+
+constexpr std::uint32_t knownHeaderKey(std::string_view name) noexcept {
+    auto at = [&](std::size_t i) {
+        return static_cast<std::uint32_t>(asciiToLower(static_cast<unsigned char>(name[i])));
+    };
+    return static_cast<std::uint32_t>(name.size())
+         | at(0) << 8
+         | at(name.size() / 2) << 16
+         | at(name.size() - 1) << 24;
+}
+
+constexpr std::uint32_t knownHeaderSlot(std::uint32_t key, std::uint32_t seed) noexcept {
+    return (key * seed) >> (32 - kKnownHeaderHashBits);
+}
+
+inline constexpr std::uint32_t kKnownHeaderSeed = [] {
+    for (std::uint32_t seed = 0x9E3779B1u; seed < 0x9E3779B1u + (1u << 20); seed += 2) {
+        std::array<bool, 1u << kKnownHeaderHashBits> used{};
+        bool ok = true;
+        for (auto name : kKnownHeaderNames) {
+            auto const slot = knownHeaderSlot(knownHeaderKey(name), seed);
+            if (used[slot]) {
+                ok = false;
+                break;
+            }
+            used[slot] = true;
+        }
+        if (ok) {
+            return seed;
+        }
+    }
+    return 0u;
+}();
+
+static_assert(kKnownHeaderSeed != 0, "No perfect hash seed for the known headers");
+
+inline constexpr auto kKnownHeaderTable = [] {
+    std::array<KnownHeader, 1u << kKnownHeaderHashBits> table{};
+    table.fill(KnownHeader::Unknown);
+    for (std::size_t i = 0; i < kKnownHeaderCnt; ++i) {
+        table[knownHeaderSlot(knownHeaderKey(kKnownHeaderNames[i]), kKnownHeaderSeed)]
+            = static_cast<KnownHeader>(i);
+    }
+    return table;
+}();
+
+inline constexpr std::size_t kKnownHeaderMaxLen = std::ranges::max(
+    kKnownHeaderNames, {}, &std::string_view::size).size();
+
+/**
+ * @brief 判断 name 是否是常用的请求头 (不区分大小写)
+ * @param name
+ * @return KnownHeader 不是则为 KnownHeader::Unknown
+ */
+inline KnownHeader knownHeader(std::string_view name) noexcept {
+    if (name.empty() || name.size() > kKnownHeaderMaxLen) {
+        return KnownHeader::Unknown;
+    }
+    auto const h = kKnownHeaderTable[knownHeaderSlot(knownHeaderKey(name), kKnownHeaderSeed)];
+    if (h != KnownHeader::Unknown
+        && TransparentCaseInsensitiveEqual{}(kKnownHeaderNames[static_cast<std::size_t>(h)], name)
+    ) {
+        return h;
+    }
+    return KnownHeader::Unknown;
+}
+
+} // namespace internal
+
+/**
+ * @brief 请求头 / 响应头容器 (键不区分大小写, 保持插入顺序)
+ * @note 键值对是连续存放的视图: 前 kInlineSize 个就在对象内部, 之后才放到堆上;
+ *       常用的请求头 (KnownHeader) 记录了第一次出现的下标, 其余的键线性查找.
+ *       *View 系列接口只保存视图 (调用方保证其存活), 其余接口把字符串复制到内部的分块存储中.
+ *       clear() 不释放已有的空间, 因此长连接上复用时不会再分配内存.
+ * @warning 同名的键可以有多个 (如 set-cookie), 查找时返回第一个
+ */
+class HttpHeaders {
+public:
+    using key_type = std::string_view;
+    using mapped_type = std::string_view;
+    using value_type = std::pair<std::string_view, std::string_view>;
+    using size_type = std::size_t;
+    using const_iterator = value_type const*;
+    using iterator = const_iterator;
+
+    inline static constexpr std::size_t kInlineSize = 16;
+
+    HttpHeaders() noexcept
+        : _inline{}
+        , _heap{}
+        , _size{}
+        , _cap{kInlineSize}
+        , _slots{}
+        , _blocks{}
+        , _block{}
+        , _used{}
+    {}
+
+    /**
+     * @brief 深拷贝: 新对象持有全部字符串的副本
+     */
+    HttpHeaders(HttpHeaders const& that)
+        : HttpHeaders{}
+    {
+        for (auto const& [k, v] : that) {
+            add(k, v);
+        }
+    }
+
+    HttpHeaders(HttpHeaders&& that) noexcept
+        : HttpHeaders{}
+    {
+        _steal(that);
+    }
+
+    HttpHeaders& operator=(HttpHeaders const& that) {
+        if (this != &that) {
+            HttpHeaders tmp{that};
+            clear();
+            _steal(tmp);
+        }
+        return *this;
+    }
+
+    HttpHeaders& operator=(HttpHeaders&& that) noexcept {
+        if (this != &that) {
+            _steal(that);
+        }
+        return *this;
+    }
+
+    const_iterator begin() const noexcept {
+        return _data();
+    }
+
+    const_iterator end() const noexcept {
+        return _data() + _size;
+    }
+
+    std::size_t size() const noexcept {
+        return _size;
+    }
+
+    bool empty() const noexcept {
+        return !_size;
+    }
+
+    /**
+     * @brief 查找 (键不区分大小写)
+     * @param key
+     * @return const_iterator 不存在则为 end()
+     */
+    const_iterator find(std::string_view key) const noexcept {
+        if (auto h = internal::knownHeader(key); h != KnownHeader::Unknown) {
+            return find(h);
+        }
+        return std::find_if(begin(), end(), [&](value_type const& kv) {
+            return internal::TransparentCaseInsensitiveEqual{}(kv.first, key);
+        });
+    }
+
+    const_iterator find(KnownHeader h) const noexcept {
+        auto const i = _slots[static_cast<std::size_t>(h)];
+        return i ? begin() + (i - 1) : end();
+    }
+
+    bool contains(std::string_view key) const noexcept {
+        return find(key) != end();
+    }
+
+    bool contains(KnownHeader h) const noexcept {
+        return find(h) != end();
+    }
+
+    /**
+     * @brief 获取值 (键不区分大小写)
+     * @param key
+     * @return std::optional<std::string_view>
+     */
+    std::optional<std::string_view> get(std::string_view key) const noexcept {
+        return _toOpt(find(key));
+    }
+
+    std::optional<std::string_view> get(KnownHeader h) const noexcept {
+        return _toOpt(find(h));
+    }
+
+    /**
+     * @brief 追加一个键值对 (复制), 不检查是否已存在
+     */
+    HttpHeaders& add(std::string_view key, std::string_view val) {
+        _push(_store(key), _store(val));
+        return *this;
+    }
+
+    /**
+     * @brief 追加一个键值对 (视图), 不检查是否已存在
+     */
+    HttpHeaders& addView(std::string_view key, std::string_view val) {
+        _push(key, val);
+        return *this;
+    }
+
+    /**
+     * @brief 设置值 (复制): 已存在则覆盖第一个, 否则追加
+     */
+    HttpHeaders& set(std::string_view key, std::string_view val) {
+        if (auto* kv = _findMut(key)) {
+            kv->second = _store(val);
+        } else {
+            add(key, val);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief 设置值 (视图): 已存在则覆盖第一个, 否则追加
+     */
+    HttpHeaders& setView(std::string_view key, std::string_view val) {
+        if (auto* kv = _findMut(key)) {
+            kv->second = val;
+        } else {
+            _push(key, val);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief 不存在时才追加 (复制)
+     * @return bool 是否追加了
+     */
+    bool tryAdd(std::string_view key, std::string_view val) {
+        if (contains(key)) {
+            return false;
+        }
+        add(key, val);
+        return true;
+    }
+
+    /**
+     * @brief 不存在时才追加 (视图)
+     * @return bool 是否追加了
+     */
+    bool tryAddView(std::string_view key, std::string_view val) {
+        if (contains(key)) {
+            return false;
+        }
+        _push(key, val);
+        return true;
+    }
+
+    /**
+     * @brief 在最后一个键值对的值后面接上 more (复制), 用于分成多行的值
+     * @warning 必须非空
+     */
+    void appendToLast(std::string_view more) {
+        auto& val = _data()[_size - 1].second;
+        char* p = _alloc(val.size() + more.size());
+        std::memcpy(p, val.data(), val.size());
+        std::memcpy(p + val.size(), more.data(), more.size());
+        val = {p, val.size() + more.size()};
+    }
+
+    /**
+     * @brief 把最后一个键值对的值替换为视图 val
+     * @warning 必须非空
+     */
+    void setLastView(std::string_view val) noexcept {
+        _data()[_size - 1].second = val;
+    }
+
+    /**
+     * @brief 被引用的缓冲区 [oldBase, oldBase + len) 搬移到 newBase 后, 重定位指向它的视图
+     */
+    void rebase(char const* oldBase, std::size_t len, char const* newBase) noexcept {
+        auto move = [&](std::string_view& sv) {
+            if (std::greater_equal<>{}(sv.data(), oldBase)
+                && std::less_equal<>{}(sv.data(), oldBase + len)
+            ) {
+                sv = {newBase + (sv.data() - oldBase), sv.size()};
+            }
+        };
+        for (auto& [k, v] : std::span{_data(), _size}) {
+            move(k);
+            move(v);
+        }
+    }
+
+    /**
+     * @brief 清空 (保留已分配的空间)
+     */
+    void clear() noexcept {
+        _size = 0;
+        _slots = {};
+        // 只留下常规大小的存储块, 偶尔的超大值不长期占用内存
+        std::erase_if(_blocks, [](Block const& b) {
+            return b.cap > kBlockSize;
+        });
+        _block = 0;
+        _used = 0;
+    }
+
+private:
+    inline static constexpr std::size_t kBlockSize = 1024;
+
+    /**
+     * @brief 存放复制的字符串的块 (块本身不会搬移, 视图一直有效)
+     */
+    struct Block {
+        std::unique_ptr<char[]> data;
+        std::size_t cap;
+    };
+
+    value_type* _data() noexcept {
+        return _heap ? _heap.get() : _inline.data();
+    }
+
+    value_type const* _data() const noexcept {
+        return _heap ? _heap.get() : _inline.data();
+    }
+
+    std::optional<std::string_view> _toOpt(const_iterator it) const noexcept {
+        return it != end() ? std::optional<std::string_view>{it->second} : std::nullopt;
+    }
+
+    value_type* _findMut(std::string_view key) noexcept {
+        auto it = find(key);
+        return it != end() ? _data() + (it - begin()) : nullptr;
+    }
+
+    void _push(std::string_view key, std::string_view val) {
+        if (_size == _cap) [[unlikely]] {
+            auto heap = std::make_unique<value_type[]>(_cap * 2);
+            std::copy(begin(), end(), heap.get());
+            _heap = std::move(heap);
+            _cap *= 2;
+        }
+        _data()[_size++] = {key, val};
+        if (auto h = internal::knownHeader(key); h != KnownHeader::Unknown) {
+            auto& slot = _slots[static_cast<std::size_t>(h)];
+            if (!slot) {
+                slot = static_cast<std::uint32_t>(_size);
+            }
+        }
+    }
+
+    char* _alloc(std::size_t n) {
+        while (_block < _blocks.size() && _blocks[_block].cap - _used < n) {
+            ++_block;
+            _used = 0;
+        }
+        if (_block == _blocks.size()) {
+            auto const cap = std::max(kBlockSize, n);
+            _blocks.push_back({std::make_unique_for_overwrite<char[]>(cap), cap});
+            _used = 0;
+        }
+        char* p = _blocks[_block].data.get() + _used;
+        _used += n;
+        return p;
+    }
+
+    std::string_view _store(std::string_view s) {
+        if (s.empty()) {
+            return {};
+        }
+        char* p = _alloc(s.size());
+        std::memcpy(p, s.data(), s.size());
+        return {p, s.size()};
+    }
+
+    void _steal(HttpHeaders& that) noexcept {
+        if (!that._heap) {
+            std::copy(that.begin(), that.end(), _inline.begin());
+        }
+        _heap = std::move(that._heap);
+        _size = std::exchange(that._size, 0);
+        _cap = std::exchange(that._cap, kInlineSize);
+        _slots = std::exchange(that._slots, {});
+        _blocks = std::move(that._blocks);
+        that._blocks.clear();
+        _block = std::exchange(that._block, 0);
+        _used = std::exchange(that._used, 0);
+    }
+
+    std::array<value_type, kInlineSize> _inline;            // 内联的键值对
+    std::unique_ptr<value_type[]> _heap;                    // 超过 kInlineSize 后的键值对
+    std::size_t _size;                                      // 键值对个数
+    std::size_t _cap;                                       // 当前的容量
+    std::array<std::uint32_t, internal::kKnownHeaderCnt> _slots; // 常用请求头第一次出现的下标 + 1 (0 为不存在)
+    std::vector<Block> _blocks;                             // 复制的字符串
+    std::size_t _block;                                     // 正在使用的块
+    std::size_t _used;                                      // 正在使用的块已用的字节数
+};
+
+/**
+ * @brief 断点续传参数包
+ */
+struct RangeRequestView {
+    std::string_view reqType;       // 请求类型
+    HttpHeaders const& reqHead;     // 请求头
+};
+
+} // namespace HX::net
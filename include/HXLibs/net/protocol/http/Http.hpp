@@ -141,14 +141,6 @@ using HeaderHashMap = std::unordered_map<
     internal::TransparentCaseInsensitiveEqual
 >;
 
-/**
- * @brief 断点续传参数包
- */
-struct RangeRequestView {
-    std::string_view reqType; // 请求类型
-    HeaderHashMap const& reqHead;  // 请求头
-};
-
 /**
  * @brief SSE 事件包
  */
@@ -18,12 +18,20 @@
  * limitations under the License.
  * */
 
+#include <array>
+#include <cstdint>
+#include <charconv>
+#include <algorithm>
 #include <vector>
+#include <cstring>
+#include <utility>
 #include <optional>
 #include <stdexcept>
 
 #include <HXLibs/container/ArrayBuf.hpp>
 #include <HXLibs/net/protocol/http/Http.hpp>
+#include <HXLibs/net/protocol/http/Headers.hpp>
+#include <HXLibs/net/protocol/http/RequestParser.hpp>
 #include <HXLibs/net/socket/IO.hpp>
 #include <HXLibs/utils/FileUtils.hpp>
 #include <HXLibs/utils/StringUtils.hpp>
@@ -84,11 +92,15 @@ public:
 
     explicit HttpRequest(IOType& io) 
         : _recvBuf()
+        , _parser()
+        , _headLen{}
+        , _headSpill()
         , _requestLine()
+        , _reqPath()
         , _requestHeaders()
-        , _requestHeadersIt(_requestHeaders.end())
         , _body()
         , _remainingBodyLen(std::nullopt)
+        , _chunkState{ChunkState::Size}
         , _io{io}
         , _boundary{}
     {}
@@ -115,9 +127,7 @@ public:
         using namespace std::string_view_literals;
 #ifndef NODEBUG
         // 不能存在 CONTENT_LENGTH_SV, 仅debug模式会检测
-        if (auto it = _requestHeaders.find(CONTENT_LENGTH_SV); 
-            it != _requestHeaders.end()
-        ) [[unlikely]] {
+        if (_requestHeaders.contains(CONTENT_LENGTH_SV)) [[unlikely]] {
             throw std::runtime_error{"Should not be manually added: Content-Length"};
         }
 #endif // !NODEBUG
@@ -150,9 +160,7 @@ public:
         using namespace std::string_view_literals;
 #ifndef NODEBUG
         // 不能存在 CONTENT_LENGTH_SV, 仅debug模式会检测
-        if (auto it = _requestHeaders.find(CONTENT_LENGTH_SV); 
-            it != _requestHeaders.end()
-        ) [[unlikely]] {
+        if (_requestHeaders.contains(CONTENT_LENGTH_SV)) [[unlikely]] {
             throw std::runtime_error{"Should not be manually added: Content-Length"};
         }
 #endif // !NODEBUG
@@ -160,7 +168,7 @@ public:
         co_await file.open(path, utils::OpenMode::Read);
         container::Try<> err;
         try {
-            _requestHeaders[std::string{TRANSFER_ENCODING_SV}] = "chunked"; // 分块编码请求头要求
+            _requestHeaders.setView(TRANSFER_ENCODING_SV, "chunked"); // 分块编码请求头要求
             // 开始发送分块编码
             std::vector<char> buf, sendBuf;
             buf.reserve(utils::FileUtils::kBufMaxSize);
@@ -204,10 +212,9 @@ public:
      */
     template <HttpMethod Method>
     HttpRequest& setReqLine(std::string_view path) {
-        using namespace std::string_literals;
-        _requestLine.resize(3);
+        _reqPath.assign(path);
         _requestLine[RequestLineDataType::RequestType] = getMethodStringView(Method);
-        _requestLine[RequestLineDataType::RequestPath] = path;
+        _requestLine[RequestLineDataType::RequestPath] = _reqPath;
         _requestLine[RequestLineDataType::ProtocolVersion] = "HTTP/1.1";
         return *this;
     }
@@ -218,7 +225,9 @@ public:
      * @return Request& 
      */
     HttpRequest& addHeaders(const std::vector<std::pair<std::string, std::string>>& heads) {
-        _requestHeaders.insert(heads.begin(), heads.end());
+        for (auto const& [k, v] : heads) {
+            _requestHeaders.tryAdd(k, v);
+        }
         return *this;
     }
 
@@ -228,7 +237,9 @@ public:
      * @return Request& 
      */
     HttpRequest& addHeaders(const std::unordered_map<std::string, std::string>& heads) {
-        _requestHeaders.insert(heads.begin(), heads.end());
+        for (auto const& [k, v] : heads) {
+            _requestHeaders.tryAdd(k, v);
+        }
         return *this;
     }
 
@@ -238,8 +249,8 @@ public:
      * @return Request& 
      */
     HttpRequest& addHeaders(HeaderHashMap&& heads) {
-        for (auto&& [k, v] : heads) {
-            _requestHeaders[k] = std::move(v);
+        for (auto const& [k, v] : heads) {
+            _requestHeaders.set(k, v);
         }
         return *this;
     }
@@ -250,7 +261,9 @@ public:
      * @return Request& 
      */
     HttpRequest& addHeaders(HeaderHashMap const& heads) {
-        _requestHeaders.insert(heads.begin(), heads.end());
+        for (auto const& [k, v] : heads) {
+            _requestHeaders.tryAdd(k, v);
+        }
         return *this;
     }
 
@@ -275,11 +288,10 @@ public:
      * @param key 键
      * @param val 值
      * @return Request&
-     * @warning `key`在`map`中是区分大小写的, 故不要使用`大小写不同`的相同的`键`
+     * @note 键不区分大小写, 已存在则覆盖
      */
-    template <typename Str1, typename Str2>
-    HttpRequest& addHeaders(Str1&& key, Str2&& val) {
-        _requestHeaders[std::forward<Str1>(key)] = std::forward<Str2>(val);
+    HttpRequest& addHeaders(std::string_view key, std::string_view val) {
+        _requestHeaders.set(key, val);
         return *this;
     }
 
@@ -288,11 +300,10 @@ public:
      * @param key 键
      * @param val 值
      * @return Request&
-     * @warning `key`在`map`中是区分大小写的, 故不要使用`大小写不同`的相同的`键`
+     * @note 键不区分大小写
      */
-    template <typename Str1, typename Str2>
-    HttpRequest& tryAddHeaders(Str1&& key, Str2&& val) {
-        _requestHeaders.try_emplace(std::forward<Str1>(key), std::forward<Str2>(val));
+    HttpRequest& tryAddHeaders(std::string_view key, std::string_view val) {
+        _requestHeaders.tryAdd(key, val);
         return *this;
     }
     // ===== ↑客户端使用↑ =====
@@ -300,36 +311,108 @@ public:
     // ===== ↓服务端使用↓ =====
     /**
      * @brief 解析请求 (请求行 + 请求头)
+     * @note 超时 / 对方断开 / 读取出错 (如连接被重置) / 请求头不合法或过大 都不会抛出异常;
+     *       请求行与请求头都是指向接收缓冲区的视图, 有效至 clear()
      * @return coroutine::Task<bool> 断开连接则为false, 解析成功为true
      */
     template <typename Timeout>
         requires(utils::HasTimeNTTP<Timeout>)
     coroutine::Task<bool> parserReqHead() {
-        for (std::size_t n = IO::kBufMaxSize; n; n = _parserReqHead()) {
+        if (_io.hasBufRing() && !_io.isMultishotRecv() && !_recvBuf.size()) {
+#if defined(__linux__)
+            // 等待期间不占用缓冲区, 数据到达时内核才从缓冲区环中挑选;
+            // 复制到 _recvBuf 后立即归还 (请求头的视图需要存活到 clear())
+            auto buf = co_await _io.template recvProvidedLinkTimeout<Timeout>();
+            if (buf.res() == -ETIME) [[unlikely]] {
+                co_return false;  // 超时
+            }
+            if (buf.res() != -ENOBUFS) [[likely]] {
+                if (buf.res() <= 0) [[unlikely]] {
+                    co_return false; // 连接断开或出错
+                }
+                _recvBuf.moveToHead(buf.data());
+            }
+            // else: 缓冲区环已被借空, 回退为读取到连接自身的缓冲区
+#endif // defined(__linux__)
+        }
+        for (;;) {
+            if (_recvBuf.size()) {
+                switch (_parser.parse({_recvBuf.data(), _recvBuf.size()})) {
+                    case RequestHeadParser::Status::Complete:
+                        if (!_checkBodyFraming()) [[unlikely]] {
+                            co_return false; // 无法确定请求的边界, 关闭连接
+                        }
+                        _onHeadComplete();
+                        co_return true;
+                    case RequestHeadParser::Status::Invalid: [[unlikely]]
+                        co_return false;
+                    case RequestHeadParser::Status::Partial:
+                        break;
+                }
+                if (_recvBuf.size() == _recvBuf.max_size()) [[unlikely]] {
+                    co_return false; // 请求头过大
+                }
+            }
             auto res = co_await _io.template recvLinkTimeout<Timeout>(
                 // 保留原有的数据
-                {_recvBuf.data() + _recvBuf.size(), _recvBuf.data() + std::min(_recvBuf.max_size(), n)}
+                {_recvBuf.data() + _recvBuf.size(), _recvBuf.data() + _recvBuf.max_size()}
             );
             if (res.index() == 1) [[unlikely]] {
                 co_return false;  // 超时
             }
-            auto recvN = HXLIBS_CHECK_EVENT_LOOP(
-                (res.template get<0, exception::ExceptionMode::Nothrow>())
-            );
-            if (recvN == 0) [[unlikely]] {
-                co_return false; // 连接断开
+            auto recvN = res.template get<0, exception::ExceptionMode::Nothrow>();
+            if (recvN <= 0) [[unlikely]] {
+                co_return false; // 连接断开或出错
             }
             _recvBuf.addSize(static_cast<std::size_t>(recvN));
         }
-        co_return true;
+    }
+
+    /**
+     * @brief 流水线: 当前请求的请求体之后, 是否已经收到了下一个完整的请求头
+     * @note 只按 Content-Length 定位请求体的结尾; 分块编码的请求体不预先解析, 视为没有
+     * @warning 仅在 parserReqHead() 成功之后, 读取请求体之前有意义
+     */
+    bool hasPipelinedRequest() const noexcept {
+        if (_parser.find(TRANSFER_ENCODING_SV)) {
+            return false;
+        }
+        std::string_view buf = _bodyBuf();
+        auto const bodyLen = _remainingBodyLen.value_or(0);
+        if (buf.size() <= bodyLen) {
+            return false;
+        }
+        buf.remove_prefix(bodyLen);
+        auto const start = buf.find_first_not_of(CRLF); // 请求行之前的空行
+        return start != std::string_view::npos && buf.find(HEADER_END_SV, start) != std::string_view::npos;
+    }
+
+    /**
+     * @brief clear() 之后, 接收缓冲区中是否已有下一个完整的请求头 (流水线),
+     *        即下一次 parserReqHead() 无需读取
+     * @note 请求头不合法时同样为 true (下一次 parserReqHead() 会直接失败)
+     */
+    bool hasBufferedRequest() noexcept {
+        return _recvBuf.size()
+            && _parser.parse({_recvBuf.data(), _recvBuf.size()}) != RequestHeadParser::Status::Partial;
     }
 
     /**
      * @brief 获取请求头键值对的引用
-     * @return const std::unordered_map<std::string, std::string>& 
+     * @note 服务端的请求头是指向接收缓冲区的视图 (键为小写), 有效至 clear()
+     * @return HttpHeaders const& 
      */
-    const auto& getHeaders() const noexcept {
-        return _requestHeaders;
+    HttpHeaders const& getHeaders() const noexcept {
+        return _parser.isComplete() ? _parser.headers() : _requestHeaders;
+    }
+
+    /**
+     * @brief 查找请求头 (键不区分大小写)
+     * @param key 键
+     * @return std::optional<std::string_view> 服务端为指向接收缓冲区的视图, 有效至 clear()
+     */
+    std::optional<std::string_view> getHeader(std::string_view key) const noexcept {
+        return getHeaders().get(key);
     }
 
     /**
@@ -377,23 +460,15 @@ public:
             throw std::runtime_error{"Have already analyzed the http body"};
         }
         _completeBody = true;
-        for (std::size_t n = _parserReqBody(); n; n = _parserReqBody()) {
-            auto res = co_await _io.template recvLinkTimeout<Timeout>(
-                // 保留原有的数据
-                {_recvBuf.data() + _recvBuf.size(), _recvBuf.data() + std::min(_recvBuf.max_size(), n)}
-            );
-            if (res.index() == 1) [[unlikely]] {
-                // 超时
+        if (int err = co_await _tryRecvBody<Timeout>(); err < 0) [[unlikely]] {
+            if (err == -ETIME) {
                 throw std::runtime_error{"parseBody: Recv timeout"};
-            }
-            auto recvN = HXLIBS_CHECK_EVENT_LOOP(
-                (res.template get<0, exception::ExceptionMode::Nothrow>())
-            );
-            if (recvN == 0) [[unlikely]] {
-                // 连接断开
+            } else if (err == -ENOTCONN) {
                 throw std::runtime_error{"parseBody: Connection is Broken"};
+            } else if (err == -EPROTO) {
+                throw std::runtime_error{"parseBody: Invalid chunked body"};
             }
-            _recvBuf.addSize(static_cast<std::size_t>(recvN));
+            throw std::system_error(-err, std::system_category());
         }
         co_return std::move(_body);
     }
@@ -414,10 +489,7 @@ public:
         }
         _completeBody = true;
         for (std::size_t n = co_await _coParserReqBody(file); n; n = co_await _coParserReqBody(file)) {
-            auto res = co_await _io.template recvLinkTimeout<Timeout>(
-                // 保留原有的数据
-                {_recvBuf.data() + _recvBuf.size(), _recvBuf.data() + std::min(_recvBuf.max_size(), n)}
-            );
+            auto res = co_await _io.template recvLinkTimeout<Timeout>(_bodyRecvSpan(n));
             if (res.index() == 1) [[unlikely]] {
                 // 超时
                 throw std::runtime_error{"parseBody: Recv timeout"};
@@ -437,7 +509,7 @@ public:
     // @todo 
     coroutine::Task<> _getMultipartFiles() {
         static_assert(true, "@todo Func...");
-        if (auto it = _requestHeaders.find(CONTENT_TYPE_SV); it != _requestHeaders.end()) {
+        if (auto it = getHeaders().find(CONTENT_TYPE_SV); it != getHeaders().end()) {
             // multipart/form-data 协议
             if (_boundary.empty()) {            
                 std::string_view str = it->second;
@@ -524,7 +596,7 @@ public:
      * @return RangeRequestView 
      */
     RangeRequestView getRangeRequestView() const {
-        return {getReqType(), _requestHeaders};
+        return {getReqType(), getHeaders()};
     }
     // ===== ↑服务端使用↑ =====
 
@@ -539,24 +611,88 @@ public:
     /**
      * @brief 清空已有的请求内容, 并且初始化标准
      * @warning 显然应该在 clearBody() 之前调用
+     * @return coroutine::Task<bool> 未读取的请求体没能读完 (超时 / 断开 / 分块编码不合法) 则为 false,
+     *         此时连接不可再复用
      */
-    coroutine::Task<> clear() noexcept {
+    coroutine::Task<bool> clear() noexcept {
+        bool ok = true;
         if (!_completeBody) {
             // 250 ms, 如果解析不完, 就滚蛋! 传递这么多没用的干什么?!
-            co_await parseBody<decltype(250_ms)>();
+            ok = co_await _tryRecvBody<decltype(250_ms)>() == 0;
         }
         _completeBody = false;
         _boundary = {};
-        _requestLine.clear();
+        _parser.reset();
+        if (ok && _recvBuf.size() > _headLen) {
+            // 已经收到的下一个请求 (流水线), 搬到缓冲区头部
+            _recvBuf.moveToHead(_bodyBuf());
+        } else if (_io.hasBufRing()) {
+            _recvBuf.release(); // 空闲的连接不持有读缓冲区
+        } else {
+            _recvBuf.clear();
+        }
+        _headLen = 0;
+        _requestLine = {};
         _requestHeaders.clear();
-        _requestHeadersIt = _requestHeaders.end();
-        _recvBuf.clear();
         _body.clear();
-        _completeRequestHeader = false;
         _remainingBodyLen.reset();
+        _chunkState = ChunkState::Size;
+        co_return ok;
     }
 
 private:
+    /**
+     * @brief 读取剩余的请求体, 不抛出异常
+     * @tparam Timeout 超时时间
+     * @return coroutine::Task<int> 0 为成功; 超时为 -ETIME, 对方断开为 -ENOTCONN,
+     *         分块编码不合法为 -EPROTO, 否则为负的错误码
+     */
+    template <typename Timeout>
+        requires(utils::HasTimeNTTP<Timeout>)
+    coroutine::Task<int> _tryRecvBody() {
+        for (;;) {
+            std::size_t n;
+            try {
+                n = _parserReqBody();
+            } catch (std::runtime_error const&) {
+                co_return -EPROTO; // 块大小或块的结尾不合法
+            }
+            if (!n) {
+                break;
+            }
+            auto res = co_await _io.template recvLinkTimeout<Timeout>(_bodyRecvSpan(n));
+            if (res.index() == 1) [[unlikely]] {
+                co_return -ETIME; // 超时
+            }
+            auto recvN = res.template get<0, exception::ExceptionMode::Nothrow>();
+            if (recvN <= 0) [[unlikely]] {
+                co_return recvN ? recvN : -ENOTCONN; // 出错 或 连接断开
+            }
+            _recvBuf.addSize(static_cast<std::size_t>(recvN));
+        }
+        co_return 0;
+    }
+
+    /**
+     * @brief 分块编码的解析进度
+     */
+    enum class ChunkState : std::uint8_t {
+        Size,       // 等待块大小行 `hex[;ext]\r\n`
+        Data,       // 块数据, 剩余 _remainingBodyLen 个字节
+        DataCrlf,   // 块数据之后的 \r\n
+        Trailer,    // 最后一个块 (0) 之后的 trailer 字段, 直到空行
+        Done,       // 请求体结束
+    };
+
+    /**
+     * @brief 分块编码解析一步的结果
+     */
+    enum class ChunkStep : std::uint8_t {
+        Data,       // 得到一段数据, 继续调用
+        NeedMore,   // 需要继续读取, buf 为尚未解析完的部分 (需保留)
+        Done,       // 请求体结束, buf 为之后的数据 (流水线中的下一个请求)
+    };
+
     /**
      * @brief 请求行数据分类
      */
@@ -567,15 +703,28 @@ private:
     };
 
     /**
-     * @brief 仅用于读取时候写入的缓冲区
+     * @brief 仅用于读取时候写入的缓冲区 (第一次写入时才分配)
+     * @note 服务端: 头部的 _headLen 个字节是请求头 (被视图引用), 之后才是请求体
      */
-    container::ArrayBuf<char, IO::kBufMaxSize> _recvBuf;
+    container::HeapArrayBuf<char, IO::kBufMaxSize> _recvBuf;
+
+    // 请求头解析器 (服务端)
+    RequestHeadParser _parser;
+
+    // _recvBuf 头部被请求头占用的字节数
+    std::size_t _headLen;
+
+    // 请求头过大时搬到这里, 以给请求体腾出 _recvBuf 的空间
+    std::string _headSpill;
+
+    // 请求行 (服务端为指向请求头的视图)
+    std::array<std::string_view, 3> _requestLine;
 
-    std::vector<std::string> _requestLine;  // 请求行
-    HeaderHashMap _requestHeaders;          // 请求头
+    // [仅客户端] 请求路径
+    std::string _reqPath;
 
-    // 上一次解析的请求头
-    HeaderHashMap::iterator _requestHeadersIt;
+    // [仅客户端] 请求头 (服务端的请求头在 _parser 中)
+    HttpHeaders _requestHeaders;
 
     // 请求体
     std::string _body;
@@ -583,6 +732,9 @@ private:
     // @brief 仍需读取的请求体长度
     std::optional<std::size_t> _remainingBodyLen;
 
+    // 分块编码请求体的解析进度
+    ChunkState _chunkState;
+
     /**
      * @brief 路径变量, 如`/home/{id}`的`id`, 
      * 存放的是解析后的结果字符串视图(指向的是Request的请求行)
@@ -599,11 +751,6 @@ private:
     // multipart/form-data 协议边界.
     std::string_view _boundary;
 
-    /**
-     * @brief 是否解析完成请求头
-     */
-    bool _completeRequestHeader = false;
-
     /**
      * @brief 是否解析过 Body
      */
@@ -662,81 +809,188 @@ private:
     }
 
     /**
-     * @brief 解析请求
-     * @return 是否需要继续解析;
-     *         `== 0`: 不需要;
-     *         `>  0`: 需要继续解析`size_t`个字节
-     * @warning 假定内容是符合Http协议的
+     * @brief 校验请求体的定界 (RFC 9112 6.3), 并记下 Content-Length
+     * @return false: 同时存在 Transfer-Encoding 与 Content-Length, Transfer-Encoding 的最后一个编码不是 chunked,
+     *         或 Content-Length 不合法 / 多个值不一致. 此时无法确定请求在哪里结束 (请求走私), 连接不可再复用
      */
-    std::size_t _parserReqHead() {
-        using namespace std::string_literals;
-        using namespace std::string_view_literals;
-        std::string_view buf{_recvBuf.data(), _recvBuf.size()};
-        switch ((_completeRequestHeader << 1) | (!_requestLine.empty())) {
-            case 0x00: { // 什么也没有解析, 开始解析请求行
-                std::size_t pos = buf.find(CRLF);
-                if (pos == std::string_view::npos) [[unlikely]] { // 不可能事件
-                    return IO::kBufMaxSize;
+    bool _checkBodyFraming() {
+        auto trim = [](std::string_view sv) noexcept {
+            auto const begin = sv.find_first_not_of(" \t");
+            return begin == std::string_view::npos
+                ? std::string_view{}
+                : sv.substr(begin, sv.find_last_not_of(" \t") - begin + 1);
+        };
+        std::optional<std::size_t> contentLength;
+        std::string_view lastCoding;
+        bool hasTransferEncoding = false;
+        for (auto const& [key, val] : _parser.headers()) { // 键已转为小写
+            if (key == CONTENT_LENGTH_SV) {
+                // 同一个值可能重复出现, 如 `Content-Length: 5, 5`
+                for (std::string_view rest = val;;) {
+                    auto const comma = rest.find(',');
+                    auto const num = trim(rest.substr(0, comma));
+                    std::size_t len{};
+                    auto const [ptr, ec] = std::from_chars(num.data(), num.data() + num.size(), len);
+                    if (num.empty() || ec != std::errc{} || ptr != num.data() + num.size()
+                        || (contentLength && *contentLength != len)
+                    ) [[unlikely]] {
+                        return false;
+                    }
+                    contentLength = len;
+                    if (comma == std::string_view::npos) {
+                        break;
+                    }
+                    rest.remove_prefix(comma + 1);
                 }
-                std::string_view reqLine = buf.substr(0, pos);
-
-                // 解析请求行
-                _requestLine = utils::StringUtil::split<std::string>(
-                    reqLine, " "sv
-                );
-
-                if (_requestLine.size() < 3) [[unlikely]] {
-                    return IO::kBufMaxSize;
-                } 
-                // else if (_requestLine.size() > 3) [[unlikely]] {
-                // @todo 理论上不会出现
-                // }
-
-                buf = buf.substr(pos + 2); // 再前进, 以去掉 "\r\n"
-                [[fallthrough]];
+            } else if (key == TRANSFER_ENCODING_SV) {
+                hasTransferEncoding = true;
+                lastCoding = trim(val.substr(val.rfind(',') + 1));
             }
-            case 0x01: { // 解析完请求行, 开始解析请求头
-                /**
-                 * @brief 请求头
-                 * 通过`\r\n`分割后, 取最前面的, 先使用最左的`:`以判断是否是需要作为独立的键值对;
-                 * -  如果找不到`:`, 并且 非空, 那么它需要接在上一个解析的键值对的值尾
-                 * -  否则即请求头解析完毕!
-                 */
-                while (!_completeRequestHeader) { // 请求头未解析完
-                    std::size_t pos = buf.find(CRLF);
-                    if (pos == std::string_view::npos) { // 没有读取完
-                        _recvBuf.moveToHead(buf);
-                        return IO::kBufMaxSize;
+        }
+        if (hasTransferEncoding) {
+            return !contentLength
+                && internal::TransparentCaseInsensitiveEqual{}(lastCoding, "chunked");
+        }
+        _remainingBodyLen = contentLength;
+        return true;
+    }
+
+    /**
+     * @brief 请求头解析完毕: 记录请求头占用的长度, 其后的数据留作请求体
+     */
+    void _onHeadComplete() {
+        _headLen = _parser.headLength();
+        if (_recvBuf.max_size() - _headLen < _recvBuf.max_size() / 4) [[unlikely]] {
+            // 剩余的空间太小, 不足以读取请求体: 把请求头搬出去
+            _headSpill.assign(std::as_const(_recvBuf).data(), _headLen);
+            _parser.rebase(_headSpill.data());
+            _recvBuf.moveToHead({std::as_const(_recvBuf).data() + _headLen, _recvBuf.size() - _headLen});
+            _headLen = 0;
+        }
+        _requestLine[RequestLineDataType::RequestType] = _parser.method();
+        _requestLine[RequestLineDataType::RequestPath] = _parser.path();
+        _requestLine[RequestLineDataType::ProtocolVersion] = _parser.version();
+    }
+
+    /**
+     * @brief 已读取但未解析的请求体数据
+     */
+    std::string_view _bodyBuf() const noexcept {
+        return {_recvBuf.data() + _headLen, _recvBuf.size() - _headLen};
+    }
+
+    /**
+     * @brief 把未解析完的请求体数据移动到请求头之后
+     * @param buf _bodyBuf() 的子区间
+     */
+    void _keepBodyBuf(std::string_view buf) {
+        std::memmove(_recvBuf.data() + _headLen, buf.data(), buf.size());
+        _recvBuf.resetSize(_headLen + buf.size());
+    }
+
+    /**
+     * @brief 丢弃已解析的请求体数据
+     */
+    void _clearBodyBuf() noexcept {
+        _recvBuf.resetSize(_headLen);
+    }
+
+    /**
+     * @brief 继续读取请求体的目标区间
+     * @param n 还需要的字节数
+     */
+    std::span<char> _bodyRecvSpan(std::size_t n) {
+        return {_recvBuf.data() + _recvBuf.size(),
+                _recvBuf.data() + std::min(_recvBuf.max_size(), _headLen + n)};
+    }
+
+    /**
+     * @brief 分块编码需要继续读取时, 接收缓冲区必须还有空间 (否则只能发起 0 字节的读取)
+     * @throw 块大小行或 trailer 行填满了接收缓冲区仍未结束时, 抛出 std::runtime_error
+     */
+    void _checkChunkBufSpace() const {
+        if (_recvBuf.size() == _recvBuf.max_size()) [[unlikely]] {
+            throw std::runtime_error{"Chunk line too long"};
+        }
+    }
+
+    /**
+     * @brief 分块编码: 从 buf 中解析出下一段请求体数据
+     * @param buf [in, out] 未解析的数据, 返回时为剩余的部分
+     * @param data [out] ChunkStep::Data 时为解析出的数据 (指向 buf)
+     * @return ChunkStep
+     * @throw 块大小或块的结尾不合法时, 抛出 std::runtime_error (无法确定请求的边界)
+     */
+    ChunkStep _nextChunk(std::string_view& buf, std::string_view& data) {
+        using namespace std::string_view_literals;
+        for (;;) {
+            switch (_chunkState) {
+                case ChunkState::Size: {
+                    auto const nl = buf.find('\n');
+                    if (nl == std::string_view::npos) {
+                        return ChunkStep::NeedMore;
                     }
-                    std::string_view subKVStr = buf.substr(0, pos);
-                    auto p = utils::StringUtil::splitAtFirst(subKVStr, HEADER_SEPARATOR_SV);
-                    if (p.first.empty()) [[unlikely]] {     // 找不到 ": "
-                        if (subKVStr.size()) [[unlikely]] { // 很少会有分片传输请求头的
-                            _requestHeadersIt->second.append(subKVStr);
-                        } else { // 请求头解析完毕!
-                            _completeRequestHeader = true;
-                        }
+                    // 忽略块扩展 (;ext)
+                    auto sizeStr = buf.substr(0, std::min(nl, buf.find_first_of(";\r \t")));
+                    std::size_t size{};
+                    auto const [ptr, ec] = std::from_chars(
+                        sizeStr.data(), sizeStr.data() + sizeStr.size(), size, 16);
+                    if (sizeStr.empty() || ec != std::errc{}
+                        || ptr != sizeStr.data() + sizeStr.size()
+                    ) [[unlikely]] {
+                        throw std::runtime_error{"Invalid chunk size"};
+                    }
+                    buf.remove_prefix(nl + 1);
+                    if (size) {
+                        _remainingBodyLen = size;
+                        _chunkState = ChunkState::Data;
                     } else {
-                        // K: V, 其中 V 是区分大小写的, 但是 K 是不区分的
-                        utils::StringUtil::toLower(p.first);
-                        _requestHeadersIt = _requestHeaders.insert(p).first;
+                        _chunkState = ChunkState::Trailer;
                     }
-                    buf = buf.substr(pos + 2); // 再前进, 以去掉 "\r\n"
+                    break;
                 }
-                [[fallthrough]];
-            }
-            case 0x03: {
-                // 更改到懒解析Body, 如果已经读取了, 那放入缓存趴...
-                _recvBuf.moveToHead(buf);
-                break;
+                case ChunkState::Data: {
+                    if (buf.empty()) {
+                        return ChunkStep::NeedMore;
+                    }
+                    auto const n = std::min(buf.size(), *_remainingBodyLen);
+                    data = buf.substr(0, n);
+                    buf.remove_prefix(n);
+                    if (!(*_remainingBodyLen -= n)) {
+                        _chunkState = ChunkState::DataCrlf;
+                    }
+                    return ChunkStep::Data;
+                }
+                case ChunkState::DataCrlf:
+                    if (buf.starts_with(CRLF)) {
+                        buf.remove_prefix(CRLF.size());
+                    } else if (buf.starts_with('\n')) {
+                        buf.remove_prefix(1);
+                    } else if (buf.empty() || buf == "\r"sv) {
+                        return ChunkStep::NeedMore; // \r\n 被拆分到了两次读取中
+                    } else [[unlikely]] {
+                        throw std::runtime_error{"Invalid chunk terminator"};
+                    }
+                    _chunkState = ChunkState::Size;
+                    break;
+                case ChunkState::Trailer: {
+                    // trailer 字段不使用, 丢弃到空行为止
+                    auto const nl = buf.find('\n');
+                    if (nl == std::string_view::npos) {
+                        return ChunkStep::NeedMore;
+                    }
+                    bool const isEnd = nl == 0 || (nl == 1 && buf[0] == '\r');
+                    buf.remove_prefix(nl + 1);
+                    if (isEnd) {
+                        _chunkState = ChunkState::Done;
+                        return ChunkStep::Done;
+                    }
+                    break;
+                }
+                case ChunkState::Done:
+                    return ChunkStep::Done;
             }
-            [[unlikely]] default:
-#ifndef NDEBUG
-                throw std::runtime_error{"parserRequest UB Error"}
-#endif // NDEBUG
-            ;
         }
-        return 0;
     }
 
     /**
@@ -744,62 +998,30 @@ private:
      * @return std::size_t 还需要解析的字节数
      */
     std::size_t _parserReqBody() {
-        using namespace std::string_literals;
-        using namespace std::string_view_literals;
-        std::string_view buf{_recvBuf.data(), _recvBuf.size()};
-        if (_requestHeaders.contains(CONTENT_LENGTH_SV)) { // 存在content-length模式接收的响应体
-            // 计算剩余待解析字节数
-            if (!_remainingBodyLen.has_value()) {
-                _remainingBodyLen = std::stoull(_requestHeaders.find(CONTENT_LENGTH_SV)->second);
-            }
+        std::string_view buf = _bodyBuf();
+        if (_parser.find(CONTENT_LENGTH_SV)) { // 存在content-length模式接收的响应体
+            // 长度已在 _checkBodyFraming 中解析
             if (*_remainingBodyLen != 0) {
-                *_remainingBodyLen -= buf.size();
-                _body.append(buf);
-                _recvBuf.clear();
+                auto const n = std::min(buf.size(), *_remainingBodyLen);
+                *_remainingBodyLen -= n;
+                _body.append(buf.substr(0, n));
+                _keepBodyBuf(buf.substr(n)); // 之后的数据属于下一个请求 (流水线)
                 return *_remainingBodyLen;
             }
-        } else if (_requestHeaders.contains(TRANSFER_ENCODING_SV)) { // 存在请求体以`分块传输编码`
-            /**
-             * @todo 目前只支持 chunked 编码, 不支持压缩的 (2024-9-6 09:36:25) 
-             * */
-            if (_remainingBodyLen) { // 处理没有读取完的
-                if (buf.size() <= *_remainingBodyLen) { // 还没有读取完毕
-                    _body.append(buf);
-                    *_remainingBodyLen -= buf.size();
-                    _recvBuf.clear();
-                    return IO::kBufMaxSize;
-                } else { // 读取完了
-                    _body.append(buf.substr(0, *_remainingBodyLen));
-                    buf = buf.substr(std::min(*_remainingBodyLen + 2, buf.size()));
-                    _remainingBodyLen.reset();
-                }
-            }
-            for (;;) {
-                std::size_t posLen = buf.find(CRLF);
-                if (posLen == std::string_view::npos) { // 没有读完
-                    _recvBuf.moveToHead(buf);
-                    return IO::kBufMaxSize;
-                }
-                if (!posLen && buf[0] == '\r') [[unlikely]] { // posLen == 0
-                    // \r\n 贴脸, 触发原因, std::min(*_remainingBodyLen + 2, buf.size()) 只能 buf.size()
-                    buf = buf.substr(posLen + 2);
-                    continue;
-                }
-                _remainingBodyLen = utils::NumericBaseConverter::strToNum<std::size_t, 16>(
-                    buf.substr(0, posLen)
-                ); // 转换为十进制整数
-                if (!*_remainingBodyLen) { // 解析完毕
-                    return 0;
-                }
-                buf = buf.substr(posLen + 2);
-                if (buf.size() <= *_remainingBodyLen) { // 没有读完
-                    _body.append(buf);
-                    *_remainingBodyLen -= buf.size();
-                    _recvBuf.clear();
-                    return IO::kBufMaxSize;
+        } else if (_parser.find(TRANSFER_ENCODING_SV)) { // 存在请求体以`分块传输编码`
+            for (std::string_view data;;) {
+                switch (_nextChunk(buf, data)) {
+                    case ChunkStep::Data:
+                        _body.append(data);
+                        break;
+                    case ChunkStep::NeedMore:
+                        _keepBodyBuf(buf);
+                        _checkChunkBufSpace();
+                        return IO::kBufMaxSize;
+                    case ChunkStep::Done:
+                        _keepBodyBuf(buf); // 之后的数据属于下一个请求 (流水线)
+                        return 0;
                 }
-                _body.append(buf.substr(0, *_remainingBodyLen));
-                buf = buf.substr(*_remainingBodyLen + 2);
             }
         }
         return 0;
@@ -810,63 +1032,30 @@ private:
      * @return std::size_t 还需要解析的字节数
      */
     coroutine::Task<std::size_t> _coParserReqBody(utils::AsyncFile& file) {
-        using namespace std::string_literals;
-        using namespace std::string_view_literals;
-        std::string_view buf{_recvBuf.data(), _recvBuf.size()};
-        if (_requestHeaders.contains(CONTENT_LENGTH_SV)) { // 存在content-length模式接收的响应体
-            // 计算剩余待解析字节数
-            if (!_remainingBodyLen.has_value()) {
-                _remainingBodyLen = std::stoull(_requestHeaders.find(CONTENT_LENGTH_SV)->second);
-            }
-            
+        std::string_view buf = _bodyBuf();
+        if (_parser.find(CONTENT_LENGTH_SV)) { // 存在content-length模式接收的响应体
+            // 长度已在 _checkBodyFraming 中解析
             if (*_remainingBodyLen != 0) {
-                *_remainingBodyLen -= buf.size();
-                co_await file.write(buf); // _body.append(buf);
-                _recvBuf.clear();
+                auto const n = std::min(buf.size(), *_remainingBodyLen);
+                *_remainingBodyLen -= n;
+                co_await file.write(buf.substr(0, n)); // _body.append(buf);
+                _keepBodyBuf(buf.substr(n)); // 之后的数据属于下一个请求 (流水线)
                 co_return *_remainingBodyLen;
             }
-        } else if (_requestHeaders.contains(TRANSFER_ENCODING_SV)) { // 存在请求体以`分块传输编码`
-            /**
-             * @todo 目前只支持 chunked 编码, 不支持压缩的 (2024-9-6 09:36:25) 
-             * */
-            if (_remainingBodyLen) { // 处理没有读取完的
-                if (buf.size() <= *_remainingBodyLen) { // 还没有读取完毕
-                    co_await file.write(buf); // _body.append(buf);
-                    *_remainingBodyLen -= buf.size();
-                    _recvBuf.clear();
-                    co_return IO::kBufMaxSize;
-                } else { // 读取完了
-                    co_await file.write(buf.substr(0, *_remainingBodyLen)); // _body.append(buf.substr(0, *_remainingBodyLen));
-                    buf = buf.substr(std::min(*_remainingBodyLen + 2, buf.size()));
-                    _remainingBodyLen.reset();
-                }
-            }
-            for (;;) {
-                std::size_t posLen = buf.find(CRLF);
-                if (posLen == std::string_view::npos) { // 没有读完
-                    _recvBuf.moveToHead(buf);
-                    co_return IO::kBufMaxSize;
-                }
-                if (!posLen && buf[0] == '\r') [[unlikely]] { // posLen == 0
-                    // \r\n 贴脸, 触发原因, std::min(*_remainingBodyLen + 2, buf.size()) 只能 buf.size()
-                    buf = buf.substr(posLen + 2);
-                    continue;
-                }
-                _remainingBodyLen = utils::NumericBaseConverter::strToNum<std::size_t, 16>(
-                    buf.substr(0, posLen)
-                ); // 转换为十进制整数
-                if (!*_remainingBodyLen) { // 解析完毕
-                    co_return 0;
-                }
-                buf = buf.substr(posLen + 2);
-                if (buf.size() <= *_remainingBodyLen) { // 没有读完
-                    co_await file.write(buf); // _body.append(buf);
-                    *_remainingBodyLen -= buf.size();
-                    _recvBuf.clear();
-                    co_return IO::kBufMaxSize;
+        } else if (_parser.find(TRANSFER_ENCODING_SV)) { // 存在请求体以`分块传输编码`
+            for (std::string_view data;;) {
+                switch (_nextChunk(buf, data)) {
+                    case ChunkStep::Data:
+                        co_await file.write(data); // _body.append(data);
+                        break;
+                    case ChunkStep::NeedMore:
+                        _keepBodyBuf(buf);
+                        _checkChunkBufSpace();
+                        co_return IO::kBufMaxSize;
+                    case ChunkStep::Done:
+                        _keepBodyBuf(buf); // 之后的数据属于下一个请求 (流水线)
+                        co_return 0;
                 }
-                co_await file.write(buf.substr(0, *_remainingBodyLen)); // _body.append(buf.substr(0, *_remainingBodyLen));
-                buf = buf.substr(*_remainingBodyLen + 2);
             }
         }
         co_return 0;
@@ -0,0 +1,400 @@
+#pragma once
+/*
+ * Copyright Heng_Xin. All rights reserved.
+ *
+ * @Author: Heng_Xin
+ * @Date: 2026-10-18 10:21:47
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *	  https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <bit>
+#include <span>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string_view>
+
+#include <HXLibs/net/protocol/http/Http.hpp>
+#include <HXLibs/net/protocol/http/Headers.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64)
+    #define HXLIBS_HTTP_SCAN_SSE2
+    #include <immintrin.h>
+    #if defined(__AVX2__)
+        #define HXLIBS_HTTP_SCAN_AVX2
+    #elif defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+        // 未以 -mavx2 编译时, 运行时检测 CPU 是否支持 AVX2
+        #define HXLIBS_HTTP_SCAN_AVX2
+        #define HXLIBS_HTTP_SCAN_AVX2_DISPATCH
+    #endif
+#endif
+
+namespace HX::net {
+
+namespace internal {
+
+/**
+ * @brief 标量版本: 返回 [p, end) 中第一个属于 Cs 的字符的位置, 找不到则返回 end
+ */
+template <char... Cs>
+inline char const* scanAnyScalar(char const* p, char const* end) noexcept {
+    for (; p != end; ++p) {
+        if (((*p == Cs) || ...)) {
+            return p;
+        }
+    }
+    return end;
+}
+
+#if defined(HXLIBS_HTTP_SCAN_SSE2)
+
+template <char C, char... Cs>
+inline __m128i eqAnySse2(__m128i v) noexcept {
+    __m128i const eq = _mm_cmpeq_epi8(v, _mm_set1_epi8(C));
+    if constexpr (sizeof...(Cs) > 0) {
+        return _mm_or_si128(eq, eqAnySse2<Cs...>(v));
+    } else {
+        return eq;
+    }
+}
+
+// SSE2 (x86-64 的基线指令集), 每次比较 16 字节
+template <char... Cs>
+inline char const* scanAnySse2(char const* p, char const* end) noexcept {
+    for (; end - p >= 16; p += 16) {
+        __m128i const eq = eqAnySse2<Cs...>(_mm_loadu_si128(reinterpret_cast<__m128i const*>(p)));
+        if (auto const m = static_cast<unsigned int>(_mm_movemask_epi8(eq))) {
+            return p + std::countr_zero(m);
+        }
+    }
+    return scanAnyScalar<Cs...>(p, end);
+}
+
+#endif // defined(HXLIBS_HTTP_SCAN_SSE2)
+
+#if defined(HXLIBS_HTTP_SCAN_AVX2)
+
+#if defined(HXLIBS_HTTP_SCAN_AVX2_DISPATCH)
+    #define HXLIBS_HTTP_SCAN_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+    #define HXLIBS_HTTP_SCAN_TARGET_AVX2
+#endif
+
+template <char C, char... Cs>
+HXLIBS_HTTP_SCAN_TARGET_AVX2 inline __m256i eqAnyAvx2(__m256i v) noexcept {
+    __m256i const eq = _mm256_cmpeq_epi8(v, _mm256_set1_epi8(C));
+    if constexpr (sizeof...(Cs) > 0) {
+        return _mm256_or_si256(eq, eqAnyAvx2<Cs...>(v));
+    } else {
+        return eq;
+    }
+}
+
+// AVX2, 每次比较 32 字节
+template <char... Cs>
+HXLIBS_HTTP_SCAN_TARGET_AVX2 inline char const* scanAnyAvx2(char const* p, char const* end) noexcept {
+    for (; end - p >= 32; p += 32) {
+        __m256i const eq = eqAnyAvx2<Cs...>(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(p)));
+        if (auto const m = static_cast<unsigned int>(_mm256_movemask_epi8(eq))) {
+            return p + std::countr_zero(m);
+        }
+    }
+    return scanAnySse2<Cs...>(p, end);
+}
+
+#undef HXLIBS_HTTP_SCAN_TARGET_AVX2
+
+#if defined(HXLIBS_HTTP_SCAN_AVX2_DISPATCH)
+inline bool const kCpuHasAvx2 = [] {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+}();
+#endif // defined(HXLIBS_HTTP_SCAN_AVX2_DISPATCH)
+
+#endif // defined(HXLIBS_HTTP_SCAN_AVX2)
+
+/**
+ * @brief 返回 [p, end) 中第一个属于 Cs 的字符的位置, 找不到则返回 end
+ * @note AVX2 > SSE2 > 标量, 按编译选项与运行时的 CPU 选择
+ */
+template <char... Cs>
+inline char const* scanAny(char const* p, char const* end) noexcept {
+#if defined(HXLIBS_HTTP_SCAN_AVX2_DISPATCH)
+    if (kCpuHasAvx2) [[likely]] {
+        return scanAnyAvx2<Cs...>(p, end);
+    }
+    return scanAnySse2<Cs...>(p, end);
+#elif defined(HXLIBS_HTTP_SCAN_AVX2)
+    return scanAnyAvx2<Cs...>(p, end);
+#elif defined(HXLIBS_HTTP_SCAN_SSE2)
+    return scanAnySse2<Cs...>(p, end);
+#else
+    return scanAnyScalar<Cs...>(p, end);
+#endif
+}
+
+} // namespace internal
+
+/**
+ * @brief 可增量解析的 HTTP/1.1 请求头 (请求行 + 请求头) 解析器
+ * @note 不复制任何数据: 请求方法 / 路径 / 协议版本 / 请求头都是指向缓冲区的视图.
+ *       数据分多次到达时, 从上一次停下的位置继续扫描, 不会重复扫描已经看过的字节.
+ *       两次 parse 之间缓冲区可以搬移 (只要已有的内容不变), 视图会随之重定位.
+ * @warning 会原地修改缓冲区: 键被转为小写, 折叠行 (obs-fold) 的换行被替换为空格
+ */
+class RequestHeadParser {
+public:
+    enum class Status : std::uint8_t {
+        Complete,   // 解析完毕
+        Partial,    // 数据不完整, 需要继续读取
+        Invalid,    // 不是合法的请求
+    };
+
+    RequestHeadParser() noexcept
+        : _base{}
+        , _method{}
+        , _path{}
+        , _version{}
+        , _headers{}
+        , _pos{}
+        , _scan{}
+        , _colon{kNpos}
+        , _state{State::RequestLine}
+    {}
+
+    RequestHeadParser& operator=(RequestHeadParser&&) noexcept = delete;
+
+    /**
+     * @brief 解析 (或继续解析) 请求头
+     * @param buf 到目前为止收到的全部数据
+     * @return Status
+     */
+    Status parse(std::span<char> buf) noexcept {
+        if (buf.data() != _base) {
+            rebase(buf.data());
+        }
+        char const* const end = _base + buf.size();
+        while (_state != State::Done) {
+            char* const line = _base + _pos;
+            char const* nl;
+            if (_state == State::RequestLine) {
+                nl = internal::scanAny<'\n'>(_base + _scan, end);
+                if (nl == end) {
+                    _scan = buf.size();
+                    return Status::Partial;
+                }
+                char const* const lineEnd = trimCR(line, nl);
+                if (lineEnd != line) {
+                    if (!parseRequestLine(line, lineEnd)) [[unlikely]] {
+                        return Status::Invalid;
+                    }
+                    _state = State::Headers;
+                } // else: 忽略请求行之前的空行 (RFC 9112 2.2)
+            } else {
+                nl = nullptr;
+                if (_colon == kNpos) {
+                    // 同一遍扫描中找到键值对的 ':' 或行尾
+                    char const* p = internal::scanAny<':', '\n'>(_base + _scan, end);
+                    if (p == end) {
+                        _scan = buf.size();
+                        return Status::Partial;
+                    }
+                    if (*p == ':') {
+                        _colon = static_cast<std::size_t>(p - _base);
+                        _scan = _colon + 1;
+                    } else {
+                        nl = p;
+                    }
+                }
+                if (!nl) {
+                    nl = internal::scanAny<'\n'>(_base + _scan, end);
+                    if (nl == end) {
+                        _scan = buf.size();
+                        return Status::Partial;
+                    }
+                }
+                char* const lineEnd = line + (trimCR(line, nl) - line);
+                if (lineEnd == line) {
+                    _state = State::Done; // 空行: 请求头结束
+                } else if (!parseHeaderLine(line, lineEnd)) [[unlikely]] {
+                    return Status::Invalid;
+                }
+                _colon = kNpos;
+            }
+            _pos = static_cast<std::size_t>(nl - _base) + 1;
+            _scan = _pos;
+        }
+        return Status::Complete;
+    }
+
+    /**
+     * @brief 缓冲区被搬移到 newBase 后, 重定位所有视图
+     * @param newBase
+     */
+    void rebase(char* newBase) noexcept {
+        auto move = [&](std::string_view& sv) {
+            if (sv.data()) {
+                sv = {newBase + (sv.data() - _base), sv.size()};
+            }
+        };
+        move(_method);
+        move(_path);
+        move(_version);
+        _headers.rebase(_base, _scan, newBase);
+        _base = newBase;
+    }
+
+    /**
+     * @brief 重置为初始状态 (保留内部数组的容量)
+     */
+    void reset() noexcept {
+        _base = nullptr;
+        _method = _path = _version = {};
+        _headers.clear();
+        _pos = _scan = 0;
+        _colon = kNpos;
+        _state = State::RequestLine;
+    }
+
+    bool isComplete() const noexcept {
+        return _state == State::Done;
+    }
+
+    /**
+     * @brief 请求头 (含最后的空行) 的总字节数, 其后即为请求体
+     * @warning 仅在 isComplete() 时有意义
+     */
+    std::size_t headLength() const noexcept {
+        return _pos;
+    }
+
+    std::string_view method() const noexcept {
+        return _method;
+    }
+
+    std::string_view path() const noexcept {
+        return _path;
+    }
+
+    std::string_view version() const noexcept {
+        return _version;
+    }
+
+    /**
+     * @brief 请求头 (键已转为小写, 值已去掉两端的空白)
+     */
+    HttpHeaders const& headers() const noexcept {
+        return _headers;
+    }
+
+    /**
+     * @brief 查找请求头 (key 不区分大小写)
+     * @param key
+     * @return std::optional<std::string_view> 同名的请求头有多个时, 返回第一个
+     */
+    std::optional<std::string_view> find(std::string_view key) const noexcept {
+        return _headers.get(key);
+    }
+
+private:
+    enum class State : std::uint8_t {
+        RequestLine,
+        Headers,
+        Done,
+    };
+
+    inline static constexpr std::size_t kNpos = static_cast<std::size_t>(-1);
+
+    static char const* trimCR(char const* line, char const* nl) noexcept {
+        return nl != line && nl[-1] == '\r' ? nl - 1 : nl;
+    }
+
+    static bool isOws(char c) noexcept {
+        return c == ' ' || c == '\t';
+    }
+
+    /**
+     * @brief 解析请求行: `METHOD SP PATH SP HTTP/x.y`
+     */
+    bool parseRequestLine(char const* line, char const* lineEnd) noexcept {
+        std::string_view const sv{line, static_cast<std::size_t>(lineEnd - line)};
+        auto const sp1 = sv.find(' ');
+        if (sp1 == 0 || sp1 == std::string_view::npos) [[unlikely]] {
+            return false;
+        }
+        auto const sp2 = sv.find(' ', sp1 + 1);
+        if (sp2 == sp1 + 1 || sp2 == std::string_view::npos) [[unlikely]] {
+            return false;
+        }
+        _method = sv.substr(0, sp1);
+        _path = sv.substr(sp1 + 1, sp2 - sp1 - 1);
+        _version = sv.substr(sp2 + 1);
+        return _version.starts_with("HTTP/");
+    }
+
+    /**
+     * @brief 解析一行请求头 (不含行尾的 CRLF)
+     */
+    bool parseHeaderLine(char* line, char* lineEnd) noexcept {
+        if (isOws(*line)) [[unlikely]] {
+            // 折叠行 (obs-fold): 接在上一个值的后面, 换行替换为空格 (RFC 9112 5.2)
+            if (_headers.empty()) {
+                return false;
+            }
+            auto const val = (_headers.end() - 1)->second;
+            char* const valBegin = _base + (val.data() - _base);
+            char* const valEnd = valBegin + val.size();
+            std::memset(valEnd, ' ', static_cast<std::size_t>(line - valEnd));
+            _headers.setLastView(trimOws(valBegin, lineEnd));
+            return true;
+        }
+        if (_colon == kNpos || _base + _colon >= lineEnd) [[unlikely]] {
+            return false;
+        }
+        char* const colon = _base + _colon;
+        if (colon == line || isOws(colon[-1])) [[unlikely]] {
+            return false; // 键为空, 或键与 ':' 之间有空白 (RFC 9112 5.1)
+        }
+        for (char* p = line; p != colon; ++p) {
+            *p = static_cast<char>(internal::toLower(static_cast<unsigned char>(*p)));
+        }
+        _headers.addView(
+            {line, static_cast<std::size_t>(colon - line)},
+            trimOws(colon + 1, lineEnd)
+        );
+        return true;
+    }
+
+    static std::string_view trimOws(char const* p, char const* end) noexcept {
+        while (p != end && isOws(*p)) {
+            ++p;
+        }
+        while (end != p && isOws(end[-1])) {
+            --end;
+        }
+        return {p, static_cast<std::size_t>(end - p)};
+    }
+
+    char* _base;                        // 最近一次传入的缓冲区
+    std::string_view _method;           // 请求方法
+    std::string_view _path;             // 请求路径
+    std::string_view _version;          // 协议版本
+    HttpHeaders _headers;               // 请求头 (指向缓冲区的视图)
+    std::size_t _pos;                   // 下一行的起始偏移
+    std::size_t _scan;                  // 当前行继续扫描的偏移
+    std::size_t _colon;                 // 当前行 ':' 的偏移 (kNpos 为未找到)
+    State _state;
+};
+
+} // namespace HX::net
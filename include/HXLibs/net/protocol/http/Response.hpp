@@ -19,12 +19,15 @@
  * */
 
 #include <string>
+#include <charconv>
+#include <memory>
 #include <string_view>
 #include <vector>
 #include <unordered_map>
 #include <optional>
 
 #include <HXLibs/net/protocol/http/Http.hpp>
+#include <HXLibs/net/protocol/http/Headers.hpp>
 #include <HXLibs/net/protocol/http/Status.hpp>
 #include <HXLibs/net/protocol/http/MimeType.hpp>
 #include <HXLibs/net/socket/IO.hpp>
@@ -144,14 +147,21 @@ public:
     explicit HttpResponse(IOType& io)
         : _recvBuf()
         , _statusLine()
+        , _resLine()
+        , _resLineBuf()
         , _responseHeaders()
         , _body()
-        , _responseHeadersIt(_responseHeaders.end())
+        , _bodyView()
+        , _sharedBody()
         , _sendBuf()
+        , _pendingBuf()
         , _io{io}
     {
         // @todo 如果在乎客户端的性能, 就封装为模板, 然后提供 bool, 然后 constexpr if 解决
-        _sendBuf.reserve(IO::kBufMaxSize);
+        if (!_io.hasBufRing()) {
+            // 使用提供缓冲区环时, 尽量不让空闲连接持有缓冲区, 故按需扩容
+            _sendBuf.reserve(IO::kBufMaxSize);
+        }
     }
 
 #if 0
@@ -244,10 +254,10 @@ public:
         //     throw std::runtime_error{"send timeout"};
         // }
         constexpr auto findValEq = [](
-            HeaderHashMap& headMap, auto&& k, auto const& v
+            HttpHeaders const& headMap, auto&& k, auto const& v
         ) constexpr noexcept -> bool {
             auto it = headMap.find(std::forward<decltype(k)>(k));
-            return it != headMap.end() && it->second.find(v) != std::string::npos;
+            return it != headMap.end() && it->second.find(v) != std::string_view::npos;
         };
         using namespace std::string_view_literals;
         // 校验是否满足 SSE 协议格式
@@ -257,6 +267,8 @@ public:
             throw std::runtime_error{"SSE protocol error"};
         }
         // 进行 SSE 解析, 只有 TCP close 才是 SSE 结束, 因为它默认不会结束. 需用户协议好 [done] data
+        // 长连接: 如果可以, 使用多发读取, 避免每次读取都提交 SQE + 链接超时
+        _io.enableMultishotRecv();
         SseEvent event;
         for (;;) {
             auto res = co_await _io.template recvLinkTimeout<Timeout>(
@@ -336,9 +348,14 @@ public:
      * @return ResponseData 
      */
     ResponseData makeResponseData() {
+        HeaderHashMap headers;
+        headers.reserve(_responseHeaders.size());
+        for (auto const& [k, v] : _responseHeaders) {
+            headers.try_emplace(std::string{k}, v); // 同名的响应头保留第一个
+        }
         return {
             std::stoi(_statusLine[StatusCode]),
-            std::move(_responseHeaders),
+            std::move(headers),
             std::move(_body)
         };
     }
@@ -358,13 +375,69 @@ public:
         return *this;
     }
 
+    /**
+     * @brief 设置响应码和共享的正文(html), 正文不复制
+     * @param status 
+     * @param content
+     * @return Response& 可链式调用
+     */
+    HttpResponse& setStatusAndContent(Status status, std::shared_ptr<std::string const> content) {
+        setResLine(status).setContentType(TEXT).setBody(std::move(content));
+        return *this;
+    }
+
     /**
      * @brief 发送已经设置的响应
+     * @note 对方已断开等写入错误不会抛出异常, 而是记录在 `ioError()` 中, 连接随后会被关闭
      * @return coroutine::Task<> 
      */
     coroutine::Task<> sendRes() {
         createResponseBuffer();
-        co_await _io.fullySend(_sendBuf);
+        auto const body = _bodyData();
+        if (_deferSend
+            && _pendingBuf.size() + _sendBuf.size() + body.size() <= IO::kBufMaxSize
+        ) {
+            // 流水线: 暂存, 与之后的响应一起写入 (见 flush)
+            utils::StringUtil::append(_pendingBuf, _sendBuf);
+            utils::StringUtil::append(_pendingBuf, body);
+            co_return;
+        }
+        int res;
+        if (_pendingBuf.empty()) [[likely]] {
+            // 响应头与响应体一起写入, 响应体不复制到 _sendBuf
+            res = co_await _io.tryFullySend(_sendBuf, body);
+        } else {
+            // 暂存的响应 + 本次的响应头 与 响应体一起写入
+            utils::StringUtil::append(_pendingBuf, _sendBuf);
+            res = co_await _io.tryFullySend(_pendingBuf, body);
+            _pendingBuf.clear();
+        }
+        if (res < 0) [[unlikely]] {
+            _ioError = res;
+        }
+    }
+
+    /**
+     * @brief 写出流水线中暂存的响应 (见 setDeferSend); 没有则什么也不做
+     * @note 与 sendRes 一致, 写入错误记录在 `ioError()` 中
+     * @return coroutine::Task<> 
+     */
+    coroutine::Task<> flush() {
+        if (_pendingBuf.empty()) [[likely]] {
+            co_return;
+        }
+        if (int res = co_await _io.tryFullySend(_pendingBuf); res < 0) [[unlikely]] {
+            _ioError = res;
+        }
+        _pendingBuf.clear();
+    }
+
+    /**
+     * @brief 获取最近一次 sendRes 的写入错误
+     * @return int 0 为无错误, 否则为负的错误码 (如 -EPIPE / -ECONNRESET)
+     */
+    int ioError() const noexcept {
+        return _ioError;
     }
 
     /**
@@ -373,6 +446,7 @@ public:
      */
     coroutine::Task<> useChunkedEncodingTransferFile(std::string_view filePath) {
         using namespace std::string_literals;
+        co_await flush();
         auto fileType = getMimeType(
             utils::FileUtils::getExtension(filePath)
         );
@@ -386,6 +460,7 @@ public:
         
         utils::AsyncFile file{_io};
         co_await file.open(filePath);
+        co_await _yield(coroutine::ResumePriority::Bulk); // 之后的读写作为批量传输
         try {
             std::vector<char> buf(utils::FileUtils::kBufMaxSize);
             // 读取文件
@@ -423,6 +498,7 @@ public:
             ; // _io.template send 会抛异常
         }
         co_await file.close();
+        co_await _yield(coroutine::ResumePriority::Latency);
     }
 
 #if defined(__GNUC__) && !defined(__clang__)
@@ -440,6 +516,7 @@ public:
     coroutine::Task<> useRangeTransferFile(RangeRequestView rrv, std::string_view filePath) {
         using namespace std::string_literals;
         using namespace std::string_view_literals;
+        co_await flush();
         // 解析请求的范围
         auto& type = rrv.reqType;
         auto fileType = getMimeType(
@@ -507,6 +584,7 @@ public:
                 
                 utils::AsyncFile file{_io};
                 co_await file.open(filePath);
+                co_await _yield(coroutine::ResumePriority::Bulk); // 之后的读写作为批量传输
                 try {
                     file.setOffset(beginPos);
                     std::vector<char> buf(std::min(fileSize, utils::FileUtils::kBufMaxSize));
@@ -529,6 +607,7 @@ public:
                     ;
                 }
                 co_await file.close();
+                co_await _yield(coroutine::ResumePriority::Latency);
             } else {
                 /*
                     HTTP/1.1 206 Partial Content\r\n
@@ -585,6 +664,7 @@ public:
 
                     utils::AsyncFile file{_io};
                     co_await file.open(filePath);
+                    co_await _yield(coroutine::ResumePriority::Bulk); // 之后的读写作为批量传输
                     try {
                         file.setOffset(beginPos);
                         std::vector<char> buf(utils::FileUtils::kBufMaxSize);
@@ -609,6 +689,7 @@ public:
                         ;
                     }
                     co_await file.close();
+                    co_await _yield(coroutine::ResumePriority::Latency);
                 }
                 co_await _io.fullySend("--BOUNDARY_STRING--\r\n"sv);
             }
@@ -622,6 +703,7 @@ public:
 
             utils::AsyncFile file{_io};
             co_await file.open(filePath);
+            co_await _yield(coroutine::ResumePriority::Bulk); // 之后的读写作为批量传输
             try {
                 std::vector<char> buf(std::min(fileSize, utils::FileUtils::kBufMaxSize));
                 uint64_t remaining = fileSize;
@@ -640,6 +722,7 @@ public:
                 ;
             }
             co_await file.close();
+            co_await _yield(coroutine::ResumePriority::Latency);
         }
     }
 
@@ -648,6 +731,7 @@ public:
 #endif
 
     coroutine::Task<internal::SseStream<IOType>> makeSseStream() {
+        co_await flush();
         // 组装必要的响应
         setResLine(Status::CODE_200);
         addHeader("Content-Type", "text/event-stream");
@@ -668,16 +752,22 @@ public:
      * @warning 不需要手动写`/r`或`/n`以及尾部的`/r/n`
      */
     HttpResponse& setResLine(Status statusCode, std::string_view describe = "") {
-        using namespace std::string_view_literals;
-        _statusLine.clear();
-        _statusLine.resize(3);
-        _statusLine[ResponseLineDataType::ProtocolVersion] = "HTTP/1.1";
-        _statusLine[ResponseLineDataType::StatusCode] = std::to_string(static_cast<int>(statusCode));
         if (!describe.size()) {
-            _statusLine[ResponseLineDataType::StatusMessage] = getStatusCodeDataStrView(statusCode);
-        } else {
-            _statusLine[ResponseLineDataType::StatusMessage] = describe;
+            // 常见的状态码: 直接使用编译期生成的状态行
+            _resLine = getStatusLineStrView(statusCode);
+            if (_resLine.size()) [[likely]] {
+                return *this;
+            }
+            describe = getStatusCodeDataStrView(statusCode);
         }
+        char code[16];
+        auto const codeEnd = std::to_chars(code, code + sizeof(code), static_cast<int>(statusCode)).ptr;
+        _resLineBuf.assign("HTTP/1.1 ");
+        _resLineBuf.append(code, codeEnd);
+        _resLineBuf += ' ';
+        _resLineBuf += describe;
+        _resLineBuf += CRLF;
+        _resLine = _resLineBuf;
         return *this;
     }
 
@@ -690,7 +780,7 @@ public:
      */
     HttpResponse& setContentType(HttpContentType type) {
         using namespace std::string_literals;
-        _responseHeaders["Content-Type"] = getContentTypeStrView(type);
+        _responseHeaders.setView("Content-Type", getContentTypeStrView(type));
         return *this;
     }
 
@@ -706,21 +796,59 @@ public:
             s += std::forward<S>(data);
         })
     HttpResponse& setBody(S&& data) noexcept {
+        _bodyView.reset();
+        _sharedBody.reset();
         _body.clear();
         _body += std::forward<S>(data);
         return *this;
     }
 
+    /**
+     * @brief 设置共享的不可变响应体 (如缓存的 JSON), 不复制, 持有所有权直到响应发送完毕
+     * @param data 响应体
+     * @return Response& 
+     */
+    HttpResponse& setBody(std::shared_ptr<std::string const> data) noexcept {
+        _body.clear();
+        _bodyView = data ? std::string_view{*data} : std::string_view{};
+        _sharedBody = std::move(data);
+        return *this;
+    }
+
+    /**
+     * @brief 借用响应体, 不复制
+     * @warning 调用者需保证 data 在 sendRes 完成之前有效 (如静态常量, 或端点捕获的启动时读入的资源)
+     * @param data 响应体
+     * @return Response& 
+     */
+    HttpResponse& setBodyView(std::string_view data) noexcept {
+        _sharedBody.reset();
+        _body.clear();
+        _bodyView = data;
+        return *this;
+    }
+
     /**
      * @brief 向响应头部添加一个键值对
      * @param key 键
      * @param val 值
      * @return Response&
-     * @warning `key`在`map`中是区分大小写的, 故不要使用`大小写不同`的相同的`键`
+     * @note 键不区分大小写, 已存在则覆盖
+     */
+    HttpResponse& addHeader(std::string_view key, std::string_view val) {
+        _responseHeaders.set(key, val);
+        return *this;
+    }
+
+    /**
+     * @brief 设置 sendRes 是否暂存响应: 流水线 (pipelining) 中之后还有已经收到的请求时,
+     *        响应先暂存, 由之后的 sendRes 或 flush 一起写入, 一批请求只需一次写入
+     * @note 由连接处理器设置; 暂存的响应总大小不超过 IO::kBufMaxSize, 超过时立即写入
+     * @param defer 
+     * @return Response& 
      */
-    template <typename Str>
-    HttpResponse& addHeader(const std::string& key, Str&& val) {
-        _responseHeaders[key] = std::forward<Str>(val);
+    HttpResponse& setDeferSend(bool defer) noexcept {
+        _deferSend = defer;
         return *this;
     }
     // ===== ↑服务端使用↑ =====
@@ -730,12 +858,20 @@ public:
      */
     void clear() noexcept {
         _statusLine.clear();
+        _resLine = {};
         _responseHeaders.clear();
         _body.clear();
-        _responseHeadersIt = _responseHeaders.end();
-        _sendBuf.clear();
+        _bodyView.reset();
+        _sharedBody.reset();
+        if (_io.hasBufRing()) {
+            _sendBuf = {}; // 空闲的连接不持有发送缓冲区
+        } else {
+            _sendBuf.clear();
+        }
         _completeResponseHeader = false;
         _completeBody = false;
+        _deferSend = false;
+        _ioError = 0;
     }
 
     /**
@@ -756,23 +892,27 @@ private:
     };
     
     /**
-     * @brief 仅用于读取时候写入的缓冲区
+     * @brief 仅用于读取时候写入的缓冲区 (第一次写入时才分配, 服务端不会使用)
      */
-    container::ArrayBuf<char, IO::kBufMaxSize> _recvBuf;
+    container::HeapArrayBuf<char, IO::kBufMaxSize> _recvBuf;
 
     // 注意: 他们的末尾并没有事先包含 \r\n, 具体在to_string才提供
-    std::vector<std::string> _statusLine; // 状态行
-    HeaderHashMap _responseHeaders;       // 响应头
+    std::vector<std::string> _statusLine; // [仅客户端] 解析得到的状态行
+    std::string_view _resLine;            // [仅服务端] 完整的状态行 (含 \r\n)
+    std::string _resLineBuf;              // [仅服务端] 自定义描述的状态行
+    HttpHeaders _responseHeaders;         // 响应头
     std::string _body;                    // 响应体
-
-    // 指向上一次解析的响应头的键值对; 无效时候指向 `.end()`
-    decltype(_responseHeaders)::iterator _responseHeadersIt; 
+    std::optional<std::string_view> _bodyView;    // [仅服务端] 借用或共享的响应体, 有值时代替 _body
+    std::shared_ptr<std::string const> _sharedBody; // [仅服务端] 共享的响应体的所有权
 
     std::vector<char> _sendBuf;                     // 用于发送数据的缓冲区
+    std::vector<char> _pendingBuf;                  // [仅服务端] 流水线中暂存的响应, clear() 不会清空
     std::optional<std::size_t> _remainingBodyLen;   // 仍需读取的请求体长度
     IOType& _io;
     bool _completeResponseHeader = false;           // 是否解析完成响应头
     bool _completeBody = false;                     // 是否解析完成响应体
+    bool _deferSend = false;                        // [仅服务端] sendRes 是否暂存响应
+    int _ioError = 0;                               // sendRes 的写入错误 (负的错误码)
 
     template <typename>
     friend class WebSocketFactory;
@@ -780,6 +920,20 @@ private:
     template <typename>
     friend class internal::SseStream;
 
+    /**
+     * @brief 让出事件循环, 之后以 priority 的优先级恢复 (见 EventLoop::yield)
+     */
+    auto _yield(coroutine::ResumePriority priority) noexcept {
+        return static_cast<coroutine::EventLoop&>(_io).yield(priority);
+    }
+
+    /**
+     * @brief [仅服务端] 将要发送的响应体
+     */
+    std::string_view _bodyData() const noexcept {
+        return _bodyView ? *_bodyView : std::string_view{_body};
+    }
+
     /**
      * @brief [仅服务端] 生成响应行和响应头
      */
@@ -791,23 +945,26 @@ private:
             throw std::runtime_error{"There shouldn't be this exception"};
         }
 #endif
-        using namespace std::string_literals;
         using namespace std::string_view_literals;
-        _responseHeaders.try_emplace("Connection", "keep-alive"); // 长连接
-        _responseHeaders.try_emplace("Server", "HXLibs::net");
-        
-        utils::StringUtil::append(_sendBuf, _statusLine[ResponseLineDataType::ProtocolVersion]);
-        utils::StringUtil::append(_sendBuf, " "sv);
-        utils::StringUtil::append(_sendBuf, _statusLine[ResponseLineDataType::StatusCode]);
-        utils::StringUtil::append(_sendBuf, " "sv);
-        utils::StringUtil::append(_sendBuf, _statusLine[ResponseLineDataType::StatusMessage]);
-        utils::StringUtil::append(_sendBuf, CRLF);
+        utils::StringUtil::append(_sendBuf, _resLine);
         for (const auto& [key, val] : _responseHeaders) {
             utils::StringUtil::append(_sendBuf, key);
             utils::StringUtil::append(_sendBuf, HEADER_SEPARATOR_SV);
             utils::StringUtil::append(_sendBuf, val);
             utils::StringUtil::append(_sendBuf, CRLF);
         }
+        // 默认的响应头, 不插入 _responseHeaders
+        if (!_responseHeaders.contains(KnownHeader::Connection)) {
+            utils::StringUtil::append(_sendBuf, "Connection: keep-alive\r\n"sv); // 长连接
+        }
+        if (!_responseHeaders.contains(KnownHeader::Server)) {
+            utils::StringUtil::append(_sendBuf, "Server: HXLibs::net\r\n"sv);
+        }
+        if (!_responseHeaders.contains(KnownHeader::Date)) {
+            utils::StringUtil::append(_sendBuf, "Date: "sv);
+            utils::StringUtil::append(_sendBuf, utils::DateTimeFormat::cachedHttpDate());
+            utils::StringUtil::append(_sendBuf, CRLF);
+        }
         if constexpr (IsEnd) {
             utils::StringUtil::append(_sendBuf, CRLF);
         }
@@ -836,7 +993,7 @@ private:
     }
 
     /**
-     * @brief [仅服务端] 生成完整的响应字符串, 用于写入
+     * @brief [仅服务端] 生成完整的响应头 (含最后的空行), 响应体由 sendRes 随后一起写入
      * @warning 本方法子适用于`Content-Length`的短消息, 无法使用分块编码
      */
     void createResponseBuffer() {
@@ -844,12 +1001,11 @@ private:
         _sendBuf.clear();
         _buildResponseLineAndHeaders<false>();
         // 补充这个
+        char len[24];
+        auto const lenEnd = std::to_chars(len, len + sizeof(len), _bodyData().size()).ptr;
         utils::StringUtil::append(_sendBuf, "Content-Length: "sv);
-        utils::StringUtil::append(_sendBuf, std::to_string(_body.size()));
-        utils::StringUtil::append(_sendBuf, CRLF);
-
-        utils::StringUtil::append(_sendBuf, CRLF);
-        utils::StringUtil::append(_sendBuf, std::move(_body));
+        utils::StringUtil::append(_sendBuf, std::string_view{len, lenEnd});
+        utils::StringUtil::append(_sendBuf, HEADER_END_SV);
     }
 
     /**
@@ -907,14 +1063,16 @@ private:
                     auto p = utils::StringUtil::splitAtFirst(subKVStr, HEADER_SEPARATOR_SV);
                     if (p.first.empty()) {                  // 找不到 ": "
                         if (subKVStr.size()) [[unlikely]] { // 很少会有分片传输响应头的
-                            _responseHeadersIt->second.append(subKVStr);
+                            if (!_responseHeaders.empty()) {
+                                _responseHeaders.appendToLast(subKVStr);
+                            }
                         } else { // 请求头解析完毕!
                             _completeResponseHeader = true;
                         }
                     } else {
                         // K: V, 其中 V 是区分大小写的, 但是 K 是不区分的
                         utils::StringUtil::toLower(p.first);
-                        _responseHeadersIt = _responseHeaders.insert(p).first;
+                        _responseHeaders.add(p.first, p.second);
                     }
                     buf = buf.substr(pos + 2); // 再前进, 以去掉 "\r\n"
                 }
@@ -944,7 +1102,7 @@ private:
         if (_responseHeaders.contains(CONTENT_LENGTH_SV)) { // 存在content-length模式接收的响应体
             // 是 空行之后 (\r\n\r\n) 的内容大小(char)
             if (!_remainingBodyLen.has_value()) {
-                _remainingBodyLen = std::stoull(_responseHeaders.find(CONTENT_LENGTH_SV)->second);
+                _remainingBodyLen = std::stoull(std::string{*_responseHeaders.get(CONTENT_LENGTH_SV)});
             }
             if (*_remainingBodyLen != 0) {
                 *_remainingBodyLen -= buf.size();
@@ -1116,14 +1274,16 @@ private:
                     auto p = utils::StringUtil::splitAtFirst(subKVStr, HEADER_SEPARATOR_SV);
                     if (p.first.empty()) {                  // 找不到 ": "
                         if (subKVStr.size()) [[unlikely]] { // 很少会有分片传输响应头的
-                            _responseHeadersIt->second.append(subKVStr);
+                            if (!_responseHeaders.empty()) {
+                                _responseHeaders.appendToLast(subKVStr);
+                            }
                         } else { // 请求头解析完毕!
                             _completeResponseHeader = true;
                         }
                     } else {
                         // K: V, 其中 V 是区分大小写的, 但是 K 是不区分的
                         utils::StringUtil::toLower(p.first);
-                        _responseHeadersIt = _responseHeaders.insert(p).first;
+                        _responseHeaders.add(p.first, p.second);
                     }
                     buf = buf.substr(pos + 2); // 再前进, 以去掉 "\r\n"
                 }
@@ -1133,7 +1293,7 @@ private:
                 if (_responseHeaders.contains(CONTENT_LENGTH_SV)) { // 存在content-length模式接收的响应体
                     // 是 空行之后 (\r\n\r\n) 的内容大小(char)
                     if (!_remainingBodyLen.has_value()) {
-                        _remainingBodyLen = std::stoull(_responseHeaders.find(CONTENT_LENGTH_SV)->second);
+                        _remainingBodyLen = std::stoull(std::string{*_responseHeaders.get(CONTENT_LENGTH_SV)});
                     }
                     if (*_remainingBodyLen != 0) {
                         *_remainingBodyLen -= buf.size();
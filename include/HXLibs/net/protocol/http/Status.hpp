@@ -18,6 +18,8 @@
  * limitations under the License.
  */
 
+#include <array>
+#include <cstdint>
 #include <string_view>
 
 namespace HX::net {
@@ -164,5 +166,80 @@ inline constexpr std::string_view getStatusCodeDataStrView(Status statusCode) {
     return ""sv;
 }
 
-} // namespace HX::net
+namespace internal {
+
+inline constexpr int kStatusLineMinCode = 100;
+inline constexpr int kStatusLineMaxCode = 599;
+
+/**
+ * @brief 完整的状态行的长度, 如 "HTTP/1.1 200 OK\r\n"; 未知的状态码为 0
+ */
+constexpr std::size_t statusLineSize(int code) {
+    auto msg = getStatusCodeDataStrView(static_cast<Status>(code));
+    return msg.empty() ? 0 : sizeof("HTTP/1.1 200 \r\n") - 1 + msg.size();
+}
+
+inline constexpr std::size_t kStatusLinesSize = [] {
+    std::size_t n = 0;
+    for (int code = kStatusLineMinCode; code <= kStatusLineMaxCode; ++code) {
+        n += statusLineSize(code);
+    }
+    return n;
+}();
+
+/**
+ * @brief 编译期拼接好的全部状态行, 以及每个状态码在其中的 [偏移, 偏移 + 长度)
+ */
+struct StatusLineTable {
+    std::array<char, kStatusLinesSize> data;
+    std::array<std::uint16_t, kStatusLineMaxCode - kStatusLineMinCode + 2> offset;
+};
 
+inline constexpr StatusLineTable kStatusLineTable = [] {
+    StatusLineTable t{};
+    std::size_t pos = 0;
+    auto put = [&](std::string_view sv) {
+        for (char c : sv) {
+            t.data[pos++] = c;
+        }
+    };
+    for (int code = kStatusLineMinCode; code <= kStatusLineMaxCode; ++code) {
+        t.offset[static_cast<std::size_t>(code - kStatusLineMinCode)] = static_cast<std::uint16_t>(pos);
+        if (!statusLineSize(code)) {
+            continue;
+        }
+        put("HTTP/1.1 ");
+        char const digits[] = {
+            static_cast<char>('0' + code / 100),
+            static_cast<char>('0' + code / 10 % 10),
+            static_cast<char>('0' + code % 10),
+            ' ',
+        };
+        put({digits, sizeof(digits)});
+        put(getStatusCodeDataStrView(static_cast<Status>(code)));
+        put("\r\n");
+    }
+    t.offset.back() = static_cast<std::uint16_t>(pos);
+    return t;
+}();
+
+static_assert(kStatusLinesSize < 0xFFFF, "The status line table is too large");
+
+} // namespace internal
+
+/**
+ * @brief 获取状态码对应的完整状态行 (协议为 HTTP/1.1, 含结尾的 CRLF), 如 "HTTP/1.1 200 OK\r\n"
+ * @param statusCode 响应状态码
+ * @return constexpr std::string_view 未知的状态码返回空
+ */
+inline constexpr std::string_view getStatusLineStrView(Status statusCode) {
+    auto const code = static_cast<int>(statusCode);
+    if (code < internal::kStatusLineMinCode || code > internal::kStatusLineMaxCode) [[unlikely]] {
+        return {};
+    }
+    auto const i = static_cast<std::size_t>(code - internal::kStatusLineMinCode);
+    auto const& t = internal::kStatusLineTable;
+    return {t.data.data() + t.offset[i], static_cast<std::size_t>(t.offset[i + 1] - t.offset[i])};
+}
+
+} // namespace HX::net
@@ -31,6 +31,7 @@
 #include <HXLibs/reflection/json/JsonWrite.hpp>
 
 #include <random>
+#include <utility>
 
 namespace HX::net {
 
@@ -493,6 +494,8 @@ private:
     template <typename Timeout>
         requires(utils::HasTimeNTTP<Timeout>)
     coroutine::Task<std::optional<WebSocketPacket>> recvPacket() {
+        // 长连接且大部分时间空闲: 如果可以, 使用多发读取, 避免每次读取都提交 SQE + 链接超时
+        _io.enableMultishotRecv();
         WebSocketPacket packet;
         uint8_t head[2];
 /*
@@ -778,7 +781,7 @@ public:
         }
         if (auto it = headMap.find("connection");
             // 可能是 "keep-alive, Upgrade" 这种情况
-            it == headMap.end() || it->second.find("Upgrade") == std::string::npos
+            it == headMap.end() || it->second.find("Upgrade") == std::string_view::npos
         ) [[unlikely]] {
             co_await _res.setResLine(Status::CODE_416)
                         .sendRes();
@@ -794,15 +797,19 @@ public:
                     .addHeader("Connection", "keep-alive, Upgrade")
                     .addHeader("Upgrade", "websocket")
                     .addHeader("Sec-Websocket-Accept", 
-                               internal::webSocketSecretHash(wsKey->second))
+                               internal::webSocketSecretHash(std::string{wsKey->second}))
+                    .setDeferSend(false)
                     .sendRes();
+        if (_res.ioError()) [[unlikely]] {
+            throw std::system_error{-_res.ioError(), std::system_category()};
+        }
 
         co_return {_res._io, [&]{
             // 缓存迁移
             std::vector<char> buf;
             std::size_t n = _res._recvBuf.size();
             buf.resize(n);
-            auto* data = _res._recvBuf.data();
+            auto* data = std::as_const(_res._recvBuf).data();
             for (std::size_t i = 0, j = n - 1; i < n; ++i, --j) {
                 buf[i] = data[j];
             }
@@ -850,7 +857,7 @@ public:
         auto const& headMap = res.getHeaders();
         if (auto it = headMap.find("connection");
             // 仅要求包含 Upgrade 即可
-            it == headMap.end() || it->second.find("Upgrade") == std::string::npos
+            it == headMap.end() || it->second.find("Upgrade") == std::string_view::npos
         ) [[unlikely]] {
             throw std::runtime_error{
                 "Failed to create a websocket connection (Connection header invalid)"};
@@ -873,7 +880,7 @@ public:
             std::vector<char> buf;
             std::size_t n = res._recvBuf.size();
             buf.resize(n);
-            auto* data = res._recvBuf.data();
+            auto* data = std::as_const(res._recvBuf).data();
             for (std::size_t i = 0, j = n - 1; i < n; ++i, --j) {
                 buf[i] = data[j];
             }
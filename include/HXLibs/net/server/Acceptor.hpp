@@ -24,11 +24,14 @@
 #include <HXLibs/net/socket/AddressResolver.hpp>
 #include <HXLibs/net/router/Router.hpp>
 #include <HXLibs/net/server/ConnectionHandler.hpp>
+#include <HXLibs/net/server/HttpServerOptions.hpp>
+#include <HXLibs/net/server/LoopBalancer.hpp>
 #include <HXLibs/exception/ErrorHandlingTools.hpp>
 
 #if defined(__linux__)
     #include <netinet/in.h>
     #include <netinet/tcp.h> // TCP_NODELAY
+    #include <sched.h>          // sched_getcpu
 #endif
 
 #include <HXLibs/log/Log.hpp>
@@ -37,14 +40,24 @@ namespace HX::net {
 
 template <typename IOType>
 struct Acceptor {
+    /**
+     * @param balancer 连接均衡器 (nullptr 则不均衡, 连接由接受它的事件循环处理)
+     * @param loopIndex 本事件循环在均衡器中的槽位
+     */
     Acceptor(
         Router<IOType> const& router,
         coroutine::EventLoop& eventLoop,
-        AddressResolver::AddressInfo const& entry
+        AddressResolver::AddressInfo const& entry,
+        HttpServerOptions const& options,
+        LoopBalancer* balancer = nullptr,
+        std::size_t loopIndex = 0
     )
         : _router{router}
         , _eventLoop{eventLoop}
         , _entry{entry}
+        , _options{options}
+        , _balancer{balancer}
+        , _loopIndex{loopIndex}
     {}
 
     Acceptor& operator=(Acceptor&&) noexcept = delete;
@@ -53,18 +66,41 @@ struct Acceptor {
         requires(utils::HasTimeNTTP<Timeout>)
     coroutine::Task<> start(std::atomic_bool const& isRun) {
         auto serverFd = co_await makeServerFd();
+#if defined(__linux__)
+        if (_options.multishotAccept
+            && co_await multishotAccept<Timeout>(serverFd, isRun)
+        ) {
+            co_await _eventLoop.makeAioTask().prepClose(serverFd);
+            log::hxLog.debug("已退出...", serverFd);
+            co_return;
+        }
+#endif
         for (;;) [[likely]] {
-            auto fd = HXLIBS_CHECK_EVENT_LOOP((
-                co_await _eventLoop.makeAioTask().prepAccept(
-                    serverFd,
-                    nullptr,    // 如果需要, 可以 getpeername(fd, ...) 获取的说...
-                    nullptr,
-                    0
-                )
-            ));
-            log::hxLog.debug("有新的连接:", fd);
-            ConnectionHandler<IOType>::template
-                start<Timeout>(fd, isRun, _router, _eventLoop).detach();
+#if defined(__linux__)
+            if (!_balancer && _eventLoop.getEventDrive().hasFreeFixedFile()) {
+                // 直接接受到注册文件表中, 之后的读写不再需要内核查找 fd
+                auto index = HXLIBS_CHECK_EVENT_LOOP((
+                    co_await _eventLoop.makeAioTask().prepAcceptDirect(
+                        serverFd,
+                        nullptr,
+                        nullptr,
+                        0
+                    )
+                ));
+                onAccept<Timeout>(FixedSocketFd{index}, isRun);
+            } else
+#endif
+            {
+                auto fd = HXLIBS_CHECK_EVENT_LOOP((
+                    co_await _eventLoop.makeAioTask().prepAccept(
+                        serverFd,
+                        nullptr,    // 如果需要, 可以 getpeername(fd, ...) 获取的说...
+                        nullptr,
+                        0
+                    )
+                ));
+                onAccept<Timeout>(fd, isRun);
+            }
             if (!isRun.load(std::memory_order_acquire)) [[unlikely]] {
                 break;  // 最在乎性能的关闭方式是, 关闭时候通过请求来解决 prepAccept 的阻塞
                         // 而不是写一个 whenAny 然后再写很复杂的逻辑什么的, 它浪费性能, 并且不是永远必须的
@@ -76,6 +112,118 @@ struct Acceptor {
     }
 
 private:
+    /**
+     * @brief 为新的连接启动处理协程
+     * @tparam Fd SocketFdType 或 FixedSocketFd
+     */
+    template <typename Timeout, typename Fd>
+        requires(utils::HasTimeNTTP<Timeout>)
+    void onAccept(Fd fd, std::atomic_bool const& isRun) {
+#if defined(__linux__)
+        if constexpr (std::is_same_v<Fd, FixedSocketFd>) {
+            _eventLoop.getEventDrive().installFixedFile();
+            log::hxLog.debug("有新的连接 (fixed):", fd.index);
+        } else
+#endif
+        {
+            log::hxLog.debug("有新的连接:", fd);
+            if (_balancer) {
+                onBalancedAccept<Timeout>(fd, isRun);
+                return;
+            }
+        }
+        ConnectionHandler<IOType>::template
+            start<Timeout>(fd, isRun, _router, _eventLoop, _options).detach();
+    }
+
+    /**
+     * @brief 将新的连接交给活跃连接数最少的事件循环; 本事件循环最空闲 (或目标已注销) 时自己处理
+     */
+    template <typename Timeout>
+        requires(utils::HasTimeNTTP<Timeout>)
+    void onBalancedAccept(SocketFdType fd, std::atomic_bool const& isRun) {
+        if (auto const idx = _balancer->pick(_loopIndex);
+            idx != _loopIndex
+            && _balancer->handoff(idx, fd, [&router = _router, &options = _options, &isRun](
+                coroutine::EventLoop& loop, SocketFdType fd, std::atomic_size_t& active
+            ) {
+                ConnectionHandler<IOType>::template
+                    start<Timeout>(fd, isRun, router, loop, options, &active).detach();
+            })
+        ) {
+            return;
+        }
+        auto& active = _balancer->active(_loopIndex);
+        active.fetch_add(1, std::memory_order_relaxed);
+        ConnectionHandler<IOType>::template
+            start<Timeout>(fd, isRun, _router, _eventLoop, _options, &active).detach();
+    }
+
+#if defined(__linux__)
+    /**
+     * @brief 使用多发 accept 接受连接: 一次提交, 持续产生新连接
+     * @note 注册文件表有空位时, 直接接受到注册文件表中; 快满时取消并改用普通 fd,
+     *       直到空出一半的槽位再切换回来. 开启连接均衡时总是使用普通 fd
+     * @return true 服务器已停止
+     * @return false 内核不支持多发 accept, 需要回退
+     */
+    template <typename Timeout>
+        requires(utils::HasTimeNTTP<Timeout>)
+    coroutine::Task<bool> multishotAccept(SocketFdType serverFd, std::atomic_bool const& isRun) {
+        auto& drive = _eventLoop.getEventDrive();
+        // 取消多发请求生效之前, 内核仍可能继续接受连接, 需要为其预留槽位
+        auto const reserve = drive.fixedFiles() / 16 + 1;
+        for (bool isFirst = true; ; ) {
+            bool const isDirect = !_balancer && drive.hasFreeFixedFile(reserve);
+            auto acceptTask = _eventLoop.makeMultishotAioTask();
+            if (isDirect) {
+                acceptTask.prepMultishotAcceptDirect(serverFd, nullptr, nullptr, 0);
+            } else {
+                acceptTask.prepMultishotAccept(serverFd, nullptr, nullptr, 0);
+            }
+            while (acceptTask.hasMore()) {
+                int res = co_await acceptTask;
+                if (res == -EINVAL && isFirst) [[unlikely]] {
+                    co_return false;
+                }
+                if (res == -ENFILE && isDirect) [[unlikely]] {
+                    // 预留的槽位也被占满了, 该连接已被内核丢弃
+                    log::hxLog.warning("fixed file table is full, connection dropped");
+                    break;
+                }
+                if (res < 0 && !acceptTask.hasMore()) [[unlikely]] {
+                    // 内核在出错 (如 fd 耗尽) 时会终止多发请求, 此时需要重新提交;
+                    // fd 耗尽时稍等片刻, 让已有的连接释放 fd, 避免立即再次失败
+                    log::hxLog.warning("multishot accept terminated, rearm:", -res);
+                    if (res == -EMFILE || res == -ENFILE) {
+                        co_await _eventLoop.makeTimer().sleepFor(std::chrono::milliseconds{10});
+                    }
+                    if (!isRun.load(std::memory_order_acquire)) [[unlikely]] {
+                        co_return true;
+                    }
+                    break;
+                }
+                auto fd = HXLIBS_CHECK_EVENT_LOOP(res);
+                isFirst = false;
+                if (isDirect) {
+                    onAccept<Timeout>(FixedSocketFd{fd}, isRun);
+                } else {
+                    onAccept<Timeout>(fd, isRun);
+                }
+                if (!isRun.load(std::memory_order_acquire)) [[unlikely]] {
+                    co_return true; // acceptTask 析构时会取消多发请求
+                }
+                if (isDirect
+                    ? !drive.hasFreeFixedFile(reserve)
+                    : !_balancer && drive.hasFreeFixedFile(drive.fixedFiles() / 2)
+                ) [[unlikely]] {
+                    break; // 切换 直接接受 / 普通 fd
+                }
+            }
+        }
+    }
+#endif
+
     coroutine::Task<SocketFdType> makeServerFd() {
 #if defined(__linux__)
         int serverFd = exception::IoUringErrorHandlingTools::check(
@@ -94,6 +242,12 @@ private:
         // 禁用 Nagle: 分多次 send 的响应 (如文件分块传输) 会与延迟 ACK 互锁,
         // 造成毫秒级停顿; Linux 上 accept 出的连接会继承监听套接字的该选项
         setsockopt(serverFd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+#if defined(SO_INCOMING_CPU)
+        // 已绑核: 同一 SO_REUSEPORT 组内, 内核优先把新连接交给 SO_INCOMING_CPU 与收包核相同的监听套接字
+        if (int cpu = ::sched_getcpu(); _options.cpuAffinity.enable && cpu >= 0) {
+            setsockopt(serverFd, SOL_SOCKET, SO_INCOMING_CPU, &cpu, sizeof(cpu));
+        }
+#endif
 
         exception::LinuxErrorHandlingTools::convertError<int>(
             ::bind(serverFd, serAddr._addr, serAddr._addrlen)
@@ -134,6 +288,9 @@ protected:
     Router<IOType> const& _router;
     coroutine::EventLoop& _eventLoop;
     AddressResolver::AddressInfo const& _entry;
+    HttpServerOptions const& _options;
+    LoopBalancer* _balancer;
+    std::size_t _loopIndex;
 };
 
 
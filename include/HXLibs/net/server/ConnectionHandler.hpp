@@ -25,6 +25,7 @@
 #include <HXLibs/net/socket/IO.hpp>
 #include <HXLibs/net/protocol/http/Request.hpp>
 #include <HXLibs/net/protocol/http/Response.hpp>
+#include <HXLibs/net/server/HttpServerOptions.hpp>
 
 #include <HXLibs/log/Log.hpp>
 
@@ -32,16 +33,25 @@ namespace HX::net {
 
 template <typename IOType>
 struct ConnectionHandler {
-    template <typename Timeout>
+    /**
+     * @brief 处理一个连接
+     * @tparam Fd SocketFdType 或 FixedSocketFd (注册文件表中的套接字)
+     * @param active 所在事件循环的活跃连接计数 (开启连接均衡时), 连接结束时减一
+     */
+    template <typename Timeout, typename Fd>
         requires(utils::HasTimeNTTP<Timeout>)
     static coroutine::RootTask<> start(
-        SocketFdType fd,
+        Fd fd,
         std::atomic_bool const& isRun,
         Router<IOType> const& router,
-        coroutine::EventLoop& eventLoop
+        coroutine::EventLoop& eventLoop,
+        HttpServerOptions const& options,
+        std::atomic_size_t* active = nullptr
     ) {
         using namespace std::string_view_literals;
         IOType io{fd, eventLoop};
+        io.setZeroCopySendThreshold(options.zeroCopySendThreshold);
+        io.setConnectionDeadline(options.connectionDeadline);
         try {
 #if defined(HXLIBS_ENABLE_SSL)
             if constexpr (std::is_same_v<IOType, HttpsIO>) {            
@@ -57,22 +67,39 @@ struct ConnectionHandler {
                     if (!co_await req.template parserReqHead<Timeout>()) [[unlikely]] {
                         break;
                     }
+                    // 流水线: 请求体之后已经收到了下一个完整的请求时, 响应先暂存, 与之后的响应一起写入
+                    bool const pipelined = req.hasPipelinedRequest();
+                    res.setDeferSend(pipelined);
                     // 路由
                     co_await router.getEndpoint(
                         req.getReqType(), 
                         req.getReqPath()
                     )(req, res);
+                    if (!pipelined) {
+                        // 在读完未读取的请求体 (clear) 之前, 先写出响应
+                        co_await res.flush();
+                    }
                     // 只要不是明确写 close 的, 我就复用连接 (keep-alive)
-                    if (auto it = req.getHeaders().find(CONNECTION_SV);
-                        (it != req.getHeaders().end() && it->second == "close"sv)
+                    // 写入出错 (对方已断开) 时, 不再复用
+                    if (auto conn = req.getHeader(CONNECTION_SV);
+                        res.ioError()
+                        || (conn && *conn == "close"sv)
                         || !isRun.load(std::memory_order_acquire)
                     ) [[unlikely]] {
                         break;
                     }
                     // 写 (由端点内部完成)
                     // 清空
-                    co_await req.clear();
+                    if (!co_await req.clear()) [[unlikely]] {
+                        break;
+                    }
                     res.clear();
+                    // 下一个请求需要等待读取: 先写出这一批暂存的响应
+                    if (!req.hasBufferedRequest()) {
+                        if (co_await res.flush(); res.ioError()) [[unlikely]] {
+                            break;
+                        }
+                    }
                 }
             } catch (std::exception const& err) {
                 // ps: 连接被对方重置 说明对方已经关闭连接, 而我还在等待读取, 这时候会异常, 可以忽视
@@ -80,11 +107,16 @@ struct ConnectionHandler {
             } catch (...) {
                 log::hxLog.error("发生未知错误!");
             }
+            // 关闭连接前, 写出暂存的响应
+            co_await res.flush();
         } catch (std::exception const& err) {
             log::hxLog.warning("已经开启Https, 不支持普通Http请求:", err.what());
         }
         log::hxLog.debug("连接已断开");
         co_await io.close();
+        if (active) {
+            active->fetch_sub(1, std::memory_order_relaxed);
+        }
         co_return;
     }
 };
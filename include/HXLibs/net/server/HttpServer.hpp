@@ -21,6 +21,8 @@
 #include <HXLibs/net/router/Router.hpp>
 #include <HXLibs/net/socket/AddressResolver.hpp>
 #include <HXLibs/net/server/Acceptor.hpp>
+#include <HXLibs/net/server/HttpServerOptions.hpp>
+#include <HXLibs/net/server/LoopBalancer.hpp>
 #include <HXLibs/net/client/HttpClient.hpp>
 #include <HXLibs/coroutine/loop/EventLoop.hpp>
 #include <HXLibs/container/FutureResult.hpp>
@@ -39,7 +41,10 @@ public:
      */
     HttpBaseServer(std::uint16_t port)
         : _router{}
+        , _options{}
+        , _threads{}
         , _asyncStopThread{}
+        , _balancer{}
         , _port{std::to_string(port)}
         , _runNum{0}
         , _isRun{true}
@@ -105,6 +110,7 @@ public:
      * @tparam Timeout 字面常量, 表示超时时间 (单位: 秒(s))
      * @param threadNum 线程数
      * @param timeout 超时时间 (使用类型 utils::TimeNTTP)
+     * @param options 服务器配置 (如每个线程的事件循环配置)
      */
     template <
         typename Timeout = decltype(30_s),
@@ -114,9 +120,10 @@ public:
     void syncRun(
         std::size_t threadNum = std::thread::hardware_concurrency(),
         Init&& init = Init{},
-        Timeout timeout = {}
+        Timeout timeout = {},
+        HttpServerOptions const& options = {}
     ) {
-        asyncRun(threadNum, std::forward<Init>(init), timeout);
+        asyncRun(threadNum, std::forward<Init>(init), timeout, options);
         _threads.clear();
     }
 
@@ -126,6 +133,7 @@ public:
      * @tparam Timeout 字面常量, 表示超时时间 (单位: 秒(s))
      * @param threadNum 线程数
      * @param timeout 超时时间 (使用类型 utils::TimeNTTP)
+     * @param options 服务器配置 (如每个线程的事件循环配置)
      */
     template <
         typename Timeout = decltype(30_s),
@@ -135,14 +143,28 @@ public:
     void asyncRun(
         std::size_t threadNum = std::thread::hardware_concurrency(),
         Init&& init = Init{},
-        Timeout = {}
+        Timeout = {},
+        HttpServerOptions const& options = {}
     ) {
         if (!_threads.empty()) [[unlikely]] {
             throw std::runtime_error{"The server is already running"};
         }
+        _options = options;
+#if defined(__linux__)
+        if (options.balanceConnections && threadNum > 1) {
+            _balancer = std::make_unique<LoopBalancer>(threadNum);
+        } else
+#endif
+        {
+            _balancer.reset();
+        }
         init();
+        auto const cpus = options.cpuAffinity.plan();
         for (std::size_t i = 0; i < threadNum; ++i) {
-            _threads.emplace_back([this] {
+            _threads.emplace_back([this, cpu = cpus.empty() ? -1 : cpus[i % cpus.size()]] {
+                if (cpu >= 0 && !utils::CpuAffinity::pinCurrentThread(cpu)) [[unlikely]] {
+                    log::hxLog.warning("绑核失败, cpu:", cpu);
+                }
                 _sync<Timeout>();
             });
         }
@@ -179,8 +201,10 @@ private:
     
 protected:
     Router<IOType> _router;
+    HttpServerOptions _options;
     std::vector<std::jthread> _threads;
     std::unique_ptr<std::jthread> _asyncStopThread; // 异步关闭服务器时候使用的线程
+    std::unique_ptr<LoopBalancer> _balancer;        // 连接均衡器 (未开启时为 nullptr)
     std::string _port;
     std::atomic_uint16_t _runNum;
     std::atomic_bool _isRun;
@@ -232,14 +256,17 @@ private:
         requires(utils::HasTimeNTTP<Timeout>)
     void _sync() {
         try {
-            coroutine::EventLoop _eventLoop;
+            coroutine::EventLoop _eventLoop{_options.eventLoop};
             AddressResolver addr;
             auto entry = addr.resolve("0.0.0.0", _port);
             ++_runNum;
-            Acceptor<HttpIO> acceptor{_router, _eventLoop, entry};
+            LoopBalancer::Registration reg{_balancer.get(), _eventLoop};
+            Acceptor<HttpIO> acceptor{
+                _router, _eventLoop, entry, _options, _balancer.get(), reg.index()};
             auto mainTask = acceptor.start<Timeout>(_isRun);
             _eventLoop.start(mainTask);
             _eventLoop.run();
+            reg.drain();
         } catch (std::exception const& ec) {
             log::hxLog.error("Server Error:", ec.what());
         }
@@ -304,14 +331,17 @@ private:
         requires(utils::HasTimeNTTP<Timeout>)
     void _sync() {
         try {
-            coroutine::EventLoop _eventLoop;
+            coroutine::EventLoop _eventLoop{_options.eventLoop};
             AddressResolver addr;
             auto entry = addr.resolve("0.0.0.0", _port);
             ++_runNum;
-            Acceptor<HttpsIO> acceptor{_router, _eventLoop, entry};
+            LoopBalancer::Registration reg{_balancer.get(), _eventLoop};
+            Acceptor<HttpsIO> acceptor{
+                _router, _eventLoop, entry, _options, _balancer.get(), reg.index()};
             auto mainTask = acceptor.start<Timeout>(_isRun);
             _eventLoop.start(mainTask);
             _eventLoop.run();
+            reg.drain();
         } catch (std::exception const& ec) {
             log::hxLog.error("Server Error:", ec.what());
         }
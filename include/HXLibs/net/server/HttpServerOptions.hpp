@@ -0,0 +1,52 @@
+#pragma once
+/*
+ * Copyright Heng_Xin. All rights reserved.
+ *
+ * @Author: Heng_Xin
+ * @Date: 2026-10-17 10:31:05
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *	  https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstddef>
+
+#include <HXLibs/coroutine/loop/EventLoopOptions.hpp>
+#include <HXLibs/utils/CpuAffinity.hpp>
+
+namespace HX::net {
+
+struct HttpServerOptions {
+    // 每个工作线程的事件循环配置
+    coroutine::EventLoopOptions eventLoop = {};
+
+    // 是否使用多发 accept (IORING_ACCEPT_MULTISHOT), 内核不支持时自动回退为逐个 accept (仅 Linux 有效)
+    bool multishotAccept = true;
+
+    // 单次发送的数据不小于该字节数时, 使用零拷贝发送 (IORING_OP_SEND_ZC), 0 则不使用 (仅 Linux 有效)
+    // 内核不支持时自动回退为普通发送
+    std::size_t zeroCopySendThreshold = 0;
+
+    // 使用连接级的截止时间代替每次读写的链接超时 (仅 Linux 有效):
+    // 每次读写只提交一个 SQE, 截止时间真正到达时才取消正在等待的读写
+    bool connectionDeadline = true;
+
+    // 连接均衡 (仅 Linux 有效): 各线程接受的连接交给活跃连接数最少的事件循环处理,
+    // 避免少数长连接的重负载集中在同一个线程上. 开启后不再直接接受到注册文件表中
+    bool balanceConnections = false;
+
+    // 工作线程绑核. 开启后 (Linux) 监听套接字还会设置 SO_INCOMING_CPU,
+    // 使内核把在某个核上收到的新连接交给绑定在该核上的线程, 连接的数据包与其协程留在同一个核上
+    utils::CpuAffinity cpuAffinity = {};
+};
+
+} // namespace HX::net
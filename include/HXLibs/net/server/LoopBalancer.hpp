@@ -0,0 +1,220 @@
+#pragma once
+/*
+ * Copyright Heng_Xin. All rights reserved.
+ *
+ * @Author: Heng_Xin
+ * @Date: 2026-10-17 21:06:32
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *	  https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <utility>
+
+#include <HXLibs/coroutine/loop/EventLoop.hpp>
+#include <HXLibs/net/socket/SocketFd.hpp>
+
+namespace HX::net {
+
+/**
+ * @brief 连接均衡器: 各工作线程 accept 到的连接, 交给活跃连接数最少的事件循环处理
+ * @note 交接通过目标事件循环的 `post` (无锁投递 + eventfd 唤醒) 完成, 只能交接普通 fd
+ *       (注册文件表是每个 io_uring 私有的). 每个事件循环在运行期间注册一个槽位;
+ *       注销时会等待正在进行的投递结束, 之后投递到该槽位的连接由投递方自己处理.
+ */
+struct LoopBalancer {
+    explicit LoopBalancer(std::size_t loopNum)
+        : _slots{std::make_unique<Slot[]>(loopNum)}
+        , _slotNum{loopNum}
+        , _nextIndex{0}
+    {}
+
+    LoopBalancer& operator=(LoopBalancer&&) noexcept = delete;
+
+    /**
+     * @brief 注册事件循环 (在该事件循环的线程中调用)
+     * @param loop
+     * @return std::size_t 槽位下标
+     */
+    std::size_t add(coroutine::EventLoop& loop) {
+        auto const idx = _nextIndex.fetch_add(1, std::memory_order_relaxed);
+        if (idx >= _slotNum) [[unlikely]] {
+            throw std::runtime_error{"LoopBalancer: too many event loops"};
+        }
+        _slots[idx]._loop.store(&loop, std::memory_order_seq_cst);
+        return idx;
+    }
+
+    /**
+     * @brief 注销事件循环, 返回后不会再有新的连接投递到它
+     * @note 之前已投递的连接仍在其队列中, 需要再 `run()` 一次事件循环以处理它们
+     * @param idx
+     */
+    void remove(std::size_t idx) noexcept {
+        auto& slot = _slots[idx];
+        slot._loop.store(nullptr, std::memory_order_seq_cst);
+        while (slot._posting.load(std::memory_order_seq_cst)) {
+            std::this_thread::yield();
+        }
+    }
+
+    /**
+     * @brief 选出活跃连接数最少的事件循环, 相同时优先选择 self (省去一次交接)
+     * @param self 当前事件循环的槽位
+     * @return std::size_t
+     */
+    std::size_t pick(std::size_t self) const noexcept {
+        auto best = self;
+        auto bestLoad = _slots[self]._active.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < _slotNum && bestLoad; ++i) {
+            auto const& slot = _slots[i];
+            if (i == self || !slot._loop.load(std::memory_order_relaxed)) {
+                continue;
+            }
+            if (auto load = slot._active.load(std::memory_order_relaxed); load < bestLoad) {
+                best = i;
+                bestLoad = load;
+            }
+        }
+        return best;
+    }
+
+    /**
+     * @brief 该槽位的活跃连接数 (连接交接前加一, 连接处理协程结束时减一)
+     * @param idx
+     * @return std::atomic_size_t&
+     */
+    std::atomic_size_t& active(std::size_t idx) noexcept {
+        return _slots[idx]._active;
+    }
+
+    /**
+     * @brief 将连接交给 idx 的事件循环处理
+     * @param idx
+     * @param fd 普通 fd
+     * @param start `void(coroutine::EventLoop&, SocketFdType, std::atomic_size_t&)`,
+     *              在目标事件循环的线程中启动连接处理协程
+     * @return true 已投递, fd 的所有权已转移
+     * @return false 目标事件循环已注销, 调用方需自行处理该连接
+     */
+    template <typename Start>
+    bool handoff(std::size_t idx, SocketFdType fd, Start start) {
+        auto& slot = _slots[idx];
+        slot._posting.fetch_add(1, std::memory_order_seq_cst);
+        auto* loop = slot._loop.load(std::memory_order_seq_cst);
+        if (!loop) [[unlikely]] {
+            slot._posting.fetch_sub(1, std::memory_order_seq_cst);
+            return false;
+        }
+        slot._active.fetch_add(1, std::memory_order_relaxed);
+        loop->post(Handoff<Start>{loop, fd, &slot._active, std::move(start)});
+        slot._posting.fetch_sub(1, std::memory_order_seq_cst);
+        return true;
+    }
+
+    /**
+     * @brief 事件循环在均衡器中的注册 (RAII), balancer 为 nullptr 时什么也不做
+     * @note 需要在事件循环之后构造, 以便先于事件循环析构
+     */
+    struct Registration {
+        Registration(LoopBalancer* balancer, coroutine::EventLoop& loop)
+            : _balancer{balancer}
+            , _loop{loop}
+            , _index{balancer ? balancer->add(loop) : 0}
+        {}
+
+        Registration& operator=(Registration&&) noexcept = delete;
+
+        std::size_t index() const noexcept {
+            return _index;
+        }
+
+        /**
+         * @brief 注销, 并运行事件循环处理注销前已交接过来的连接
+         */
+        void drain() {
+            if (_balancer) {
+                std::exchange(_balancer, nullptr)->remove(_index);
+                _loop.run();
+            }
+        }
+
+        ~Registration() noexcept {
+            if (_balancer) {
+                _balancer->remove(_index);
+            }
+        }
+
+    private:
+        LoopBalancer* _balancer;
+        coroutine::EventLoop& _loop;
+        std::size_t _index;
+    };
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<coroutine::EventLoop*> _loop{nullptr};
+        std::atomic_size_t _active{0};
+        std::atomic_size_t _posting{0};
+    };
+
+    /**
+     * @brief 投递到目标事件循环的连接; 未执行就被丢弃 (事件循环析构) 时关闭 fd
+     */
+    template <typename Start>
+    struct Handoff {
+        Handoff(coroutine::EventLoop* loop, SocketFdType fd, std::atomic_size_t* active, Start start)
+            : _loop{loop}
+            , _fd{fd}
+            , _active{active}
+            , _start{std::move(start)}
+        {}
+
+        Handoff(Handoff&& that) noexcept
+            : _loop{that._loop}
+            , _fd{that._fd}
+            , _active{std::exchange(that._active, nullptr)}
+            , _start{std::move(that._start)}
+        {}
+
+        Handoff& operator=(Handoff&&) noexcept = delete;
+
+        void operator()() {
+            _start(*_loop, _fd, *std::exchange(_active, nullptr));
+        }
+
+        ~Handoff() noexcept {
+            if (_active) [[unlikely]] {
+                _active->fetch_sub(1, std::memory_order_relaxed);
+#if defined(__linux__)
+                ::close(_fd);
+#elif defined(_WIN32)
+                ::closesocket(_fd);
+#endif
+            }
+        }
+
+        coroutine::EventLoop* _loop;
+        SocketFdType _fd;
+        std::atomic_size_t* _active;
+        Start _start;
+    };
+
+    std::unique_ptr<Slot[]> _slots;
+    std::size_t _slotNum;
+    std::atomic_size_t _nextIndex;
+};
+
+} // namespace HX::net
@@ -18,6 +18,12 @@
  * limitations under the License.
  */
 
+#include <array>
+#include <chrono>
+#include <memory>
+#include <cstring>
+#include <algorithm>
+
 #include <HXLibs/coroutine/task/Task.hpp>
 #include <HXLibs/coroutine/loop/EventLoop.hpp>
 #include <HXLibs/container/ArrayBuf.hpp>
@@ -46,6 +52,33 @@ auto* getTimePtr() noexcept {
     return &to;
 }
 
+/**
+ * @brief 多发读取的状态
+ */
+struct MultishotRecv {
+    coroutine::MultishotAioTask task;   // 一直挂在内核中的多发读取请求
+    coroutine::ProvidedBuffer buf{0};   // 尚未读完的缓冲区
+    std::size_t offset = 0;             // buf 中已经读取的字节数
+    bool hasData = false;               // 是否已经读到过数据 (用于判断内核是否支持)
+};
+
+/**
+ * @brief 连接的截止时间 (读与写各一个, 由同一个看门狗协程检查)
+ */
+struct Deadline {
+    std::chrono::steady_clock::time_point expire{}; // 截止时间
+    coroutine::AioTask* task = nullptr;             // 正在等待的任务 (无则为空)
+};
+
+#endif
+
+/**
+ * @brief 发送时使用的 flags: 对方已关闭时不产生 SIGPIPE, 而是返回 -EPIPE
+ */
+#if defined(__linux__)
+inline constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+inline constexpr int kSendFlags = 0;
 #endif
 
 } // namespace internal
@@ -60,18 +93,42 @@ public:
 
     HttpIO(coroutine::EventLoop& eventLoop)
         : _fd{kInvalidSocket}
+        , _isFixedFile{false}
+        , _zeroCopySendThreshold{0}
         , _eventLoop{eventLoop}
     {}
 
     HttpIO(SocketFdType fd, coroutine::EventLoop& eventLoop)
         : _fd{fd}
+        , _isFixedFile{false}
+        , _zeroCopySendThreshold{0}
         , _eventLoop{eventLoop}
     {}
 
+#if defined(__linux__)
+    /**
+     * @brief 使用注册文件表中的套接字, 读写时不再需要内核每次查找 fd
+     * @param fd 注册文件表的下标
+     * @param eventLoop 
+     */
+    HttpIO(FixedSocketFd fd, coroutine::EventLoop& eventLoop)
+        : _fd{fd.index}
+        , _isFixedFile{true}
+        , _zeroCopySendThreshold{0}
+        , _eventLoop{eventLoop}
+    {}
+#endif
+
     HttpIO& operator=(HttpIO&&) noexcept = delete;
 
     coroutine::Task<int> recv(std::span<char> buf) {
-        co_return co_await _eventLoop.makeAioTask().prepRecv(_fd, buf, 0);
+#if defined(__linux__)
+        if (_multishotRecv) {
+            co_return co_await _recvMultishot<void>(buf);
+        }
+#endif
+        co_return co_await _eventLoop.makeAioTask().prepRecv(_fd, buf, 0)
+                                                   .setFixedFile(_isFixedFile);
     }
 
     coroutine::Task<int> recv(std::span<char> buf, std::size_t n) {
@@ -116,12 +173,87 @@ public:
         coroutine::AioTask,
         decltype(std::declval<coroutine::AioTask>().prepLinkTimeout({}, {}))
     >> recvLinkTimeout(std::span<char> buf) {
+        if (_multishotRecv) {
+            int n = co_await _recvMultishot<Timeout>(buf);
+            coroutine::WhenAnyReturnType<
+                coroutine::AioTask,
+                decltype(std::declval<coroutine::AioTask>().prepLinkTimeout({}, {}))
+            > res;
+            if (n == -ETIME) [[unlikely]] {
+                res.template emplace<1>(n); // 超时
+            } else {
+                res.template emplace<0>(n);
+            }
+            co_return res;
+        }
+        if (_useDeadline) {
+            coroutine::AioTask task = _eventLoop.makeAioTask();
+            _beginDeadline<Timeout>(_recvDeadline, task);
+            int n = _endDeadline(_recvDeadline, co_await std::move(task)
+                .prepRecv(_fd, buf, 0)
+                .setFixedFile(_isFixedFile)
+                .setCancelable());
+            coroutine::WhenAnyReturnType<
+                coroutine::AioTask,
+                decltype(std::declval<coroutine::AioTask>().prepLinkTimeout({}, {}))
+            > res;
+            if (n == -ETIME) [[unlikely]] {
+                res.template emplace<1>(n); // 超时
+            } else {
+                res.template emplace<0>(n);
+            }
+            co_return res;
+        }
         co_return co_await coroutine::AioTask::linkTimeout(
-            _eventLoop.makeAioTask().prepRecv(_fd, buf, 0),
+            _eventLoop.makeAioTask().prepRecv(_fd, buf, 0)
+                                    .setFixedFile(_isFixedFile),
             _eventLoop.makeAioTask().prepLinkTimeout(
                 internal::getTimePtr<Timeout>(), 0)
         );
     }
+
+    /**
+     * @brief 读取数据, 由内核在数据到达时从提供缓冲区环中挑选缓冲区 (等待期间不占用任何缓冲区)
+     * @warning 需要 hasBufRing() 为 true; 返回的缓冲区应尽快处理并归还 (析构即归还)
+     * @tparam Timeout 超时时间
+     * @return coroutine::Task<coroutine::ProvidedBuffer> 超时则 `res() == -ETIME`
+     */
+    template <typename Timeout>
+        requires(utils::HasTimeNTTP<Timeout>)
+    coroutine::Task<coroutine::ProvidedBuffer> recvProvidedLinkTimeout() {
+        auto& bufRing = _eventLoop.getEventDrive().bufRing();
+        // 需要在完成后读取 cqe->flags, 故任务对象需要存活在当前协程帧中
+        coroutine::AioTask task = _eventLoop.makeAioTask();
+        int n;
+        if (_useDeadline) {
+            _beginDeadline<Timeout>(_recvDeadline, task);
+            n = _endDeadline(_recvDeadline, co_await std::move(task)
+                .prepRecvProvided(_fd, bufRing.group(), 0)
+                .setFixedFile(_isFixedFile)
+                .setCancelable());
+        } else {
+            auto res = co_await coroutine::AioTask::linkTimeout(
+                std::move(task).prepRecvProvided(_fd, bufRing.group(), 0)
+                               .setFixedFile(_isFixedFile),
+                _eventLoop.makeAioTask().prepLinkTimeout(
+                    internal::getTimePtr<Timeout>(), 0)
+            );
+            n = res.index() == 1
+                ? -ETIME
+                : res.template get<0, exception::ExceptionMode::Nothrow>();
+        }
+        if (n == -ETIME) [[unlikely]] {
+            co_return coroutine::ProvidedBuffer{-ETIME};
+        }
+        if (task.cqeFlags() & IORING_CQE_F_BUFFER) [[likely]] {
+            co_return coroutine::ProvidedBuffer{
+                bufRing,
+                static_cast<unsigned short>(task.cqeFlags() >> IORING_CQE_BUFFER_SHIFT),
+                n
+            };
+        }
+        co_return coroutine::ProvidedBuffer{n};
+    }
 #elif defined(_WIN32)
     template <typename Timeout>
         requires(utils::HasTimeNTTP<Timeout>)
@@ -141,21 +273,149 @@ public:
 #endif
 
     /**
-     * @brief 写入数据, 内部保证完全写入
+     * @brief 是否可以使用提供缓冲区环读取 (事件循环已注册, 且单个缓冲区不大于 kBufMaxSize)
+     * @return true 可以使用 recvProvidedLinkTimeout (仅 Linux)
+     */
+    bool hasBufRing() noexcept {
+#if defined(__linux__)
+        auto& bufRing = _eventLoop.getEventDrive().bufRing();
+        return bufRing.isEnabled() && bufRing.bufSize() <= kBufMaxSize;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief 开启多发读取: 之后的 recv / recvLinkTimeout 都从同一个多发读取请求中获取数据,
+     *        不再为每次读取提交 SQE 和链接超时 (超时改由事件循环的定时器处理).
+     *        适用于长时间存活且大部分时间空闲的连接 (如 WebSocket / SSE)
+     * @note 需要 hasBufRing(); 内核不支持时会自动回退为普通读取. close() 时自动取消
+     * @return true 已开启
+     */
+    bool enableMultishotRecv() {
+#if defined(__linux__)
+        if (!_multishotRecv && hasBufRing()) {
+            _armMultishotRecv();
+        }
+        return static_cast<bool>(_multishotRecv);
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief 是否正在使用多发读取
+     */
+    bool isMultishotRecv() const noexcept {
+#if defined(__linux__)
+        return static_cast<bool>(_multishotRecv);
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief 写入数据, 内部保证完全写入; 出错时不抛出异常
      * @param buf 
-     * @return coroutine::Task<> 
+     * @return coroutine::Task<int> 成功为 0, 否则为负的错误码 (如对方已断开: -EPIPE / -ECONNRESET)
      */
-    coroutine::Task<> fullySend(std::span<char const> buf) {
+    coroutine::Task<int> tryFullySend(std::span<char const> buf) {
+#if defined(__linux__)
+        if (_zeroCopySendThreshold && buf.size() >= _zeroCopySendThreshold) {
+            co_return co_await _tryFullySendZc(buf);
+        }
+#endif
         // io_uring 也不保证其可以完全一次性写入...
         while (!buf.empty()) {
-            auto sent = static_cast<std::size_t>(
-                HXLIBS_CHECK_EVENT_LOOP(
-                    co_await _eventLoop.makeAioTask()
-                                       .prepSend(_fd, buf, 0)
-                )
-            );
-            buf = buf.subspan(sent);
+            int res = co_await _eventLoop.makeAioTask()
+                                         .prepSend(_fd, buf, internal::kSendFlags)
+                                         .setFixedFile(_isFixedFile);
+            if (res < 0) [[unlikely]] {
+                co_return res;
+            }
+            buf = buf.subspan(static_cast<std::size_t>(res));
         }
+        co_return 0;
+    }
+
+    /**
+     * @brief 依次写入 head 与 body (一次系统调用写入两者, 不需要先拼接); 出错时不抛出异常
+     * @param head 
+     * @param body 
+     * @return coroutine::Task<int> 与 tryFullySend 一致
+     */
+    coroutine::Task<int> tryFullySend(std::span<char const> head, std::span<char const> body) {
+#if defined(__linux__)
+        if (_zeroCopySendThreshold && body.size() >= _zeroCopySendThreshold) {
+            // 大的 body 走零拷贝
+            if (int res = co_await tryFullySend(head); res < 0) [[unlikely]] {
+                co_return res;
+            }
+            co_return co_await tryFullySend(body);
+        }
+        std::array<::iovec, 2> iov{{
+            {const_cast<char*>(head.data()), head.size()},
+            {const_cast<char*>(body.data()), body.size()},
+        }};
+        std::span<::iovec> rest{iov};
+        ::msghdr msg{};
+        while (!rest.empty()) {
+            msg.msg_iov = rest.data();
+            msg.msg_iovlen = rest.size();
+            int res = co_await _eventLoop.makeAioTask()
+                                         .prepSendmsg(_fd, &msg, internal::kSendFlags)
+                                         .setFixedFile(_isFixedFile);
+            if (res < 0) [[unlikely]] {
+                co_return res;
+            }
+            // 跳过已经写完的部分
+            auto n = static_cast<std::size_t>(res);
+            while (!rest.empty() && n >= rest.front().iov_len) {
+                n -= rest.front().iov_len;
+                rest = rest.subspan(1);
+            }
+            if (n) {
+                rest.front().iov_base = static_cast<char*>(rest.front().iov_base) + n;
+                rest.front().iov_len -= n;
+            }
+        }
+        co_return 0;
+#else
+        if (int res = co_await tryFullySend(head); res < 0) [[unlikely]] {
+            co_return res;
+        }
+        co_return co_await tryFullySend(body);
+#endif // defined(__linux__)
+    }
+
+    /**
+     * @brief 写入数据, 内部保证完全写入
+     * @param buf 
+     * @return coroutine::Task<> 
+     */
+    coroutine::Task<> fullySend(std::span<char const> buf) {
+        HXLIBS_CHECK_EVENT_LOOP(co_await tryFullySend(buf));
+    }
+
+    /**
+     * @brief 设置零拷贝发送的阈值: fullySend 的数据不小于该值时, 使用零拷贝发送 (仅 Linux)
+     * @note 零拷贝需要内核锁定用户页并等待网卡发送完成的通知, 对小数据反而更慢; 0 则不使用
+     * @param threshold 字节数
+     */
+    void setZeroCopySendThreshold(std::size_t threshold) noexcept {
+        _zeroCopySendThreshold = threshold;
+    }
+
+    /**
+     * @brief 使用连接级的截止时间代替每次读写的链接超时 (仅 Linux):
+     *        xxxLinkTimeout 只提交读写本身的 SQE, 并将截止时间顺延;
+     *        由看门狗协程懒惰地检查, 截止时间真正到达时才取消 (IORING_OP_ASYNC_CANCEL) 正在等待的读写
+     * @param enable 
+     */
+    void setConnectionDeadline([[maybe_unused]] bool enable) noexcept {
+#if defined(__linux__)
+        _useDeadline = enable;
+#endif
     }
 
     /**
@@ -176,10 +436,26 @@ public:
         requires(utils::HasTimeNTTP<Timeout>)
     coroutine::Task<> sendLinkTimeout(std::span<char const> buf) {
 #if defined(__linux__)
+        if (_useDeadline) {
+            while (!buf.empty()) {
+                coroutine::AioTask task = _eventLoop.makeAioTask();
+                _beginDeadline<Timeout>(_sendDeadline, task);
+                int res = _endDeadline(_sendDeadline, co_await std::move(task)
+                    .prepSend(_fd, buf, internal::kSendFlags)
+                    .setFixedFile(_isFixedFile)
+                    .setCancelable());
+                if (res == -ETIME) [[unlikely]] {
+                    throw std::runtime_error{"is Timeout"}; // 超时了
+                }
+                buf = buf.subspan(static_cast<std::size_t>(HXLIBS_CHECK_EVENT_LOOP(res)));
+            }
+            co_return;
+        }
         // io_uring 也不保证其可以完全一次性写入...
         while (!buf.empty()) {
             auto res = co_await coroutine::AioTask::linkTimeout(
-                _eventLoop.makeAioTask().prepSend(_fd, buf, 0),
+                _eventLoop.makeAioTask().prepSend(_fd, buf, internal::kSendFlags)
+                                        .setFixedFile(_isFixedFile),
                 _eventLoop.makeAioTask().prepLinkTimeout(
                     internal::getTimePtr<Timeout>(), 0)
             );
@@ -227,6 +503,19 @@ public:
      * @return coroutine::Task<int> close的返回值
      */
     coroutine::Task<int> close() noexcept {
+#if defined(__linux__)
+        _multishotRecv.reset(); // 取消多发读取, 并归还尚未读完的缓冲区
+        _watchdog = {};         // 停止看门狗 (其定时器随协程帧析构而取消)
+        if (_isFixedFile) {
+            // 释放注册文件表的槽位
+            auto res = co_await _eventLoop.makeAioTask()
+                                           .prepCloseDirect(static_cast<unsigned int>(_fd));
+            _eventLoop.getEventDrive().releaseFixedFile();
+            _fd = kInvalidSocket;
+            _isFixedFile = false;
+            co_return res;
+        }
+#endif
         /// @todo 此处可能也需要特化 ckose ? 因为 win 下的超时实际上就已经close了(?)
         auto res = co_await _eventLoop.makeAioTask()
                                            .prepClose(_fd);
@@ -234,6 +523,14 @@ public:
         co_return res;
     }
 
+    /**
+     * @brief 是否为注册文件表中的套接字
+     * @return true 是, 此时 fd 为注册文件表的下标
+     */
+    bool isFixedFile() const noexcept {
+        return _isFixedFile;
+    }
+
     /**
      * @brief 绑定新的 fd
      * @warning 内部会把之前的 fd 给 close 了
@@ -270,8 +567,190 @@ public:
     }
 #endif // !NDEBUG
 private:
+#if defined(__linux__)
+    /**
+     * @brief 顺延截止时间, 并登记正在等待的任务; 看门狗未运行或需要提前醒来时, 重新启动看门狗
+     * @tparam Timeout 超时时间
+     * @param deadline 读或写的截止时间
+     * @param task 即将 co_await 的任务 (需要 setCancelable)
+     */
+    template <typename Timeout>
+    void _beginDeadline(internal::Deadline& deadline, coroutine::AioTask& task) {
+        deadline.expire = std::chrono::steady_clock::now()
+            + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                Timeout::StdChronoVal);
+        deadline.task = &task;
+        auto watchdog = static_cast<std::coroutine_handle<>>(_watchdog);
+        if (!watchdog || watchdog.done() || deadline.expire < _watchdogUntil) {
+            _watchdog = _deadlineWatchdog(); // 原协程帧析构时, 取消其定时器
+            _eventLoop.start(_watchdog);
+        }
+    }
+
+    /**
+     * @brief 任务完成, 注销正在等待的任务
+     * @param deadline 
+     * @param res 任务的结果
+     * @return int 被看门狗取消的则为 -ETIME
+     */
+    static int _endDeadline(internal::Deadline& deadline, int res) noexcept {
+        deadline.task = nullptr;
+        return res == -ECANCELED ? -ETIME : res;
+    }
+
+    /**
+     * @brief 看门狗: 睡到最早的截止时间; 醒来时若截止时间已被顺延, 则继续睡, 否则取消正在等待的任务
+     * @return coroutine::Task<> 没有正在等待的任务时结束, 下次读写时再启动
+     */
+    coroutine::Task<> _deadlineWatchdog() {
+        for (;;) {
+            auto const now = std::chrono::steady_clock::now();
+            auto next = std::chrono::steady_clock::time_point::max();
+            _checkDeadline(_recvDeadline, now, next);
+            _checkDeadline(_sendDeadline, now, next);
+            if (next == std::chrono::steady_clock::time_point::max()) {
+                co_return;
+            }
+            _watchdogUntil = next;
+            co_await _eventLoop.makeTimer().sleepUntil(next);
+        }
+    }
+
+    void _checkDeadline(
+        internal::Deadline& deadline,
+        std::chrono::steady_clock::time_point now,
+        std::chrono::steady_clock::time_point& next
+    ) {
+        if (!deadline.task) {
+            return;
+        }
+        if (deadline.expire <= now) {
+            _eventLoop.getEventDrive().cancel(*deadline.task);
+            deadline.task = nullptr;
+        } else {
+            next = std::min(next, deadline.expire);
+        }
+    }
+
+    void _armMultishotRecv() {
+        _multishotRecv.reset(new internal::MultishotRecv{_eventLoop.makeMultishotAioTask()});
+        _multishotRecv->task.prepMultishotRecv(
+            _fd, _eventLoop.getEventDrive().bufRing(), _isFixedFile);
+    }
+
+    /**
+     * @brief 零拷贝的完全写入, 每次写入都会等待通知 CQE, 因此返回后即可释放 buf
+     * @param buf 
+     * @return coroutine::Task<int> 与 tryFullySend 一致
+     */
+    coroutine::Task<int> _tryFullySendZc(std::span<char const> buf) {
+        while (!buf.empty()) {
+            int res = co_await _eventLoop.makeAioTask()
+                                         .prepSendZc(_fd, buf, internal::kSendFlags)
+                                         .setFixedFile(_isFixedFile);
+            if (res == -EINVAL || res == -EOPNOTSUPP) [[unlikely]] {
+                // 内核或套接字不支持零拷贝发送, 之后都使用普通发送
+                _zeroCopySendThreshold = 0;
+                co_return co_await tryFullySend(buf);
+            }
+            if (res < 0) [[unlikely]] {
+                co_return res;
+            }
+            buf = buf.subspan(static_cast<std::size_t>(res));
+        }
+        co_return 0;
+    }
+
+    /**
+     * @brief 从多发读取中获取数据
+     * @tparam Timeout 超时时间, void 则不超时
+     * @param buf [out] 
+     * @return coroutine::Task<int> 与 recv 一致; 超时则为 -ETIME
+     */
+    template <typename Timeout>
+    coroutine::Task<int> _recvMultishot(std::span<char> buf) {
+        for (;;) {
+            auto& ms = *_multishotRecv;
+            if (auto data = ms.buf.data(); ms.offset < data.size()) {
+                // 先读完上一次的缓冲区
+                auto n = std::min(buf.size(), data.size() - ms.offset);
+                std::memcpy(buf.data(), data.data() + ms.offset, n);
+                if ((ms.offset += n) == data.size()) {
+                    ms.buf.release();
+                }
+                co_return static_cast<int>(n);
+            }
+            if (!ms.task.hasMore()) {
+                // 内核已经终止了该多发请求 (如 -ENOBUFS 之后), 重新提交
+                _armMultishotRecv();
+                continue;
+            }
+            int res;
+            if constexpr (std::is_void_v<Timeout>) {
+                res = co_await ms.task;
+            } else {
+                if (ms.task.hasResult()) {
+                    res = co_await ms.task;
+                } else {
+                    auto r = co_await coroutine::whenAny(
+                        ms.task, _eventLoop.makeTimer().sleepFor(Timeout::StdChronoVal));
+                    if (r.index() == 1) [[unlikely]] {
+                        co_return -ETIME; // 超时, 多发请求仍然保持
+                    }
+                    res = r.template get<0, exception::ExceptionMode::Nothrow>();
+                }
+            }
+            if (res > 0) [[likely]] {
+                ms.hasData = true;
+                ms.buf = coroutine::ProvidedBuffer{
+                    _eventLoop.getEventDrive().bufRing(),
+                    static_cast<unsigned short>(ms.task.cqeFlags() >> IORING_CQE_BUFFER_SHIFT),
+                    res
+                };
+                ms.offset = 0;
+                continue;
+            }
+            if (res == -ENOBUFS || res == -ECANCELED) {
+                // 缓冲区环被借空, 多发请求已终止; 本次回退为普通读取, 下一次读取时再重新提交
+                break;
+            }
+            if (res == -EINVAL && !ms.hasData) [[unlikely]] {
+                // 内核不支持多发读取, 之后都使用普通读取
+                _multishotRecv.reset();
+                break;
+            }
+            co_return res; // 连接断开 或 出错
+        }
+        if constexpr (std::is_void_v<Timeout>) {
+            co_return co_await _eventLoop.makeAioTask().prepRecv(_fd, buf, 0)
+                                                       .setFixedFile(_isFixedFile);
+        } else {
+            auto res = co_await coroutine::AioTask::linkTimeout(
+                _eventLoop.makeAioTask().prepRecv(_fd, buf, 0)
+                                        .setFixedFile(_isFixedFile),
+                _eventLoop.makeAioTask().prepLinkTimeout(
+                    internal::getTimePtr<Timeout>(), 0)
+            );
+            if (res.index() == 1) [[unlikely]] {
+                co_return -ETIME;
+            }
+            co_return res.template get<0, exception::ExceptionMode::Nothrow>();
+        }
+    }
+#endif // defined(__linux__)
+
     SocketFdType _fd;
+    bool _isFixedFile;      // _fd 是否为注册文件表的下标
+    std::size_t _zeroCopySendThreshold; // 不小于该值的数据使用零拷贝发送 (0 则不使用)
     coroutine::EventLoop& _eventLoop;
+#if defined(__linux__)
+    std::unique_ptr<internal::MultishotRecv> _multishotRecv{}; // 多发读取 (未开启则为空)
+    internal::Deadline _recvDeadline{};                     // 读的截止时间
+    internal::Deadline _sendDeadline{};                     // 写的截止时间
+    std::chrono::steady_clock::time_point _watchdogUntil{}; // 看门狗下次醒来的时间
+    coroutine::Task<> _watchdog{};                          // 看门狗协程
+    bool _useDeadline = false;                              // 是否使用连接级的截止时间
+#endif
 };
 
 #ifdef HXLIBS_ENABLE_SSL
@@ -300,6 +779,20 @@ public:
         _ssl.get().reset();
     }
 
+    /**
+     * @brief 密文需要先经过 SSL 解密, 不使用提供缓冲区环
+     */
+    constexpr bool hasBufRing() const noexcept {
+        return false;
+    }
+
+    /**
+     * @brief 密文需要先经过 SSL 解密, 不使用多发读取
+     */
+    constexpr bool enableMultishotRecv() const noexcept {
+        return false;
+    }
+
     coroutine::Task<int> recv(std::span<char> buf) {
         int res = 0;
         for (;;) {
@@ -317,6 +810,9 @@ public:
             }
             // 继续尝试读取密文
             res = co_await Base::recv(buf);
+            if (res <= 0) [[unlikely]] {
+                co_return res; // 断开或出错
+            }
         }
         [[unlikely]] co_return res;
     }
@@ -356,14 +852,35 @@ public:
         co_return res;
     }
 
+    /**
+     * @brief 写入数据, 内部保证完全写入; 出错时不抛出异常
+     * @param buf 
+     * @return coroutine::Task<int> 成功为 0, 否则为负的错误码
+     */
+    coroutine::Task<int> tryFullySend(std::span<char const> buf) {
+        _ssl.get().writePlaintext(buf);
+        co_return co_await Base::tryFullySend(_ssl.get().readCiphertext());
+    }
+
+    /**
+     * @brief 依次写入 head 与 body (加密为一段密文后写入); 出错时不抛出异常
+     * @return coroutine::Task<int> 成功为 0, 否则为负的错误码
+     */
+    coroutine::Task<int> tryFullySend(std::span<char const> head, std::span<char const> body) {
+        _ssl.get().writePlaintext(head);
+        if (!body.empty()) {
+            _ssl.get().writePlaintext(body);
+        }
+        co_return co_await Base::tryFullySend(_ssl.get().readCiphertext());
+    }
+
     /**
      * @brief 写入数据, 内部保证完全写入
      * @param buf 
      * @return coroutine::Task<> 
      */
     coroutine::Task<> fullySend(std::span<char const> buf) {
-        _ssl.get().writePlaintext(buf);
-        co_await Base::fullySend(_ssl.get().readCiphertext());
+        HXLIBS_CHECK_EVENT_LOOP(co_await tryFullySend(buf));
     }
 
     /**
@@ -416,6 +933,11 @@ public:
             }
             // 继续尝试读取密文
             res = co_await Base::recvLinkTimeout<Timeout>(buf);
+            if (res.index() == 0
+                && get<0, exception::ExceptionMode::Nothrow>(res) <= 0
+            ) [[unlikely]] {
+                co_return res; // 断开或出错
+            }
         }
         co_return res;
     }
@@ -25,5 +25,17 @@ namespace HX::net {
 using platform::SocketFdType;
 using platform::kInvalidSocket;
 
+#if defined(__linux__)
+
+/**
+ * @brief 注册文件表 (io_uring fixed file) 中的套接字, 值为表的下标而不是 fd
+ * @note 对其的操作需要使用 IOSQE_FIXED_FILE, 关闭需要使用 close_direct
+ */
+struct FixedSocketFd {
+    int index;
+};
+
+#endif
+
 } // namespace HX::net
 
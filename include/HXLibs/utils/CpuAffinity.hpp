@@ -0,0 +1,210 @@
+#pragma once
+/*
+ * Copyright Heng_Xin. All rights reserved.
+ *
+ * @Author: Heng_Xin
+ * @Date: 2026-10-17 21:48:17
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *	  https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__linux__)
+    #include <sched.h>
+#elif defined(_WIN32)
+    #include <Windows.h>
+#endif
+
+namespace HX::utils {
+
+/**
+ * @brief 线程绑核配置: 第 i 个线程绑定到 `plan()[i % plan().size()]`
+ * @note 默认不绑核. 绑核后线程不再在核之间迁移, 保持缓存局部性并减少调度抖动
+ */
+struct CpuAffinity {
+    // 是否绑核
+    bool enable = false;
+
+    // 显式的 CPU 列表 (按顺序分配给各线程), 为空则使用本进程允许运行的全部 CPU
+    std::vector<int> cpus = {};
+
+    // 跳过的 CPU (如预留给网卡中断处理的核)
+    std::vector<int> reserved = {};
+
+    // 按 NUMA 节点轮流分配 (节点 0 的第一个核, 节点 1 的第一个核, ...), 否则按 CPU 编号顺序 (仅 Linux 有效)
+    bool numaSpread = false;
+
+    /**
+     * @brief 计算各线程依次绑定的 CPU 列表
+     * @return std::vector<int> 为空表示不绑核
+     */
+    std::vector<int> plan() const {
+        if (!enable) {
+            return {};
+        }
+        auto res = cpus.empty() ? allowedCpus() : cpus;
+        std::erase_if(res, [this](int cpu) {
+            return std::find(reserved.begin(), reserved.end(), cpu) != reserved.end();
+        });
+        if (numaSpread) {
+            res = spreadByNode(std::move(res));
+        }
+        return res;
+    }
+
+    /**
+     * @brief 将当前线程绑定到 cpu 上
+     * @param cpu
+     * @return true 成功
+     */
+    static bool pinCurrentThread(int cpu) noexcept {
+        if (cpu < 0) [[unlikely]] {
+            return false;
+        }
+#if defined(__linux__)
+        if (cpu >= CPU_SETSIZE) [[unlikely]] {
+            return false;
+        }
+        ::cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        return ::sched_setaffinity(0, sizeof(set), &set) == 0;
+#elif defined(_WIN32)
+        if (cpu >= static_cast<int>(sizeof(::DWORD_PTR) * 8)) [[unlikely]] {
+            return false;
+        }
+        return ::SetThreadAffinityMask(
+            ::GetCurrentThread(), ::DWORD_PTR{1} << cpu) != 0;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief 本进程允许运行的 CPU
+     * @return std::vector<int>
+     */
+    static std::vector<int> allowedCpus() {
+        std::vector<int> res;
+#if defined(__linux__)
+        ::cpu_set_t set;
+        CPU_ZERO(&set);
+        if (::sched_getaffinity(0, sizeof(set), &set) == 0) {
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                if (CPU_ISSET(cpu, &set)) {
+                    res.push_back(cpu);
+                }
+            }
+        }
+#elif defined(_WIN32)
+        ::DWORD_PTR processMask, systemMask;
+        if (::GetProcessAffinityMask(::GetCurrentProcess(), &processMask, &systemMask)) {
+            for (int cpu = 0; cpu < static_cast<int>(sizeof(::DWORD_PTR) * 8); ++cpu) {
+                if (processMask & (::DWORD_PTR{1} << cpu)) {
+                    res.push_back(cpu);
+                }
+            }
+        }
+#endif
+        return res;
+    }
+
+    /**
+     * @brief 解析内核的 CPU 列表格式, 如 `0-3,8,10-11`
+     * @param list
+     * @return std::vector<int>
+     */
+    static std::vector<int> parseCpuList(std::string_view list) {
+        std::vector<int> res;
+        while (!list.empty()) {
+            auto const comma = list.find(',');
+            auto item = list.substr(0, comma);
+            list = comma == std::string_view::npos ? std::string_view{} : list.substr(comma + 1);
+            auto toInt = [](std::string_view s) {
+                int v = 0;
+                for (char c : s) {
+                    if (c < '0' || c > '9') {
+                        break;
+                    }
+                    v = v * 10 + (c - '0');
+                }
+                return v;
+            };
+            if (item.empty() || item[0] < '0' || item[0] > '9') {
+                continue;
+            }
+            auto const dash = item.find('-');
+            int const first = toInt(item);
+            int const last = dash == std::string_view::npos ? first : toInt(item.substr(dash + 1));
+            for (int cpu = first; cpu <= last; ++cpu) {
+                res.push_back(cpu);
+            }
+        }
+        return res;
+    }
+
+private:
+    /**
+     * @brief 按 NUMA 节点交错排列: 同一节点内保持原有顺序, 不属于任何已知节点的 CPU 放在最后
+     */
+    static std::vector<int> spreadByNode(std::vector<int> cpuList) {
+#if defined(__linux__)
+        std::vector<std::vector<int>> nodes;
+        for (int node = 0; ; ++node) {
+            std::ifstream file{
+                "/sys/devices/system/node/node" + std::to_string(node) + "/cpulist"};
+            if (!file) {
+                break;
+            }
+            std::string line;
+            std::getline(file, line);
+            auto nodeCpus = parseCpuList(line);
+            std::vector<int> mine;
+            std::erase_if(cpuList, [&](int cpu) {
+                if (std::find(nodeCpus.begin(), nodeCpus.end(), cpu) != nodeCpus.end()) {
+                    mine.push_back(cpu);
+                    return true;
+                }
+                return false;
+            });
+            if (!mine.empty()) {
+                nodes.push_back(std::move(mine));
+            }
+        }
+        std::vector<int> res;
+        for (std::size_t i = 0; ; ++i) {
+            bool any = false;
+            for (auto const& node : nodes) {
+                if (i < node.size()) {
+                    res.push_back(node[i]);
+                    any = true;
+                }
+            }
+            if (!any) {
+                break;
+            }
+        }
+        res.insert(res.end(), cpuList.begin(), cpuList.end());
+        return res;
+#else
+        return cpuList;
+#endif
+    }
+};
+
+} // namespace HX::utils
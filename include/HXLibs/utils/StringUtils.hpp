@@ -19,6 +19,8 @@
  * */
 
 #include <cstdint>
+#include <cstdio>
+#include <ctime>
 #include <vector>
 #include <array>
 #include <string>
@@ -261,6 +263,37 @@ struct DateTimeFormat final {
      * @return std::string 
      */
     static std::string makeHttpDate() noexcept {
+        char buf[kHttpDateBufSize];
+        return std::string{buf, formatHttpDate(std::time(nullptr), buf)};
+    }
+
+    /**
+     * @brief 获取 http 头使用的当前时间, 同 makeHttpDate()
+     * @note 每个线程 (即每个事件循环) 缓存一份, 秒数变化时才重新格式化, 不分配内存
+     * @return std::string_view 有效至本线程下一次调用
+     */
+    static std::string_view cachedHttpDate() noexcept {
+        struct Cache {
+            std::time_t sec = -1;
+            std::size_t len = 0;
+            char buf[kHttpDateBufSize];
+        };
+        thread_local Cache cache{};
+        if (std::time_t now = std::time(nullptr); now != cache.sec) {
+            cache.len = formatHttpDate(now, cache.buf);
+            cache.sec = now;
+        }
+        return {cache.buf, cache.len};
+    }
+
+private:
+    inline static constexpr std::size_t kHttpDateBufSize = 30;
+
+    /**
+     * @brief 把 now 格式化为 http 头使用的时间
+     * @return std::size_t 写入的长度
+     */
+    static std::size_t formatHttpDate(std::time_t now, char (&buf)[kHttpDateBufSize]) noexcept {
         // Weekday 和 Month 的静态映射表
         static constexpr std::array<std::string_view, 7> kWeekDays{
             "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"
@@ -270,7 +303,6 @@ struct DateTimeFormat final {
             "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"
         };
 
-        std::time_t now = std::time(nullptr);
         std::tm tm_buf;
 #if defined(_WIN32)
         ::gmtime_s(&tm_buf, &now);
@@ -278,7 +310,6 @@ struct DateTimeFormat final {
         ::gmtime_r(&now, &tm_buf);
 #endif
 
-        char buf[30];
         int n = std::snprintf(buf, sizeof(buf),
             "%s, %02d %s %d %02d:%02d:%02d GMT",
             kWeekDays[static_cast<std::size_t>(tm_buf.tm_wday)].data(),
@@ -289,7 +320,7 @@ struct DateTimeFormat final {
             tm_buf.tm_min,
             tm_buf.tm_sec
         );
-        return std::string{buf, static_cast<size_t>(n)};
+        return static_cast<std::size_t>(n);
     }
 };
 
@@ -0,0 +1,43 @@
+#include <HXLibs/coroutine/loop/EventLoop.hpp>
+#include <HXLibs/log/Log.hpp>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+
+using namespace HX;
+using namespace std::chrono;
+
+TEST_CASE("io_uring 配置档") {
+    for (auto profile : {
+        coroutine::IoUringProfile::Default,
+        coroutine::IoUringProfile::SqPoll,
+        coroutine::IoUringProfile::SingleIssuer,
+        coroutine::IoUringProfile::CoopTaskRun
+    }) {
+        coroutine::EventLoopOptions options{};
+        options.profile = profile;
+        options.cqEntries = 4096;
+        coroutine::EventLoop loop{options};
+#if defined(__linux__)
+        // 内核不支持时会回退到 Default
+        auto real = loop.getEventDrive().profile();
+        CHECK((real == profile || real == coroutine::IoUringProfile::Default));
+        log::hxLog.info(coroutine::toString(profile), "->", coroutine::toString(real));
+#endif
+        auto res = loop.sync([&]() -> coroutine::Task<int> {
+            co_await loop.makeTimer().sleepFor(1ms);
+            co_return 1;
+        }());
+        CHECK(res == 1);
+    }
+}
+
+#if defined(__linux__)
+TEST_CASE("无法满足的配置会回退") {
+    coroutine::EventLoopOptions options{};
+    options.profile = coroutine::IoUringProfile::SqPoll;
+    options.sqThreadCpu = 1 << 20; // 不存在的 CPU
+    coroutine::EventLoop loop{options};
+    CHECK((loop.getEventDrive().profile() == coroutine::IoUringProfile::Default));
+}
+#endif
@@ -0,0 +1,129 @@
+#include <HXLibs/coroutine/loop/EventLoop.hpp>
+#include <HXLibs/log/Log.hpp>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+
+#if defined(__linux__)
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+using namespace HX;
+
+namespace {
+
+int makeListenFd(std::uint16_t& port) {
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    ::sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    ::socklen_t len = sizeof(addr);
+    REQUIRE(::bind(fd, reinterpret_cast<::sockaddr*>(&addr), len) == 0);
+    REQUIRE(::listen(fd, 64) == 0);
+    REQUIRE(::getsockname(fd, reinterpret_cast<::sockaddr*>(&addr), &len) == 0);
+    port = ntohs(addr.sin_port);
+    return fd;
+}
+
+void connectN(std::uint16_t port, int n) {
+    for (int i = 0; i < n; ++i) {
+        int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        ::sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        CHECK(::connect(fd, reinterpret_cast<::sockaddr*>(&addr), sizeof(addr)) == 0);
+        ::close(fd);
+    }
+}
+
+} // namespace
+
+TEST_CASE("多发 accept: 一个 SQE 接收多个连接") {
+    coroutine::EventLoop loop;
+    std::uint16_t port{};
+    int serverFd = makeListenFd(port);
+    std::jthread cli{[port] { connectN(port, 8); }};
+    int cnt = loop.sync([&]() -> coroutine::Task<int> {
+        auto acceptTask = loop.makeMultishotAioTask();
+        acceptTask.prepMultishotAccept(serverFd, nullptr, nullptr, 0);
+        int n = 0;
+        while (n < 8 && acceptTask.hasMore()) {
+            int fd = co_await acceptTask;
+            REQUIRE(fd >= 0);
+            ::close(fd);
+            ++n;
+        }
+        co_return n; // acceptTask 析构时会取消多发请求, 事件循环随后退出
+    }());
+    CHECK(cnt == 8);
+    ::close(serverFd);
+}
+
+TEST_CASE("多发 accept: 直接安装到注册文件表") {
+    coroutine::EventLoopOptions options{};
+    options.fixedFiles = 64;
+    coroutine::EventLoop loop{options};
+    REQUIRE(loop.getEventDrive().fixedFiles() == 64);
+    std::uint16_t port{};
+    int serverFd = makeListenFd(port);
+    std::jthread cli{[port] { connectN(port, 4); }};
+    loop.sync([&]() -> coroutine::Task<> {
+        auto acceptTask = loop.makeMultishotAioTask();
+        acceptTask.prepMultishotAcceptDirect(serverFd, nullptr, nullptr, 0);
+        for (int i = 0; i < 4; ++i) {
+            int slot = co_await acceptTask;
+            REQUIRE(slot >= 0);
+            CHECK(slot < 64);
+        }
+    }());
+    ::close(serverFd);
+}
+
+TEST_CASE("多发 accept: 析构时关闭已安装到注册文件表但未被消费的连接") {
+    coroutine::EventLoopOptions options{};
+    options.fixedFiles = 64;
+    coroutine::EventLoop loop{options};
+    REQUIRE(loop.getEventDrive().fixedFiles() == 64);
+    std::uint16_t port{};
+    int serverFd = makeListenFd(port);
+    std::vector<int> cliFds;
+    for (int i = 0; i < 4; ++i) {
+        int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        ::sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        REQUIRE(::connect(fd, reinterpret_cast<::sockaddr*>(&addr), sizeof(addr)) == 0);
+        ::timeval tv{2, 0};
+        ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        cliFds.push_back(fd);
+    }
+    loop.sync([&]() -> coroutine::Task<> {
+        {
+            auto acceptTask = loop.makeMultishotAioTask();
+            acceptTask.prepMultishotAcceptDirect(serverFd, nullptr, nullptr, 0);
+            int slot = co_await acceptTask;
+            REQUIRE(slot >= 0);
+            co_await loop.makeAioTask().prepCloseDirect(static_cast<unsigned int>(slot));
+            // 等待其余连接的 CQE 到达, 但不消费
+            co_await loop.makeTimer().sleepFor(std::chrono::milliseconds{100});
+        }
+        // 再转一轮, 使 close_direct 被提交
+        co_await loop.makeTimer().sleepFor(std::chrono::milliseconds{10});
+    }());
+    // 每个连接都被关闭了, 而不是一直占用槽位
+    for (int fd : cliFds) {
+        char c;
+        CHECK(::recv(fd, &c, 1, 0) == 0);
+        ::close(fd);
+    }
+    CHECK(loop.getEventDrive().hasFreeFixedFile(63));
+    ::close(serverFd);
+}
+
+#endif // defined(__linux__)
@@ -0,0 +1,114 @@
+#include <HXLibs/coroutine/loop/EventLoop.hpp>
+#include <HXLibs/log/Log.hpp>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+
+#if defined(__linux__)
+
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <array>
+#include <string>
+#include <string_view>
+
+using namespace HX;
+
+namespace {
+
+constexpr char const* kPath = "07_aio_chain.tmp";
+
+} // namespace
+
+TEST_CASE("链式任务: 写入后读取, 一次恢复") {
+    coroutine::EventLoop loop;
+    int fd = ::open(kPath, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    REQUIRE(fd >= 0);
+    std::string_view data = "hello chain";
+    std::array<char, 64> buf{};
+    auto res = loop.sync([&]() -> coroutine::Task<std::array<int, 2>> {
+        co_return co_await loop.makeAioChain<2>()
+            .add(loop.makeAioTask().prepWrite(fd, data, 0))
+            .add(loop.makeAioTask().prepRead(fd, buf, 0));
+    }());
+    CHECK(res[0] == static_cast<int>(data.size()));
+    CHECK(res[1] == static_cast<int>(data.size()));
+    CHECK(std::string_view{buf.data(), data.size()} == data);
+    ::close(fd);
+}
+
+TEST_CASE("链式任务: 打开到注册文件表, 读取, 关闭") {
+    coroutine::EventLoopOptions options{};
+    options.fixedFiles = 4;
+    coroutine::EventLoop loop{options};
+    REQUIRE(loop.getEventDrive().fixedFiles() == 4);
+    {
+        int fd = ::open(kPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        REQUIRE(::write(fd, "0123456789", 10) == 10);
+        ::close(fd);
+    }
+    std::array<char, 64> buf{};
+    auto res = loop.sync([&]() -> coroutine::Task<std::array<int, 3>> {
+        co_return co_await loop.makeAioChain<3>()
+            .add(loop.makeAioTask().prepOpenatDirect(AT_FDCWD, kPath, O_RDONLY, 0, 1))
+            .add(loop.makeAioTask().prepRead(1, buf, 10, 0).setFixedFile())
+            .add(loop.makeAioTask().prepCloseDirect(1));
+    }());
+    CHECK(res[0] == 0);
+    CHECK(res[1] == 10);
+    CHECK(res[2] == 0);
+    CHECK(std::string_view{buf.data(), 10} == "0123456789");
+
+    // 打开失败: 后续步骤被取消, 协程仍然只恢复一次
+    res = loop.sync([&]() -> coroutine::Task<std::array<int, 3>> {
+        co_return co_await loop.makeAioChain<3>()
+            .add(loop.makeAioTask().prepOpenatDirect(AT_FDCWD, "no/such/file", O_RDONLY, 0, 1))
+            .add(loop.makeAioTask().prepRead(1, buf, 0).setFixedFile())
+            .add(loop.makeAioTask().prepCloseDirect(1));
+    }());
+    CHECK(res[0] == -ENOENT);
+    CHECK(res[1] == -ECANCELED);
+    CHECK(res[2] == -ECANCELED);
+    ::unlink(kPath);
+}
+
+TEST_CASE("链式任务: SQ 将满时整条链仍在同一批中提交") {
+    coroutine::EventLoopOptions options{};
+    options.entries = 4;
+    coroutine::EventLoop loop{options};
+    int fd = ::open(kPath, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    REQUIRE(fd >= 0);
+    int listenFd = ::socket(AF_INET, SOCK_STREAM, 0);
+    ::sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    REQUIRE(::bind(listenFd, reinterpret_cast<::sockaddr*>(&addr), sizeof(addr)) == 0);
+    REQUIRE(::listen(listenFd, 8) == 0);
+    std::array<char, 8> buf{};
+    auto ok = loop.sync([&]() -> coroutine::Task<int> {
+        // 先占用 SQ 中的 2 个位置 (尚未提交), 长度为 3 的链需要先提交它们
+        auto a1 = loop.makeMultishotAioTask();
+        a1.prepMultishotAccept(listenFd, nullptr, nullptr, 0);
+        auto a2 = loop.makeMultishotAioTask();
+        a2.prepMultishotAccept(listenFd, nullptr, nullptr, 0);
+        int okCnt = 0;
+        for (int i = 0; i < 16; ++i) {
+            auto [w1, w2, r] = co_await loop.makeAioChain<3>()
+                .add(loop.makeAioTask().prepWrite(fd, std::string_view{"ab"}, 0))
+                .add(loop.makeAioTask().prepWrite(fd, std::string_view{"cd"}, 2))
+                .add(loop.makeAioTask().prepRead(fd, buf, 0));
+            okCnt += w1 == 2 && w2 == 2 && r == 4
+                  && std::string_view{buf.data(), 4} == "abcd";
+        }
+        co_return okCnt;
+    }());
+    CHECK(ok == 16);
+    ::close(listenFd);
+    ::close(fd);
+    ::unlink(kPath);
+}
+
+#endif // defined(__linux__)
@@ -0,0 +1,86 @@
+#include <HXLibs/coroutine/loop/EventLoop.hpp>
+#include <HXLibs/log/Log.hpp>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+
+#include <chrono>
+#include <vector>
+
+using namespace HX;
+using namespace std::chrono_literals;
+
+TEST_CASE("时间轮: 按过期时间顺序触发, 且不会提前") {
+    coroutine::EventLoop loop;
+    using Clock = std::chrono::steady_clock;
+    struct Item {
+        Clock::time_point expire;
+        Clock::time_point fired;
+    };
+    // 跨越第 0 层 (64ms) 与第 1 层, 覆盖级联
+    constexpr std::size_t N = 300;
+    std::vector<Item> items(N);
+    std::vector<std::size_t> order;
+    std::vector<coroutine::Task<>> tasks;
+    auto const begin = Clock::now();
+    for (std::size_t i = 0; i < N; ++i) {
+        auto ms = std::chrono::milliseconds{(i * 7919) % 200};
+        items[i].expire = begin + ms;
+        tasks.push_back([](coroutine::EventLoop& loop, Item& item, std::size_t i,
+                           std::vector<std::size_t>& order,
+                           std::chrono::milliseconds ms) -> coroutine::Task<> {
+            co_await loop.makeTimer().sleepFor(ms);
+            item.fired = Clock::now();
+            order.push_back(i);
+        }(loop, items[i], i, order, ms));
+    }
+    for (auto& t : tasks) {
+        loop.start(t);
+    }
+    loop.run();
+    REQUIRE(order.size() == N);
+    for (std::size_t i = 0; i < N; ++i) {
+        CHECK(items[i].fired >= items[i].expire);
+    }
+    for (std::size_t i = 1; i < N; ++i) {
+        // 同一 tick 内的顺序不保证, 但不同 tick 必须有序
+        CHECK(items[order[i - 1]].expire <= items[order[i]].expire + 1ms);
+    }
+}
+
+TEST_CASE("时间轮: 取消与移动后的定时器") {
+    coroutine::EventLoop loop;
+    bool fired = false;
+    loop.sync([&]() -> coroutine::Task<> {
+        // 远期的定时器 (高层与溢出链表) 被 whenAny 的胜者取消
+        auto res = co_await coroutine::whenAny(
+            loop.makeTimer().sleepFor(24h),
+            loop.makeTimer().sleepFor(std::chrono::hours{24 * 365 * 3}),
+            loop.makeTimer().sleepFor(5ms)
+        );
+        CHECK(res.index() == 2);
+        fired = true;
+    }());
+    CHECK(fired);
+}
+
+TEST_CASE("时间轮: 空闲时的等待时长") {
+    coroutine::TimerLoop timerLoop;
+    CHECK(!timerLoop.run());
+    {
+        auto timer = coroutine::TimerLoop::makeTimer(timerLoop).sleepFor(10s);
+        timer.await_suspend(std::noop_coroutine());
+        // 远期的定时器在高层槽位中, 可能提前醒来做一次级联, 但不会晚于过期时间
+        auto timeout = timerLoop.run();
+        REQUIRE(timeout);
+        CHECK(*timeout > 1s);
+        CHECK(*timeout <= 10s + 1ms);
+
+        // 移动已插入的定时器: 新对象接替其位置
+        auto moved = std::move(timer);
+        auto timeout2 = timerLoop.run();
+        REQUIRE(timeout2);
+        CHECK(*timeout2 > 1s);
+    } // 析构时取消
+    CHECK(!timerLoop.run());
+}
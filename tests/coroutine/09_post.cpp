@@ -0,0 +1,107 @@
+#include <HXLibs/coroutine/loop/EventLoop.hpp>
+#include <HXLibs/log/Log.hpp>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace HX;
+using namespace std::chrono_literals;
+
+TEST_CASE("跨线程投递: 多个生产者, 全部在事件循环线程中按投递顺序执行") {
+    coroutine::EventLoop loop;
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 10000;
+    std::vector<int> lastSeen(kThreads, -1);
+    int cnt = 0;
+    bool ordered = true;
+    bool onLoopThread = true;
+    auto const loopId = std::this_thread::get_id();
+    auto raii = loop.makeTheradTask();
+    std::vector<std::thread> producers;
+    for (int t = 0; t < kThreads; ++t) {
+        producers.emplace_back([&, t] {
+            for (int i = 0; i < kPerThread; ++i) {
+                loop.post([&, t, i] {
+                    onLoopThread &= std::this_thread::get_id() == loopId;
+                    ordered &= lastSeen[static_cast<std::size_t>(t)] + 1 == i;
+                    lastSeen[static_cast<std::size_t>(t)] = i;
+                    if (++cnt == kThreads * kPerThread) {
+                        raii.notify();
+                    }
+                });
+            }
+        });
+    }
+    loop.run();
+    for (auto& th : producers) {
+        th.join();
+    }
+    CHECK(cnt == kThreads * kPerThread);
+    CHECK(ordered);
+    CHECK(onLoopThread);
+}
+
+TEST_CASE("switchTo: 协程切换到事件循环线程, 且不依赖定时器唤醒") {
+    using Clock = std::chrono::steady_clock;
+    struct State {
+        coroutine::EventLoop loop{};
+        std::thread::id resumedOn{};
+        Clock::duration latency{};
+        coroutine::Task<> timer{};
+    } st;
+    auto const loopId = std::this_thread::get_id();
+    auto raii = st.loop.makeTheradTask();
+    // 远期定时器: 若唤醒依赖定时器, 则需要等待 10s
+    st.timer = [](coroutine::EventLoop& loop) -> coroutine::Task<> {
+        co_await loop.makeTimer().sleepFor(10s);
+    }(st.loop);
+    coroutine::Task<> task{};
+    std::thread worker{[&] {
+        std::this_thread::sleep_for(100ms);
+        task = [](State& st, decltype(raii)& raii) -> coroutine::Task<> {
+            auto begin = Clock::now();
+            co_await st.loop.switchTo();
+            st.latency = Clock::now() - begin;
+            st.resumedOn = std::this_thread::get_id();
+            raii.notify();
+            st.timer = {}; // 取消定时器, 事件循环退出
+        }(st, raii);
+        // 在工作线程中启动, 挂起后由事件循环线程恢复
+        static_cast<std::coroutine_handle<>>(task).resume();
+    }};
+    st.loop.start(st.timer);
+    auto begin = Clock::now();
+    st.loop.run();
+    worker.join();
+    CHECK(st.resumedOn == loopId);
+    CHECK(st.latency < 1s);
+    CHECK(Clock::now() - begin < 5s);
+}
+
+TEST_CASE("跨线程投递期间, 事件循环上的定时器仍然正常推进") {
+    coroutine::EventLoop loop;
+    int ticks = 0;
+    auto raii = loop.makeTheradTask();
+    std::atomic_bool done{false};
+    std::thread worker{[&] {
+        std::this_thread::sleep_for(300ms);
+        loop.post([&] {
+            done = true;
+            raii.notify();
+        });
+    }};
+    loop.sync([&]() -> coroutine::Task<> {
+        while (!done) {
+            co_await loop.makeTimer().sleepFor(10ms);
+            ++ticks;
+        }
+    }());
+    worker.join();
+    log::hxLog.info("ticks:", ticks);
+    CHECK(ticks >= 10);
+}
@@ -0,0 +1,202 @@
+#include <HXLibs/coroutine/awaiter/WhenAll.hpp>
+#include <HXLibs/coroutine/awaiter/WhenAny.hpp>
+#include <HXLibs/coroutine/loop/EventLoop.hpp>
+#include <HXLibs/coroutine/sync/AsyncMutex.hpp>
+#include <HXLibs/coroutine/sync/AsyncSemaphore.hpp>
+#include <HXLibs/coroutine/sync/AsyncSharedMutex.hpp>
+#include <HXLibs/coroutine/sync/Channel.hpp>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+using namespace HX;
+
+namespace {
+
+struct State {
+    coroutine::EventLoop loop{};
+    int counter = 0;
+    int inside = 0;
+    int maxInside = 0;
+    int maxReaders = 0;
+    bool overlapped = false;
+};
+
+coroutine::Task<> mutexWorker(State& st, coroutine::AsyncMutex& mtx, int n) {
+    for (int i = 0; i < n; ++i) {
+        auto guard = co_await mtx.scopedLock();
+        st.overlapped |= st.inside++ != 0;
+        int v = st.counter;
+        co_await st.loop.makeTimer().yield();
+        st.counter = v + 1;
+        --st.inside;
+    }
+}
+
+coroutine::Task<> semWorker(State& st, coroutine::AsyncSemaphore& sem) {
+    for (int i = 0; i < 20; ++i) {
+        co_await sem.acquire();
+        st.maxInside = std::max(st.maxInside, ++st.inside);
+        co_await st.loop.makeTimer().yield();
+        --st.inside;
+        sem.release();
+    }
+}
+
+coroutine::Task<> rwWorker(State& st, coroutine::AsyncSharedMutex& mtx, bool isWriter) {
+    for (int i = 0; i < 20; ++i) {
+        if (isWriter) {
+            co_await mtx.lock();
+            st.overlapped |= st.inside != 0;
+            st.inside = -1;
+            co_await st.loop.makeTimer().yield();
+            st.inside = 0;
+            ++st.counter;
+            mtx.unlock();
+        } else {
+            co_await mtx.lockShared();
+            st.overlapped |= st.inside < 0;
+            st.maxReaders = std::max(st.maxReaders, ++st.inside);
+            co_await st.loop.makeTimer().yield();
+            --st.inside;
+            mtx.unlockShared();
+        }
+    }
+}
+
+coroutine::Task<> producer(coroutine::Channel<int>& ch, int n) {
+    for (int i = 0; i < n; ++i) {
+        CHECK(co_await ch.send(i));
+    }
+    ch.close();
+    CHECK_FALSE(co_await ch.send(-1));
+}
+
+coroutine::Task<> consumer(coroutine::Channel<int>& ch, std::vector<int>& out) {
+    while (auto v = co_await ch.recv()) {
+        out.push_back(*v);
+    }
+}
+
+} // namespace
+
+TEST_CASE("AsyncMutex: 临界区内挂起也保持互斥, 且按 FIFO 移交") {
+    State st;
+    coroutine::AsyncMutex mtx;
+    st.loop.sync(coroutine::whenAll(
+        mutexWorker(st, mtx, 100), mutexWorker(st, mtx, 100), mutexWorker(st, mtx, 100)));
+    CHECK(st.counter == 300);
+    CHECK_FALSE(st.overlapped);
+    CHECK(mtx.tryLock());
+    CHECK_FALSE(mtx.tryLock());
+    mtx.unlock();
+}
+
+TEST_CASE("AsyncSemaphore: 限制并发数") {
+    State st;
+    coroutine::AsyncSemaphore sem{2};
+    st.loop.sync(coroutine::whenAll(
+        semWorker(st, sem), semWorker(st, sem), semWorker(st, sem), semWorker(st, sem)));
+    CHECK(st.maxInside == 2);
+    CHECK(sem.available() == 2);
+}
+
+TEST_CASE("AsyncSharedMutex: 读者并发, 写者独占") {
+    State st;
+    coroutine::AsyncSharedMutex mtx;
+    st.loop.sync(coroutine::whenAll(
+        rwWorker(st, mtx, false), rwWorker(st, mtx, false),
+        rwWorker(st, mtx, true), rwWorker(st, mtx, false)));
+    CHECK(st.counter == 20);
+    CHECK(st.maxReaders >= 2);
+    CHECK_FALSE(st.overlapped);
+}
+
+TEST_CASE("Channel: 背压, 顺序与关闭") {
+    for (std::size_t cap : {0, 1, 4}) {
+        State st;
+        coroutine::Channel<int> ch{cap};
+        std::vector<int> out;
+        st.loop.sync(coroutine::whenAll(producer(ch, 100), consumer(ch, out)));
+        REQUIRE(out.size() == 100);
+        CHECK(std::is_sorted(out.begin(), out.end()));
+    }
+    coroutine::Channel<int> ch{1};
+    int v = 1;
+    CHECK(ch.trySend(v));
+    CHECK_FALSE(ch.trySend(v)); // 已满
+    CHECK(ch.tryRecv() == 1);
+    CHECK_FALSE(ch.tryRecv());
+}
+
+TEST_CASE("放弃等待: whenAny 中超时先完成, 等待者出队") {
+    using namespace std::chrono;
+    State st;
+    coroutine::Channel<int> ch{1};
+    coroutine::AsyncSemaphore sem{0};
+    coroutine::AsyncSharedMutex rw;
+    REQUIRE(rw.tryLock());
+    st.loop.sync([](State& st, coroutine::Channel<int>& ch, coroutine::AsyncSemaphore& sem,
+                    coroutine::AsyncSharedMutex& rw) -> coroutine::Task<> {
+        auto r1 = co_await coroutine::whenAny(ch.recv(), st.loop.makeTimer().sleepFor(5ms));
+        CHECK(r1.index() == 1);
+        // 接收者已出队: 值进入缓冲区, 而不是交给已析构的接收者
+        CHECK(co_await ch.send(42));
+        CHECK(co_await ch.recv() == 42);
+
+        auto r2 = co_await coroutine::whenAny(sem.acquire(), st.loop.makeTimer().sleepFor(5ms));
+        CHECK(r2.index() == 1);
+        CHECK(sem.available() == 0);
+
+        auto r3 = co_await coroutine::whenAny(rw.lockShared(), st.loop.makeTimer().sleepFor(5ms));
+        CHECK(r3.index() == 1);
+    }(st, ch, sem, rw));
+    sem.release();
+    CHECK(sem.tryAcquire());
+    rw.unlock();
+    CHECK(rw.tryLockShared());
+    rw.unlockShared();
+    CHECK(rw.tryLock());
+}
+
+TEST_CASE("跨事件循环: 互斥锁与通道") {
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 2000;
+    coroutine::AsyncMutex mtx;
+    coroutine::Channel<int> ch{8};
+    int counter = 0;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&] {
+            coroutine::EventLoop loop;
+            loop.sync([](coroutine::EventLoop& loop, coroutine::AsyncMutex& mtx,
+                         coroutine::Channel<int>& ch, int& counter) -> coroutine::Task<> {
+                for (int i = 0; i < kPerThread; ++i) {
+                    co_await mtx.lock(loop);
+                    ++counter;
+                    mtx.unlock();
+                    co_await ch.send(i, loop);
+                }
+            }(loop, mtx, ch, counter));
+        });
+    }
+    long long sum = 0;
+    {
+        coroutine::EventLoop loop;
+        loop.sync([](coroutine::EventLoop& loop, coroutine::Channel<int>& ch,
+                     long long& sum) -> coroutine::Task<> {
+            for (int i = 0; i < kThreads * kPerThread; ++i) {
+                sum += *co_await ch.recv(loop);
+            }
+        }(loop, ch, sum));
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    CHECK(counter == kThreads * kPerThread);
+    CHECK(sum == static_cast<long long>(kThreads) * kPerThread * (kPerThread - 1) / 2);
+}
@@ -0,0 +1,86 @@
+#include <HXLibs/coroutine/awaiter/WhenAny.hpp>
+#include <HXLibs/coroutine/loop/EventLoop.hpp>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+
+#if defined(__linux__)
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace HX;
+using namespace std::chrono;
+
+namespace {
+
+struct SocketPair {
+    SocketPair() {
+        REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+    }
+    ~SocketPair() {
+        ::close(fds[0]);
+        ::close(fds[1]);
+    }
+    int fds[2];
+};
+
+coroutine::Task<int> recvOnce(coroutine::EventLoop& loop, int fd, std::span<char> buf) {
+    co_return co_await loop.makeAioTask().prepRecv(fd, buf, 0);
+}
+
+} // namespace
+
+TEST_CASE("whenAny: 定时器获胜时, 落败的 recv 被取消并回收") {
+    coroutine::EventLoop loop;
+    SocketPair sp;
+    auto& drive = loop.getEventDrive();
+    std::size_t timerWins = 0;
+    std::size_t maxPending = 0;
+    loop.sync([](coroutine::EventLoop& loop, int fd, std::size_t& timerWins,
+                 std::size_t& maxPending) -> coroutine::Task<> {
+        char buf[16];
+        for (int i = 0; i < 200; ++i) {
+            auto res = co_await coroutine::whenAny(
+                recvOnce(loop, fd, buf), loop.makeTimer().sleepFor(50us));
+            timerWins += res.index() == 1;
+            maxPending = std::max(maxPending, loop.getEventDrive().pendingSqes());
+        }
+    }(loop, sp.fds[0], timerWins, maxPending));
+    CHECK(timerWins == 200);
+    CHECK(maxPending <= 4);  // 不随轮数增长
+    CHECK(drive.abandonedTasks() == 0);
+    CHECK(drive.pendingSqes() == 0);
+
+    // 取消之后, 数据仍完整地留给下一次读取
+    CHECK(::write(sp.fds[1], "ok", 2) == 2);
+    int n = loop.sync([](coroutine::EventLoop& loop, int fd) -> coroutine::Task<int> {
+        char buf[16];
+        co_return co_await recvOnce(loop, fd, buf);
+    }(loop, sp.fds[0]));
+    CHECK(n == 2);
+}
+
+TEST_CASE("whenAny: 两个操作在同一轮完成, 落败一方不会被恢复") {
+    coroutine::EventLoop loop;
+    SocketPair a, b;
+    for (int i = 0; i < 50; ++i) {
+        CHECK(::write(a.fds[1], "a", 1) == 1);
+        CHECK(::write(b.fds[1], "b", 1) == 1);
+        auto idx = loop.sync([](coroutine::EventLoop& loop, int fa, int fb) -> coroutine::Task<std::size_t> {
+            char bufA[4], bufB[4];
+            auto res = co_await coroutine::whenAny(
+                loop.makeAioTask().prepRecv(fa, bufA, 0),
+                loop.makeAioTask().prepRecv(fb, bufB, 0));
+            co_return res.index();
+        }(loop, a.fds[0], b.fds[0]));
+        CHECK(idx < 2);
+        // 落败的一方也已经读走了数据; 若没有, 清空以便下一轮
+        char tmp[4];
+        CHECK(::recv(a.fds[0], tmp, sizeof(tmp), MSG_DONTWAIT) <= 1);
+        CHECK(::recv(b.fds[0], tmp, sizeof(tmp), MSG_DONTWAIT) <= 1);
+    }
+    CHECK(loop.getEventDrive().abandonedTasks() == 0);
+}
+
+#endif // defined(__linux__)
@@ -0,0 +1,115 @@
+#include <HXLibs/coroutine/awaiter/AsCompleted.hpp>
+#include <HXLibs/coroutine/awaiter/WhenAll.hpp>
+#include <HXLibs/coroutine/awaiter/WhenAny.hpp>
+#include <HXLibs/coroutine/loop/EventLoop.hpp>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+
+#include <stdexcept>
+#include <vector>
+
+using namespace HX;
+using namespace std::chrono;
+
+namespace {
+
+struct State {
+    coroutine::EventLoop loop{};
+    int inFlight = 0;
+    int maxInFlight = 0;
+};
+
+coroutine::Task<int> delayed(State& st, int ms, int val) {
+    st.maxInFlight = std::max(st.maxInFlight, ++st.inFlight);
+    co_await st.loop.makeTimer().sleepFor(milliseconds{ms});
+    --st.inFlight;
+    if (val < 0) {
+        throw std::runtime_error{"negative"};
+    }
+    co_return val;
+}
+
+coroutine::Task<> delayedVoid(State& st, int ms) {
+    co_await st.loop.makeTimer().sleepFor(milliseconds{ms});
+}
+
+std::vector<coroutine::Task<int>> makeTasks(State& st, std::vector<int> const& delays) {
+    std::vector<coroutine::Task<int>> tasks;
+    for (std::size_t i = 0; i < delays.size(); ++i) {
+        tasks.push_back(delayed(st, delays[i], static_cast<int>(i)));
+    }
+    return tasks;
+}
+
+} // namespace
+
+TEST_CASE("whenAll(range): 结果按下标对应, 异常单独保存") {
+    State st;
+    auto tasks = makeTasks(st, {30, 10, 20, 5});
+    tasks.push_back(delayed(st, 1, -1));
+    auto res = st.loop.sync(coroutine::whenAll(std::move(tasks)));
+    REQUIRE(res.size() == 5);
+    for (int i = 0; i < 4; ++i) {
+        CHECK(res[static_cast<std::size_t>(i)].get() == i);
+    }
+    CHECK_FALSE(res[4].isVal());
+    CHECK(st.maxInFlight == 5);
+
+    std::vector<coroutine::Task<>> voids;
+    voids.push_back(delayedVoid(st, 1));
+    voids.push_back(delayedVoid(st, 2));
+    auto vres = st.loop.sync(coroutine::whenAll(voids));
+    CHECK(vres.size() == 2);
+    CHECK((vres[0].isVal() && vres[1].isVal()));
+
+    CHECK(st.loop.sync(coroutine::whenAll(std::vector<coroutine::Task<int>>{})).empty());
+}
+
+TEST_CASE("whenAll(range, k): 同时进行的元素不超过 k") {
+    State st;
+    std::vector<int> delays(20, 2);
+    auto res = st.loop.sync(coroutine::whenAll(makeTasks(st, delays), 3));
+    REQUIRE(res.size() == 20);
+    for (std::size_t i = 0; i < res.size(); ++i) {
+        CHECK(res[i].get() == static_cast<int>(i));
+    }
+    CHECK(st.maxInFlight == 3);
+}
+
+TEST_CASE("whenAny(range): 返回最先完成的下标与值") {
+    State st;
+    auto [idx, val] = st.loop.sync(coroutine::whenAny(makeTasks(st, {30, 20, 5, 40})));
+    CHECK(idx == 2);
+    CHECK(val == 2);
+}
+
+TEST_CASE("asCompleted: 按完成顺序产出, 可提前结束") {
+    State st;
+    std::vector<std::size_t> order;
+    st.loop.sync([](State& st, std::vector<std::size_t>& order) -> coroutine::Task<> {
+        auto stream = coroutine::asCompleted(makeTasks(st, {40, 10, 30, 20, 1}), 0);
+        CHECK(stream.size() == 5);
+        while (auto item = co_await stream.next()) {
+            CHECK(item->second.get() == static_cast<int>(item->first));
+            order.push_back(item->first);
+        }
+    }(st, order));
+    CHECK(order == std::vector<std::size_t>{4, 1, 3, 2, 0});
+
+    // 有界并发, 且消费者在取得两个结果后提前结束
+    st.maxInFlight = 0;
+    int got = st.loop.sync([](State& st) -> coroutine::Task<int> {
+        auto stream = coroutine::asCompleted(makeTasks(st, std::vector<int>(10, 2)), 2);
+        int cnt = 0;
+        for (;;) {
+            auto item = co_await stream.next();
+            if (!item || ++cnt == 2) {
+                break;
+            }
+        }
+        co_return cnt;
+    }(st));
+    CHECK(got == 2);
+    CHECK(st.maxInFlight == 2);
+}
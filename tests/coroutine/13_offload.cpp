@@ -0,0 +1,156 @@
+#include <HXLibs/coroutine/executor/Offload.hpp>
+#include <HXLibs/coroutine/awaiter/WhenAll.hpp>
+#include <HXLibs/coroutine/awaiter/WhenAny.hpp>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace HX;
+using namespace std::chrono;
+
+namespace {
+
+struct Fixture {
+    Fixture() {
+        pool.setFixedThreadNum(2);
+        pool.run<container::ThreadPool::Model::FixedSizeAndNoCheck>();
+    }
+
+    coroutine::EventLoop loop{};
+    container::ThreadPool pool{};
+};
+
+} // namespace
+
+TEST_CASE("offload: 返回值与异常, 并在事件循环的线程中恢复") {
+    Fixture fx;
+    auto const loopThread = std::this_thread::get_id();
+    fx.loop.sync([](Fixture& fx, std::thread::id loopThread) -> coroutine::Task<> {
+        std::thread::id worker{};
+        auto s = co_await coroutine::offload(fx.loop, fx.pool, [&] {
+            worker = std::this_thread::get_id();
+            return std::string{"hello"};
+        });
+        CHECK(s == "hello");
+        CHECK(worker != loopThread);
+        CHECK(std::this_thread::get_id() == loopThread);
+
+        int cnt = 0;
+        co_await coroutine::offload(fx.loop, fx.pool, [&] { ++cnt; });
+        CHECK(cnt == 1);
+
+        bool caught = false;
+        try {
+            co_await coroutine::offload(fx.loop, fx.pool, []() -> int {
+                throw std::runtime_error{"boom"};
+            });
+        } catch (std::runtime_error const& e) {
+            caught = std::string{e.what()} == "boom";
+        }
+        CHECK(caught);
+    }(fx, loopThread));
+}
+
+TEST_CASE("offload: 取消") {
+    Fixture fx;
+    std::stop_source src;
+    src.request_stop();
+    bool ran = false;
+    std::error_code ec{};
+    fx.loop.sync([](Fixture& fx, std::stop_token token, bool& ran,
+                    std::error_code& ec) -> coroutine::Task<> {
+        try {
+            co_await coroutine::offload(fx.loop, fx.pool, [&] { ran = true; }, token);
+        } catch (std::system_error const& e) {
+            ec = e.code();
+        }
+    }(fx, src.get_token(), ran, ec));
+    CHECK_FALSE(ran);
+    CHECK(ec == std::errc::operation_canceled);
+
+    // 执行中的工作通过 stop_token 自行结束
+    std::stop_source src2;
+    int steps = fx.loop.sync([](Fixture& fx, std::stop_source& src) -> coroutine::Task<int> {
+        auto stopper = [](Fixture& fx, std::stop_source& src) -> coroutine::Task<> {
+            co_await fx.loop.makeTimer().sleepFor(20ms);
+            src.request_stop();
+        };
+        auto [n, _] = co_await coroutine::whenAll(
+            coroutine::offload(fx.loop, fx.pool, [](std::stop_token token) {
+                int n = 0;
+                while (!token.stop_requested()) {
+                    std::this_thread::sleep_for(1ms);
+                    ++n;
+                }
+                return n;
+            }, src.get_token()),
+            stopper(fx, src));
+        co_return n.get();
+    }(fx, src2));
+    CHECK(steps > 0);
+}
+
+TEST_CASE("offload: 多个工作同时进行, 事件循环不被阻塞") {
+    Fixture fx;
+    std::atomic_int done{0};
+    int ticks = 0;
+    fx.loop.sync([](Fixture& fx, std::atomic_int& done, int& ticks) -> coroutine::Task<> {
+        auto ticker = [](Fixture& fx, std::atomic_int& done, int& ticks) -> coroutine::Task<> {
+            while (done.load() < 8) {
+                co_await fx.loop.makeTimer().sleepFor(1ms);
+                ++ticks;
+            }
+        };
+        auto job = [](Fixture& fx, std::atomic_int& done, int i) -> coroutine::Task<int> {
+            co_return co_await coroutine::offload(fx.loop, fx.pool, [&done, i] {
+                std::this_thread::sleep_for(10ms);
+                ++done;
+                return i;
+            });
+        };
+        std::vector<coroutine::Task<int>> tasks;
+        for (int i = 0; i < 8; ++i) {
+            tasks.push_back(job(fx, done, i));
+        }
+        auto [res, _] = co_await coroutine::whenAll(
+            coroutine::whenAll(std::move(tasks)), ticker(fx, done, ticks));
+        for (int i = 0; i < 8; ++i) {
+            CHECK(res.get()[static_cast<std::size_t>(i)].get() == i);
+        }
+    }(fx, done, ticks));
+    CHECK(done.load() == 8);
+    CHECK(ticks > 0);
+}
+
+TEST_CASE("offload: whenAny 中落败后, 工作结束时不再访问协程帧") {
+    Fixture fx;
+    std::atomic_bool finished{false};
+    std::atomic_bool stopped{false};
+    auto idx = fx.loop.sync([](Fixture& fx, std::atomic_bool& finished,
+                               std::atomic_bool& stopped) -> coroutine::Task<std::size_t> {
+        auto res = co_await coroutine::whenAny(
+            coroutine::offload(fx.loop, fx.pool, [&] {
+                std::this_thread::sleep_for(50ms);
+                finished = true;
+                return std::string(1024, 'x');
+            }),
+            coroutine::offload(fx.loop, fx.pool, [&](std::stop_token token) {
+                while (!token.stop_requested()) {
+                    std::this_thread::sleep_for(1ms);
+                }
+                stopped = true;
+            }),
+            fx.loop.makeTimer().sleepFor(5ms));
+        co_return res.index();
+    }(fx, finished, stopped));
+    CHECK(idx == 2);
+    // 事件循环等到两个工作都结束才退出, 迟到的结果被丢弃
+    CHECK(finished.load());
+    CHECK(stopped.load());
+}
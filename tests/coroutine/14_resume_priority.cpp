@@ -0,0 +1,101 @@
+#include <HXLibs/coroutine/awaiter/WhenAll.hpp>
+#include <HXLibs/coroutine/loop/EventLoop.hpp>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+
+#include <string>
+
+using namespace HX;
+
+namespace {
+
+coroutine::Task<> yielder(coroutine::EventLoop& loop, std::string& log, char id, int n,
+                          coroutine::ResumePriority priority) {
+    co_await loop.yield(priority);
+    for (int i = 0; i < n; ++i) {
+        log += id;
+        co_await loop.yield(priority);
+    }
+}
+
+} // namespace
+
+TEST_CASE("yield: 让出的协程排在本轮之后, 轮流执行") {
+    coroutine::EventLoop loop;
+    std::string log;
+    loop.sync(coroutine::whenAll(
+        yielder(loop, log, 'a', 3, coroutine::ResumePriority::Latency),
+        yielder(loop, log, 'b', 3, coroutine::ResumePriority::Latency)));
+    CHECK(log == "ababab");
+}
+
+TEST_CASE("yield: 每一轮先恢复 Latency, 再恢复 Bulk") {
+    coroutine::EventLoop loop;
+    std::string log;
+    loop.sync(coroutine::whenAll(
+        yielder(loop, log, 'x', 2, coroutine::ResumePriority::Bulk),
+        yielder(loop, log, 'y', 2, coroutine::ResumePriority::Bulk),
+        yielder(loop, log, 'L', 2, coroutine::ResumePriority::Latency)));
+    CHECK(log == "LxyLxy");
+}
+
+TEST_CASE("resumeBudget: 超出预算的 Bulk 留到之后的轮次, Latency 不必排在其后") {
+    coroutine::EventLoop loop{coroutine::EventLoopOptions{.resumeBudget = 1U}};
+    std::string log;
+    loop.sync(coroutine::whenAll(
+        yielder(loop, log, 'x', 3, coroutine::ResumePriority::Bulk),
+        yielder(loop, log, 'y', 3, coroutine::ResumePriority::Bulk),
+        yielder(loop, log, 'z', 3, coroutine::ResumePriority::Bulk),
+        yielder(loop, log, 'L', 3, coroutine::ResumePriority::Latency)));
+    // 每一轮: 一个 Latency (用尽预算), Bulk 至少一个
+    CHECK(log == "LxLyLzxyzxyz");
+}
+
+#if defined(__linux__)
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+coroutine::Task<> recvAfter(coroutine::EventLoop& loop, int fd, std::string& log, char id,
+                            coroutine::ResumePriority priority) {
+    co_await loop.yield(priority);
+    char buf[4];
+    // 以 Bulk 恢复的协程发起的 IO, 完成后同样以 Bulk 恢复
+    CHECK(co_await loop.makeAioTask().prepRecv(fd, buf, 0) == 1);
+    log += id;
+    co_await loop.yield(coroutine::ResumePriority::Latency);
+}
+
+coroutine::Task<> writeLater(coroutine::EventLoop& loop, int bulkFd, int latencyFd) {
+    co_await loop.yield();
+    co_await loop.yield();
+    // 两个 recv 都已在等待; Bulk 的一方先完成
+    CHECK(::write(bulkFd, "b", 1) == 1);
+    CHECK(::write(latencyFd, "l", 1) == 1);
+}
+
+} // namespace
+
+TEST_CASE("Bulk 协程发起的 IO 沿用 Bulk") {
+    int a[2], b[2];
+    REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, a) == 0);
+    REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, b) == 0);
+    for (int i = 0; i < 20; ++i) {
+        coroutine::EventLoop loop;
+        std::string log;
+        loop.sync(coroutine::whenAll(
+            recvAfter(loop, a[0], log, 'B', coroutine::ResumePriority::Bulk),
+            recvAfter(loop, b[0], log, 'L', coroutine::ResumePriority::Latency),
+            writeLater(loop, a[1], b[1])));
+        CHECK(log == "LB");
+    }
+    ::close(a[0]);
+    ::close(a[1]);
+    ::close(b[0]);
+    ::close(b[1]);
+}
+
+#endif // defined(__linux__)
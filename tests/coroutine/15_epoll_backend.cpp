@@ -0,0 +1,204 @@
+#include <HXLibs/coroutine/awaiter/WhenAll.hpp>
+#include <HXLibs/coroutine/awaiter/WhenAny.hpp>
+#include <HXLibs/coroutine/loop/EventLoop.hpp>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+
+#if defined(__linux__)
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <thread>
+
+using namespace HX;
+using namespace std::chrono;
+
+namespace {
+
+coroutine::EventLoopOptions epollOptions(unsigned int fixedFiles = 0U) {
+    coroutine::EventLoopOptions options{};
+    options.backend = coroutine::EventBackend::Epoll;
+    options.fixedFiles = fixedFiles;
+    return options;
+}
+
+struct SocketPair {
+    SocketPair() {
+        REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+    }
+    ~SocketPair() {
+        ::close(fds[0]);
+        ::close(fds[1]);
+    }
+    int fds[2];
+};
+
+coroutine::Task<int> recvOnce(coroutine::EventLoop& loop, int fd, std::span<char> buf) {
+    co_return co_await loop.makeAioTask().prepRecv(fd, buf, 0);
+}
+
+coroutine::Task<> sendLater(coroutine::EventLoop& loop, int fd, std::string_view data) {
+    co_await loop.makeTimer().sleepFor(5ms);
+    CHECK(co_await loop.makeAioTask().prepSend(fd, data, 0) == static_cast<int>(data.size()));
+}
+
+} // namespace
+
+TEST_CASE("epoll: recv 等待数据到达, send 立即完成") {
+    coroutine::EventLoop loop{epollOptions()};
+    REQUIRE((loop.getEventDrive().backend() == coroutine::EventBackend::Epoll));
+    SocketPair sp;
+    auto n = loop.sync([](coroutine::EventLoop& loop, int r, int w) -> coroutine::Task<int> {
+        char buf[16];
+        auto [res, _] = co_await coroutine::whenAll(
+            recvOnce(loop, r, buf), sendLater(loop, w, "hello"));
+        co_return res.get();
+    }(loop, sp.fds[0], sp.fds[1]));
+    CHECK(n == 5);
+
+    // 对端关闭后读到 0
+    ::shutdown(sp.fds[1], SHUT_WR);
+    n = loop.sync([](coroutine::EventLoop& loop, int r) -> coroutine::Task<int> {
+        char buf[16];
+        co_return co_await recvOnce(loop, r, buf);
+    }(loop, sp.fds[0]));
+    CHECK(n == 0);
+}
+
+TEST_CASE("epoll: 链接超时与 whenAny 的取消") {
+    coroutine::EventLoop loop{epollOptions()};
+    SocketPair sp;
+    static ::__kernel_timespec ts = coroutine::durationToKernelTimespec(10ms);
+    auto idx = loop.sync([](coroutine::EventLoop& loop, int fd) -> coroutine::Task<std::size_t> {
+        char buf[16];
+        auto res = co_await coroutine::AioTask::linkTimeout(
+            loop.makeAioTask().prepRecv(fd, buf, 0),
+            loop.makeAioTask().prepLinkTimeout(&ts, 0));
+        co_return res.index();
+    }(loop, sp.fds[0]));
+    CHECK(idx == 1);
+
+    int timerWins = loop.sync([](coroutine::EventLoop& loop, int fd) -> coroutine::Task<int> {
+        char buf[16];
+        int wins = 0;
+        for (int i = 0; i < 20; ++i) {
+            auto res = co_await coroutine::whenAny(
+                recvOnce(loop, fd, buf), loop.makeTimer().sleepFor(100us));
+            wins += res.index() == 1;
+        }
+        co_return wins;
+    }(loop, sp.fds[0]));
+    CHECK(timerWins == 20);
+    CHECK(loop.getEventDrive().abandonedTasks() == 0);
+    CHECK(loop.getEventDrive().pendingSqes() == 0);
+
+    // 被取消的读取没有读走数据
+    CHECK(::write(sp.fds[1], "ok", 2) == 2);
+    auto n = loop.sync([](coroutine::EventLoop& loop, int fd) -> coroutine::Task<int> {
+        char buf[16];
+        co_return co_await recvOnce(loop, fd, buf);
+    }(loop, sp.fds[0]));
+    CHECK(n == 2);
+}
+
+TEST_CASE("epoll: socket / accept / connect") {
+    coroutine::EventLoop loop{epollOptions()};
+    int listenFd = ::socket(AF_INET, SOCK_STREAM, 0);
+    ::sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    ::socklen_t len = sizeof(addr);
+    REQUIRE(::bind(listenFd, reinterpret_cast<::sockaddr*>(&addr), len) == 0);
+    REQUIRE(::listen(listenFd, 8) == 0);
+    REQUIRE(::getsockname(listenFd, reinterpret_cast<::sockaddr*>(&addr), &len) == 0);
+
+    auto res = loop.sync([](coroutine::EventLoop& loop, int listenFd,
+                            ::sockaddr_in addr) -> coroutine::Task<std::string> {
+        auto acceptor = [](coroutine::EventLoop& loop, int listenFd) -> coroutine::Task<int> {
+            co_return co_await loop.makeAioTask().prepAccept(listenFd, nullptr, nullptr, 0);
+        };
+        auto connector = [](coroutine::EventLoop& loop, ::sockaddr_in addr) -> coroutine::Task<int> {
+            int fd = co_await loop.makeAioTask().prepSocket(AF_INET, SOCK_STREAM, 0, 0);
+            CHECK(co_await loop.makeAioTask().prepConnect(
+                fd, reinterpret_cast<::sockaddr const*>(&addr), sizeof(addr)) == 0);
+            co_return fd;
+        };
+        auto [a, c] = co_await coroutine::whenAll(acceptor(loop, listenFd), connector(loop, addr));
+        int serverFd = a.get();
+        int clientFd = c.get();
+        REQUIRE(serverFd >= 0);
+        REQUIRE(clientFd >= 0);
+
+        std::string_view msg = "hello";
+        CHECK(co_await loop.makeAioTask().prepSend(clientFd, msg, 0) == 5);
+        std::array<char, 16> buf{};
+        int n = co_await loop.makeAioTask().prepRecv(serverFd, buf, 0);
+        co_await loop.makeAioTask().prepClose(serverFd);
+        co_await loop.makeAioTask().prepClose(clientFd);
+        co_return std::string{buf.data(), static_cast<std::size_t>(std::max(n, 0))};
+    }(loop, listenFd, addr));
+    CHECK(res == "hello");
+    ::close(listenFd);
+}
+
+TEST_CASE("epoll: 跨线程投递唤醒阻塞在 epoll_wait 中的事件循环") {
+    coroutine::EventLoop loop{epollOptions()};
+    auto raii = loop.makeTheradTask();
+    bool done = false;
+    std::thread worker{[&] {
+        std::this_thread::sleep_for(20ms);
+        loop.post([&] {
+            done = true;
+            raii.notify();
+        });
+    }};
+    loop.run();
+    worker.join();
+    CHECK(done);
+}
+
+TEST_CASE("epoll: 链式任务与模拟的注册文件表") {
+    constexpr char const* kPath = "15_epoll_backend.tmp";
+    coroutine::EventLoop loop{epollOptions(4)};
+    REQUIRE(loop.getEventDrive().fixedFiles() == 4);
+    {
+        int fd = ::open(kPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        REQUIRE(::write(fd, "0123456789", 10) == 10);
+        ::close(fd);
+    }
+    std::array<char, 64> buf{};
+    auto res = loop.sync([](coroutine::EventLoop& loop, std::array<char, 64>& buf)
+        -> coroutine::Task<std::array<int, 3>> {
+        co_return co_await loop.makeAioChain<3>()
+            .add(loop.makeAioTask().prepOpenatDirect(AT_FDCWD, kPath, O_RDONLY, 0, 1))
+            .add(loop.makeAioTask().prepRead(1, buf, 10, 0).setFixedFile())
+            .add(loop.makeAioTask().prepCloseDirect(1));
+    }(loop, buf));
+    CHECK(res[0] == 0);
+    CHECK(res[1] == 10);
+    CHECK(res[2] == 0);
+    CHECK(std::string_view{buf.data(), 10} == "0123456789");
+
+    // 读取的字节数不足: 后续步骤被取消
+    res = loop.sync([](coroutine::EventLoop& loop, std::array<char, 64>& buf)
+        -> coroutine::Task<std::array<int, 3>> {
+        co_return co_await loop.makeAioChain<3>()
+            .add(loop.makeAioTask().prepOpenatDirect(AT_FDCWD, kPath, O_RDONLY, 0, 1))
+            .add(loop.makeAioTask().prepRead(1, buf, 20, 0).setFixedFile())
+            .add(loop.makeAioTask().prepCloseDirect(1));
+    }(loop, buf));
+    CHECK(res[0] == 0);
+    CHECK(res[1] == 10);
+    CHECK(res[2] == -ECANCELED);
+    ::unlink(kPath);
+}
+
+#endif // defined(__linux__)
@@ -0,0 +1,66 @@
+#include <HXLibs/net/protocol/http/Headers.hpp>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+
+#include <string>
+
+using namespace HX;
+using namespace net;
+
+TEST_CASE("常用请求头: 完美哈希不区分大小写, 且不误判") {
+    for (std::size_t i = 0; i < internal::kKnownHeaderCnt; ++i) {
+        std::string name{internal::kKnownHeaderNames[i]};
+        CHECK((internal::knownHeader(name) == static_cast<KnownHeader>(i)));
+        name[0] = static_cast<char>(name[0] - 'a' + 'A');
+        CHECK((internal::knownHeader(name) == static_cast<KnownHeader>(i)));
+    }
+    CHECK((internal::knownHeader("") == KnownHeader::Unknown));
+    CHECK((internal::knownHeader("hosT-") == KnownHeader::Unknown));
+    CHECK((internal::knownHeader("content-lengtx") == KnownHeader::Unknown));
+    CHECK((internal::knownHeader("x-request-id") == KnownHeader::Unknown));
+}
+
+TEST_CASE("查找, 覆盖, 重名与追加") {
+    HttpHeaders h;
+    h.addView("Host", "example.com")
+     .addView("Set-Cookie", "a=1")
+     .addView("set-cookie", "b=2")
+     .add("X-Trace", std::string{"t-1"});
+    CHECK(h.size() == 4);
+    CHECK(h.get(KnownHeader::Host) == "example.com");
+    CHECK(h.get("SET-COOKIE") == "a=1"); // 重名时返回第一个
+    CHECK(h.get("x-trace") == "t-1");
+    CHECK(!h.get("x-missing"));
+    CHECK(!h.tryAdd("host", "other"));
+    CHECK(h.tryAddView("Connection", "close"));
+    h.set("connection", "keep-alive");
+    CHECK(h.get(KnownHeader::Connection) == "keep-alive");
+    CHECK(h.size() == 5);
+    h.appendToLast(", Upgrade");
+    CHECK(h.get("Connection") == "keep-alive, Upgrade");
+    // 保持插入顺序
+    CHECK(h.begin()->first == "Host");
+    CHECK((h.end() - 1)->first == "Connection");
+}
+
+TEST_CASE("超过内联容量, 拷贝与移动") {
+    HttpHeaders h;
+    for (std::size_t i = 0; i < 3 * HttpHeaders::kInlineSize; ++i) {
+        h.add("X-" + std::to_string(i), std::string(100 + i, 'v'));
+    }
+    h.addView("Content-Length", "42");
+    HttpHeaders copy{h};
+    HttpHeaders moved{std::move(h)};
+    CHECK(h.empty());
+    for (auto const* hs : {&copy, &moved}) {
+        CHECK(hs->size() == 3 * HttpHeaders::kInlineSize + 1);
+        CHECK(hs->get("x-47")->size() == 147);
+        CHECK(hs->get(KnownHeader::ContentLength) == "42");
+    }
+    copy.clear();
+    CHECK(copy.empty());
+    CHECK(!copy.get(KnownHeader::ContentLength));
+    copy.add("Content-Length", "7");
+    CHECK(copy.get("content-length") == "7");
+}
@@ -0,0 +1,92 @@
+#include <HXLibs/net/protocol/http/RequestParser.hpp>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+
+#include <string>
+
+using namespace HX;
+using namespace net;
+
+namespace {
+
+std::string const kReq =
+    "GET /api/v1/users?id=42 HTTP/1.1\r\n"
+    "Host: example.com\r\n"
+    "User-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko)\r\n"
+    "Accept:text/html,application/xhtml+xml,application/xml;q=0.9,*/*;q=0.8\r\n"
+    "Accept-Encoding: gzip, deflate, br \t\r\n"
+    "X-Empty:\r\n"
+    "Connection: keep-alive\r\n"
+    "\r\n"
+    "body";
+
+} // namespace
+
+TEST_CASE("一次性解析: 视图指向缓冲区, 键转为小写") {
+    std::string buf = kReq;
+    RequestHeadParser parser;
+    REQUIRE((parser.parse(buf) == RequestHeadParser::Status::Complete));
+    CHECK(parser.method() == "GET");
+    CHECK(parser.path() == "/api/v1/users?id=42");
+    CHECK(parser.version() == "HTTP/1.1");
+    CHECK(parser.path().data() == buf.data() + 4);
+    REQUIRE(parser.headers().size() == 6);
+    CHECK(parser.headers().begin()->first == "host");
+    CHECK(parser.find("HOST") == "example.com");
+    CHECK(parser.find("accept")->starts_with("text/html,"));
+    CHECK(parser.find("accept-encoding") == "gzip, deflate, br");
+    CHECK(parser.find("x-empty") == "");
+    CHECK(parser.find("connection") == "keep-alive");
+    CHECK(!parser.find("content-length"));
+    CHECK(buf.substr(parser.headLength()) == "body");
+}
+
+TEST_CASE("逐字节到达, 并且缓冲区在两次解析之间搬移") {
+    RequestHeadParser parser;
+    std::string buf;
+    std::size_t i = 0;
+    auto status = RequestHeadParser::Status::Partial;
+    for (; i < kReq.size() && status == RequestHeadParser::Status::Partial; ++i) {
+        std::string moved = buf + kReq[i]; // 每次都是新的内存
+        buf.swap(moved);
+        status = parser.parse(buf);
+    }
+    REQUIRE((status == RequestHeadParser::Status::Complete));
+    CHECK(i == kReq.size() - 4);
+    CHECK(parser.path() == "/api/v1/users?id=42");
+    CHECK(parser.find("user-agent")->ends_with("(KHTML, like Gecko)"));
+    CHECK(parser.find("connection") == "keep-alive");
+    CHECK((parser.headers().end() - 1)->second.data() >= buf.data());
+}
+
+TEST_CASE("空行, 折叠行与非法请求") {
+    {
+        std::string buf = "\r\nPOST / HTTP/1.0\r\nX-Long: a\r\n  b\r\nContent-Length: 0\r\n\r\n";
+        RequestHeadParser parser;
+        REQUIRE((parser.parse(buf) == RequestHeadParser::Status::Complete));
+        CHECK(parser.method() == "POST");
+        CHECK(parser.find("x-long") == "a    b");
+        CHECK(parser.find("content-length") == "0");
+        CHECK(parser.headLength() == buf.size());
+    }
+    for (std::string bad : {
+        "GET /\r\n\r\n",
+        "GET / FTP/1.0\r\n\r\n",
+        "GET / HTTP/1.1\r\nNoColon\r\n\r\n",
+        "GET / HTTP/1.1\r\nKey : v\r\n\r\n",
+        "GET / HTTP/1.1\r\n folded\r\n\r\n",
+    }) {
+        RequestHeadParser parser;
+        CHECK((parser.parse(bad) == RequestHeadParser::Status::Invalid));
+    }
+    // 复用
+    RequestHeadParser parser;
+    std::string a = "GET /a HTTP/1.1\r\nA: 1\r\n\r\n";
+    REQUIRE((parser.parse(a) == RequestHeadParser::Status::Complete));
+    parser.reset();
+    std::string b = "GET /b HTTP/1.1\r\n\r\n";
+    REQUIRE((parser.parse(b) == RequestHeadParser::Status::Complete));
+    CHECK(parser.path() == "/b");
+    CHECK(parser.headers().empty());
+}
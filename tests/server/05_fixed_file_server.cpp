@@ -0,0 +1,51 @@
+#include <HXLibs/net/ApiMacro.hpp>
+
+using namespace HX;
+using namespace net;
+using namespace utils;
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+
+/**
+ * @brief 注册文件表只有 4 个槽位, 同时保持 8 个长连接:
+ *        前面的连接使用注册文件表, 表满之后回退为普通 fd, 关闭后槽位可以复用
+ */
+void runFixedFileServer(bool multishotAccept) {
+    HttpServer ser{28205};
+    ser.addEndpoint<GET>("/", [] ENDPOINT {
+        co_await res.setStatusAndContent(
+            Status::CODE_200, req.getIO().isFixedFile() ? "fixed" : "plain")
+                    .sendRes();
+    });
+    HttpServerOptions options{};
+    options.eventLoop.fixedFiles = 4;
+    options.multishotAccept = multishotAccept;
+    ser.asyncRun(1, []{}, 1500_ms, options);
+    std::this_thread::sleep_for((500_ms).toChrono());
+    for (int round = 0; round < 2; ++round) {
+        std::vector<std::unique_ptr<HttpClient<NoneProxy>>> clis;
+        std::size_t fixedCnt = 0;
+        for (int i = 0; i < 8; ++i) {
+            auto& cli = clis.emplace_back(std::make_unique<HttpClient<NoneProxy>>());
+            auto res = cli->get("http://127.0.0.1:28205/").get().move();
+            CHECK(res.status == 200);
+            fixedCnt += res.body == "fixed";
+        }
+        log::hxLog.info("round", round, "fixed:", fixedCnt);
+        CHECK(fixedCnt >= 1);
+        CHECK(fixedCnt <= 4);
+        for (auto& cli : clis) {
+            cli->close();
+        }
+        std::this_thread::sleep_for((100_ms).toChrono());
+    }
+}
+
+TEST_CASE("注册文件表: 逐个 accept") {
+    runFixedFileServer(false);
+}
+
+TEST_CASE("注册文件表: 多发 accept") {
+    runFixedFileServer(true);
+}
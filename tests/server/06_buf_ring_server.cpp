@@ -0,0 +1,63 @@
+#include <HXLibs/net/ApiMacro.hpp>
+
+using namespace HX;
+using namespace net;
+using namespace utils;
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+
+/**
+ * @brief 使用提供缓冲区环读取请求: 缓冲区只有 4 个, 且每个只有 1024 字节,
+ *        请求头超过单个缓冲区时会复制到连接自身的缓冲区中继续读取
+ */
+TEST_CASE("提供缓冲区环: 读取请求") {
+    HttpServer ser{28207};
+    ser.addEndpoint<GET>("/", [] ENDPOINT {
+        co_await res.setStatusAndContent(
+            Status::CODE_200, req.getIO().hasBufRing() ? "ring" : "plain")
+                    .sendRes();
+    });
+    ser.addEndpoint<GET>("/big", [] ENDPOINT {
+        auto it = req.getHeaders().find("x-big");
+        co_await res.setStatusAndContent(
+            Status::CODE_200,
+            std::to_string(it == req.getHeaders().end() ? 0 : it->second.size()))
+                    .sendRes();
+    });
+    ser.addEndpoint<POST>("/echo", [] ENDPOINT {
+        auto body = co_await req.parseBody();
+        co_await res.setStatusAndContent(Status::CODE_200, std::move(body))
+                    .sendRes();
+    });
+    HttpServerOptions options{};
+    options.eventLoop.bufRingEntries = 4;
+    options.eventLoop.bufRingBufSize = 1024;
+    ser.asyncRun(1, []{}, 1500_ms, options);
+    std::this_thread::sleep_for((500_ms).toChrono());
+
+    HttpClient<NoneProxy> cli;
+    for (int i = 0; i < 4; ++i) { // keep-alive: 同一个连接上多次读取
+        auto res = cli.get("http://127.0.0.1:28207/").get().move();
+        CHECK(res.status == 200);
+        CHECK(res.body == "ring");
+    }
+    {
+        std::string big(5000, 'a');
+        auto res = cli.get("http://127.0.0.1:28207/big", {{"x-big", big}}).get().move();
+        CHECK(res.status == 200);
+        CHECK(res.body == "5000");
+    }
+    {
+        std::string body(3000, 'b');
+        auto res = cli.post("http://127.0.0.1:28207/echo", body, HttpContentType::Text)
+                      .get().move();
+        CHECK(res.status == 200);
+        CHECK(res.body == body);
+    }
+    {
+        auto res = cli.get("http://127.0.0.1:28207/").get().move();
+        CHECK(res.body == "ring");
+    }
+    cli.close();
+}
@@ -0,0 +1,53 @@
+#include <HXLibs/net/ApiMacro.hpp>
+#include <HXLibs/net/protocol/websocket/WebSocket.hpp>
+#include <HXLibs/net/client/HttpClient.hpp>
+
+using namespace HX;
+using namespace net;
+using namespace utils;
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+
+/**
+ * @brief WebSocket 使用多发读取: 一个多发请求持续接收整个连接的数据,
+ *        大消息会跨越多个提供缓冲区 (每个只有 1024 字节)
+ */
+TEST_CASE("多发读取: WebSocket 回显") {
+    HttpServer serv{28209};
+    serv.addEndpoint<GET>("/ws", [] ENDPOINT {
+        auto ws = co_await WebSocketFactory{req, res}.accept();
+        for (;;) {
+            auto msg = co_await ws.recvText();
+            msg += req.getIO().isMultishotRecv() ? "|multishot" : "|plain";
+            co_await ws.sendText(std::move(msg));
+        }
+    });
+    HttpServerOptions options{};
+    options.eventLoop.bufRingEntries = 8;
+    options.eventLoop.bufRingBufSize = 1024;
+    serv.asyncRun(1, []{}, 1500_ms, options);
+    std::this_thread::sleep_for((500_ms).toChrono());
+
+    HttpClient<NoneProxy> cli{};
+    auto res = cli.wsLoop<decltype(3_s)>("ws://127.0.0.1:28209/ws",
+        [](WSClient ws) -> coroutine::Task<std::size_t> {
+            std::size_t okCnt = 0;
+            std::vector<std::string> msgs{"hello", std::string(5000, 'x'), "bye"};
+            for (auto const& msg : msgs) {
+                co_await ws.sendText(msg);
+                auto echo = co_await ws.recvText();
+                okCnt += echo == msg + "|multishot";
+            }
+            // 连续发送, 多个帧可能落在同一个缓冲区中
+            co_await ws.sendText("a");
+            co_await ws.sendText("b");
+            okCnt += co_await ws.recvText() == "a|multishot";
+            okCnt += co_await ws.recvText() == "b|multishot";
+            co_await ws.close();
+            co_return okCnt;
+        }
+    ).get();
+    REQUIRE(res);
+    CHECK(res.get() == 5);
+}
@@ -0,0 +1,42 @@
+#include <HXLibs/net/ApiMacro.hpp>
+
+using namespace HX;
+using namespace net;
+using namespace utils;
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+
+/**
+ * @brief 零拷贝发送: 超过阈值的响应使用 IORING_OP_SEND_ZC,
+ *        内核不支持时回退为普通发送, 两种情况下响应体都必须完整
+ */
+TEST_CASE("零拷贝发送: 大响应体") {
+    std::string big(2 * 1024 * 1024, '\0');
+    for (std::size_t i = 0; i < big.size(); ++i) {
+        big[i] = static_cast<char>('a' + i % 26);
+    }
+    HttpServer ser{28210};
+    ser.addEndpoint<GET>("/big", [&] ENDPOINT {
+        co_await res.setStatusAndContent(Status::CODE_200, big)
+                    .sendRes();
+    });
+    ser.addEndpoint<GET>("/small", [] ENDPOINT {
+        co_await res.setStatusAndContent(Status::CODE_200, "small")
+                    .sendRes();
+    });
+    HttpServerOptions options{};
+    options.zeroCopySendThreshold = 64 * 1024;
+    ser.asyncRun(1, []{}, 1500_ms, options);
+    std::this_thread::sleep_for((500_ms).toChrono());
+
+    HttpClient<NoneProxy> cli;
+    for (int i = 0; i < 3; ++i) { // keep-alive: 大小响应交替
+        auto res = cli.get("http://127.0.0.1:28210/big").get().move();
+        CHECK(res.status == 200);
+        CHECK(res.body == big);
+        auto small = cli.get("http://127.0.0.1:28210/small").get().move();
+        CHECK(small.body == "small");
+    }
+    cli.close();
+}
@@ -0,0 +1,81 @@
+#include <HXLibs/net/ApiMacro.hpp>
+
+#include <chrono>
+
+#if defined(__linux__)
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+#endif
+
+using namespace HX;
+using namespace net;
+using namespace utils;
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+
+#if defined(__linux__)
+
+namespace {
+
+int connectTo(std::uint16_t port) {
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    ::sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    REQUIRE(::connect(fd, reinterpret_cast<::sockaddr*>(&addr), sizeof(addr)) == 0);
+    return fd;
+}
+
+bool getOnce(int fd) {
+    constexpr std::string_view req = "GET / HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n";
+    char buf[1024];
+    return ::send(fd, req.data(), req.size(), 0) == static_cast<ssize_t>(req.size())
+        && ::recv(fd, buf, sizeof(buf), 0) > 0;
+}
+
+} // namespace
+
+/**
+ * @brief 连接级的截止时间: 读写不再链接超时 SQE,
+ *        活跃的连接会不断顺延截止时间, 空闲超过超时时间的连接会被关闭
+ */
+TEST_CASE("连接截止时间: 顺延与超时") {
+    HttpServer ser{28211};
+    ser.addEndpoint<GET>("/", [] ENDPOINT {
+        co_await res.setStatusAndContent(Status::CODE_200, "ok")
+                    .sendRes();
+    });
+    HttpServerOptions options{};
+    REQUIRE(options.connectionDeadline);
+    ser.asyncRun(1, []{}, 300_ms, options);
+    std::this_thread::sleep_for((500_ms).toChrono());
+
+    int fd = connectTo(28211);
+    // 每 150ms 一次请求, 总时长超过超时时间, 连接仍然存活
+    for (int i = 0; i < 5; ++i) {
+        CHECK(getOnce(fd));
+        std::this_thread::sleep_for(std::chrono::milliseconds{150});
+    }
+    // 之后保持空闲: 截止时间到达后服务端取消读取并关闭连接
+    auto t0 = std::chrono::steady_clock::now();
+    char buf[16];
+    CHECK(::recv(fd, buf, sizeof(buf), 0) == 0);
+    auto idle = std::chrono::steady_clock::now() - t0;
+    CHECK(idle < std::chrono::seconds{2});
+    ::close(fd);
+
+    // 从未发送过请求的连接同样会超时
+    fd = connectTo(28211);
+    t0 = std::chrono::steady_clock::now();
+    CHECK(::recv(fd, buf, sizeof(buf), 0) == 0);
+    idle = std::chrono::steady_clock::now() - t0;
+    CHECK(idle >= std::chrono::milliseconds{250});
+    CHECK(idle < std::chrono::seconds{2});
+    ::close(fd);
+}
+
+#endif // defined(__linux__)
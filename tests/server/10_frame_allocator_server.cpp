@@ -0,0 +1,85 @@
+#include <HXLibs/net/ApiMacro.hpp>
+#include <HXLibs/coroutine/promise/FrameAllocator.hpp>
+
+#include <chrono>
+#include <thread>
+
+#if defined(__linux__)
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+#endif
+
+using namespace HX;
+using namespace net;
+using namespace utils;
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+
+TEST_CASE("协程帧分配器: 复用与跨线程释放") {
+    using coroutine::FrameAllocator;
+    // 预热当前线程的缓存
+    FrameAllocator::deallocate(FrameAllocator::allocate(200), 200);
+    auto before = FrameAllocator::heapAllocations();
+    for (int i = 0; i < 1000; ++i) {
+        // 同一大小级别 (129 ~ 256) 复用同一个块
+        FrameAllocator::deallocate(FrameAllocator::allocate(129 + i % 128), 129 + i % 128);
+    }
+    CHECK(FrameAllocator::heapAllocations() == before);
+
+    // 超大帧走全局堆
+    FrameAllocator::deallocate(FrameAllocator::allocate(1 << 20), 1 << 20);
+    CHECK(FrameAllocator::heapAllocations() == before + 1);
+
+    // 在其他线程释放: 块进入释放线程的缓存, 该线程退出时归还全局堆
+    void* ptr = FrameAllocator::allocate(300);
+    std::thread{[ptr] {
+        FrameAllocator::deallocate(ptr, 300);
+        void* again = FrameAllocator::allocate(260);
+        CHECK(again == ptr);
+        FrameAllocator::deallocate(again, 260);
+    }}.join();
+}
+
+#if defined(__linux__) && !defined(HXLIBS_DISABLE_FRAME_POOL)
+
+/**
+ * @brief 预热后, hello-world 请求的所有协程帧
+ *        (ConnectionHandler / 解析请求头 / 读写 / 路由 / 端点) 都不会再从全局堆分配
+ */
+TEST_CASE("协程帧分配器: hello-world 请求不从全局堆分配协程帧") {
+    HttpServer ser{28213};
+    ser.addEndpoint<GET>("/", [] ENDPOINT {
+        co_await res.setStatusAndContent(Status::CODE_200, "Hello World!")
+                    .sendRes();
+    });
+    ser.asyncRun(1, []{}, 3_s);
+    std::this_thread::sleep_for((500_ms).toChrono());
+
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    ::sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(28213);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    REQUIRE(::connect(fd, reinterpret_cast<::sockaddr*>(&addr), sizeof(addr)) == 0);
+
+    constexpr std::string_view req = "GET / HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n";
+    auto getOnce = [&] {
+        char buf[1024];
+        return ::send(fd, req.data(), req.size(), 0) == static_cast<ssize_t>(req.size())
+            && ::recv(fd, buf, sizeof(buf), 0) > 0;
+    };
+    for (int i = 0; i < 10; ++i) {
+        REQUIRE(getOnce());
+    }
+    auto before = coroutine::FrameAllocator::heapAllocations();
+    for (int i = 0; i < 1000; ++i) {
+        REQUIRE(getOnce());
+    }
+    CHECK(coroutine::FrameAllocator::heapAllocations() == before);
+    ::close(fd);
+}
+
+#endif
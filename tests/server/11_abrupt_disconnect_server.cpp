@@ -0,0 +1,80 @@
+#include <HXLibs/net/ApiMacro.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#if defined(__linux__)
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+#endif
+
+using namespace HX;
+using namespace net;
+using namespace utils;
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+
+#if defined(__linux__)
+
+/**
+ * @brief 对方在响应发送前重置连接: sendRes 不抛出异常, 而是记录在 ioError 中, 服务器继续正常工作
+ */
+TEST_CASE("对方重置连接: 写入错误不抛出异常") {
+    std::atomic_int ioError{1};
+    std::atomic_bool thrown{false};
+    HttpServer ser{28215};
+    ser.addEndpoint<GET>("/slow", [&] ENDPOINT {
+        co_await static_cast<coroutine::EventLoop&>(req.getIO())
+            .makeTimer()
+            .sleepFor(std::chrono::milliseconds{200});
+        try {
+            // 足够大, 确保写入时能发现连接已被重置
+            co_await res.setStatusAndContent(Status::CODE_200, std::string(1 << 20, 'x'))
+                        .sendRes();
+            ioError = res.ioError();
+        } catch (...) {
+            thrown = true;
+        }
+    });
+    ser.addEndpoint<GET>("/", [] ENDPOINT {
+        co_await res.setStatusAndContent(Status::CODE_200, "ok")
+                    .sendRes();
+    });
+    ser.asyncRun(1, []{}, 3_s);
+    std::this_thread::sleep_for((500_ms).toChrono());
+
+    auto connectTo = [] {
+        int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        ::sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(28215);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        REQUIRE(::connect(fd, reinterpret_cast<::sockaddr*>(&addr), sizeof(addr)) == 0);
+        return fd;
+    };
+    {
+        constexpr std::string_view req = "GET /slow HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n";
+        int fd = connectTo();
+        REQUIRE(::send(fd, req.data(), req.size(), 0) == static_cast<ssize_t>(req.size()));
+        ::linger lg{1, 0};
+        ::setsockopt(fd, SOL_SOCKET, SO_LINGER, &lg, sizeof(lg));
+        ::close(fd); // RST
+    }
+    std::this_thread::sleep_for((500_ms).toChrono());
+    CHECK_FALSE(thrown.load());
+    CHECK(ioError.load() < 0);
+
+    // 服务器仍可正常处理请求
+    constexpr std::string_view req = "GET / HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n";
+    int fd = connectTo();
+    char buf[1024];
+    REQUIRE(::send(fd, req.data(), req.size(), 0) == static_cast<ssize_t>(req.size()));
+    CHECK(::recv(fd, buf, sizeof(buf), 0) > 0);
+    ::close(fd);
+}
+
+#endif
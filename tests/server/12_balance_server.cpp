@@ -0,0 +1,66 @@
+#include <HXLibs/net/ApiMacro.hpp>
+
+#include <set>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+#endif
+
+using namespace HX;
+using namespace net;
+using namespace utils;
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+
+#if defined(__linux__)
+
+/**
+ * @brief 开启连接均衡后, 依次建立的长连接会分散到不同的事件循环 (线程) 上,
+ *        而不是由 SO_REUSEPORT 的哈希决定
+ */
+TEST_CASE("连接均衡: 长连接分散到各个事件循环") {
+    constexpr std::size_t threadNum = 4;
+    HttpServer ser{28216};
+    ser.addEndpoint<GET>("/", [] ENDPOINT {
+        std::ostringstream oss;
+        oss << std::this_thread::get_id();
+        co_await res.setStatusAndContent(Status::CODE_200, oss.str())
+                    .sendRes();
+    });
+    HttpServerOptions options{};
+    options.balanceConnections = true;
+    ser.asyncRun(threadNum, []{}, 3_s, options);
+    std::this_thread::sleep_for((500_ms).toChrono());
+
+    constexpr std::string_view req = "GET / HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n";
+    std::vector<int> fds;
+    std::set<std::string> threads;
+    for (std::size_t i = 0; i < threadNum; ++i) {
+        int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        ::sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(28216);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        REQUIRE(::connect(fd, reinterpret_cast<::sockaddr*>(&addr), sizeof(addr)) == 0);
+        REQUIRE(::send(fd, req.data(), req.size(), 0) == static_cast<ssize_t>(req.size()));
+        char buf[1024];
+        auto n = ::recv(fd, buf, sizeof(buf), 0);
+        REQUIRE(n > 0);
+        std::string_view resp{buf, static_cast<std::size_t>(n)};
+        threads.emplace(resp.substr(resp.find("\r\n\r\n") + 4));
+        fds.push_back(fd); // 保持连接, 使其计入活跃连接数
+    }
+    CHECK(threads.size() == threadNum);
+    for (int fd : fds) {
+        ::close(fd);
+    }
+}
+
+#endif
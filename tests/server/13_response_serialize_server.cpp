@@ -0,0 +1,148 @@
+#include <HXLibs/net/ApiMacro.hpp>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+#if defined(__linux__)
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+#endif
+
+using namespace HX;
+using namespace net;
+using namespace utils;
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+
+TEST_CASE("编译期生成的状态行") {
+    CHECK(getStatusLineStrView(Status::CODE_200) == "HTTP/1.1 200 OK\r\n");
+    CHECK(getStatusLineStrView(Status::CODE_404) == "HTTP/1.1 404 Not Found\r\n");
+    CHECK(getStatusLineStrView(Status::CODE_511) == "HTTP/1.1 511 Network Authentication Required\r\n");
+    CHECK(getStatusLineStrView(static_cast<Status>(299)).empty());
+    CHECK(getStatusLineStrView(static_cast<Status>(600)).empty());
+}
+
+#if defined(__linux__)
+
+namespace {
+
+/**
+ * @brief 读取一个完整的响应 (按 Content-Length)
+ */
+std::string readResponse(int fd) {
+    std::string res;
+    char buf[64 * 1024];
+    std::size_t total = std::string::npos;
+    while (res.size() != total) {
+        auto n = ::recv(fd, buf, sizeof(buf), 0);
+        REQUIRE(n > 0);
+        res.append(buf, static_cast<std::size_t>(n));
+        if (auto pos = res.find("\r\n\r\n"); total == std::string::npos && pos != std::string::npos) {
+            auto lenPos = res.find("Content-Length: ");
+            REQUIRE(lenPos < pos);
+            total = pos + 4 + std::stoull(res.substr(lenPos + 16));
+        }
+    }
+    return res;
+}
+
+std::size_t count(std::string_view s, std::string_view sub) {
+    std::size_t n = 0;
+    for (auto pos = s.find(sub); pos != std::string_view::npos; pos = s.find(sub, pos + 1)) {
+        ++n;
+    }
+    return n;
+}
+
+} // namespace
+
+TEST_CASE("响应头与响应体一起写入, 默认的响应头可被覆盖") {
+    HttpServer ser{28225};
+    ser.addEndpoint<GET>("/plain", [] ENDPOINT {
+        co_await res.setStatusAndContent(Status::CODE_200, "ok")
+                    .sendRes();
+    });
+    ser.addEndpoint<GET>("/custom", [] ENDPOINT {
+        co_await res.setResLine(Status::CODE_202, "Queued For Later")
+                    .addHeader("Server", "test")
+                    .setBody("")
+                    .sendRes();
+    });
+    ser.addEndpoint<GET>("/big", [] ENDPOINT {
+        std::string body(4 << 20, 'x');
+        body.back() = 'y';
+        co_await res.setStatusAndContent(Status::CODE_200, body)
+                    .sendRes();
+    });
+    // 借用与共享的响应体, 不复制
+    static constexpr std::string_view kView = "borrowed";
+    auto shared = std::make_shared<std::string const>(64 * 1024, 's');
+    ser.addEndpoint<GET>("/view", [] ENDPOINT {
+        co_await res.setResLine(Status::CODE_200)
+                    .setBody("replaced")
+                    .setBodyView(kView)
+                    .sendRes();
+    });
+    ser.addEndpoint<GET>("/shared", [shared] ENDPOINT {
+        co_await res.setStatusAndContent(Status::CODE_200, shared)
+                    .sendRes();
+    });
+    ser.addEndpoint<GET>("/copy", [] ENDPOINT {
+        co_await res.setResLine(Status::CODE_200)
+                    .setBodyView(kView)
+                    .setBody("copied")
+                    .sendRes();
+    });
+    ser.asyncRun(1, []{}, 3_s);
+    std::this_thread::sleep_for((500_ms).toChrono());
+
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    ::sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(28225);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    REQUIRE(::connect(fd, reinterpret_cast<::sockaddr*>(&addr), sizeof(addr)) == 0);
+    auto get = [&](std::string_view path) {
+        std::string req = "GET ";
+        req += path;
+        req += " HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n";
+        REQUIRE(::send(fd, req.data(), req.size(), 0) == static_cast<ssize_t>(req.size()));
+        return readResponse(fd);
+    };
+
+    auto plain = get("/plain");
+    CHECK(plain.starts_with("HTTP/1.1 200 OK\r\n"));
+    CHECK(plain.ends_with("\r\nContent-Length: 2\r\n\r\nok"));
+    CHECK(count(plain, "\r\nConnection: keep-alive\r\n") == 1);
+    CHECK(count(plain, "\r\nServer: HXLibs::net\r\n") == 1);
+    auto datePos = plain.find("\r\nDate: ");
+    REQUIRE(datePos != std::string::npos);
+    CHECK(plain.substr(datePos + 8 + 25, 6) == " GMT\r\n"); // "Fri, 11 Jul 2025 06:47:25 GMT"
+
+    auto custom = get("/custom");
+    CHECK(custom.starts_with("HTTP/1.1 202 Queued For Later\r\n"));
+    CHECK(count(custom, "Server: ") == 1);
+    CHECK(count(custom, "\r\nServer: test\r\n") == 1);
+    CHECK(custom.ends_with("\r\nContent-Length: 0\r\n\r\n"));
+
+    // 同一连接上, 大的响应体分多次写完
+    auto big = get("/big");
+    CHECK(big.ends_with(std::string(1000, 'x') + "y"));
+    CHECK(big.find("Content-Length: 4194304\r\n") != std::string::npos);
+
+    CHECK(get("/view").ends_with("\r\nContent-Length: 8\r\n\r\nborrowed"));
+    auto sharedRes = get("/shared");
+    CHECK(sharedRes.find("Content-Length: 65536\r\n") != std::string::npos);
+    CHECK(sharedRes.ends_with(*shared));
+    CHECK(get("/copy").ends_with("\r\nContent-Length: 6\r\n\r\ncopied"));
+
+    CHECK(get("/plain").ends_with("\r\n\r\nok"));
+    ::close(fd);
+}
+
+#endif
@@ -0,0 +1,222 @@
+#include <HXLibs/net/ApiMacro.hpp>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+#endif
+
+using namespace HX;
+using namespace net;
+using namespace utils;
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+
+#if defined(__linux__)
+
+namespace {
+
+/**
+ * @brief 读取 n 个完整的响应 (按 Content-Length), 返回它们的响应体
+ */
+std::vector<std::string> readResponses(int fd, std::size_t n) {
+    std::vector<std::string> bodies;
+    std::string buf;
+    char tmp[16 * 1024];
+    while (bodies.size() < n) {
+        auto pos = buf.find("\r\n\r\n");
+        if (pos != std::string::npos) {
+            auto lenPos = buf.find("Content-Length: ");
+            REQUIRE(lenPos < pos);
+            auto total = pos + 4 + std::stoull(buf.substr(lenPos + 16));
+            if (buf.size() >= total) {
+                REQUIRE(buf.starts_with("HTTP/1.1 200 OK\r\n"));
+                bodies.push_back(buf.substr(pos + 4, total - pos - 4));
+                buf.erase(0, total);
+                continue;
+            }
+        }
+        auto r = ::recv(fd, tmp, sizeof(tmp), 0);
+        REQUIRE(r > 0);
+        buf.append(tmp, static_cast<std::size_t>(r));
+    }
+    CHECK(buf.empty());
+    return bodies;
+}
+
+void sendAll(int fd, std::string_view data) {
+    REQUIRE(::send(fd, data.data(), data.size(), 0) == static_cast<ssize_t>(data.size()));
+}
+
+int connectTo(std::uint16_t port) {
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    ::sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    REQUIRE(::connect(fd, reinterpret_cast<::sockaddr*>(&addr), sizeof(addr)) == 0);
+    return fd;
+}
+
+/**
+ * @brief 对方已关闭连接
+ */
+bool isClosed(int fd) {
+    char c;
+    return ::recv(fd, &c, 1, 0) == 0;
+}
+
+} // namespace
+
+TEST_CASE("流水线: 一次收到的多个请求按顺序处理, 响应按顺序返回") {
+    HttpServer ser{28227};
+    ser.addEndpoint<GET>("/echo/{id}", [] ENDPOINT {
+        co_await res.setStatusAndContent(
+            Status::CODE_200, req.getPathParam(0).to<std::string>()).sendRes();
+    });
+    ser.addEndpoint<POST>("/body", [] ENDPOINT {
+        co_await res.setStatusAndContent(Status::CODE_200, co_await req.parseBody())
+                    .sendRes();
+    });
+    ser.addEndpoint<POST>("/ignore", [] ENDPOINT {
+        // 不读取请求体: 由连接处理器读完后丢弃
+        co_await res.setStatusAndContent(Status::CODE_200, "ignored").sendRes();
+    });
+    ser.asyncRun(1, []{}, 3_s);
+    std::this_thread::sleep_for((500_ms).toChrono());
+
+    int fd = connectTo(28227);
+
+    sendAll(fd,
+        "GET /echo/1 HTTP/1.1\r\nHost: a\r\n\r\n"
+        "POST /body HTTP/1.1\r\nHost: a\r\nContent-Length: 5\r\n\r\nhello"
+        "GET /echo/2 HTTP/1.1\r\nHost: a\r\n\r\n"
+        "POST /body HTTP/1.1\r\nHost: a\r\nTransfer-Encoding: chunked\r\n\r\n"
+        "3\r\nabc\r\n2\r\nde\r\n0\r\n\r\n"
+        "POST /ignore HTTP/1.1\r\nHost: a\r\nContent-Length: 3\r\n\r\nxyz"
+        "GET /echo/3 HTTP/1.1\r\nHost: a\r\n\r\n");
+    CHECK(readResponses(fd, 6)
+        == std::vector<std::string>{"1", "hello", "2", "abcde", "ignored", "3"});
+
+    // 最后一个请求只到达了一半
+    sendAll(fd, "GET /echo/4 HTTP/1.1\r\nHost: a\r\n\r\nGET /echo/5 HTTP/1.1\r\nHo");
+    CHECK(readResponses(fd, 1) == std::vector<std::string>{"4"});
+    sendAll(fd, "st: a\r\n\r\n");
+    CHECK(readResponses(fd, 1) == std::vector<std::string>{"5"});
+
+    // Connection: close 之前的响应也要写出
+    sendAll(fd,
+        "GET /echo/6 HTTP/1.1\r\nHost: a\r\n\r\n"
+        "GET /echo/7 HTTP/1.1\r\nHost: a\r\nConnection: close\r\n\r\n"
+        "GET /echo/8 HTTP/1.1\r\nHost: a\r\n\r\n");
+    CHECK(readResponses(fd, 2) == std::vector<std::string>{"6", "7"});
+    CHECK(isClosed(fd));
+    ::close(fd);
+}
+
+TEST_CASE("流水线: 分块编码的边界, 以及无法确定边界的请求 (请求走私)") {
+    HttpServer ser{28228};
+    ser.addEndpoint<GET>("/echo/{id}", [] ENDPOINT {
+        co_await res.setStatusAndContent(
+            Status::CODE_200, req.getPathParam(0).to<std::string>()).sendRes();
+    });
+    ser.addEndpoint<POST>("/body", [] ENDPOINT {
+        co_await res.setStatusAndContent(Status::CODE_200, co_await req.parseBody())
+                    .sendRes();
+    });
+    ser.addEndpoint<POST>("/ignore", [] ENDPOINT {
+        co_await res.setStatusAndContent(Status::CODE_200, "ignored").sendRes();
+    });
+    ser.asyncRun(1, []{}, 3_s);
+    std::this_thread::sleep_for((500_ms).toChrono());
+
+    // 块扩展与 trailer 字段, 块结尾的 CRLF 被拆分到两次读取中
+    {
+        int fd = connectTo(28228);
+        sendAll(fd,
+            "POST /body HTTP/1.1\r\nHost: a\r\nTransfer-Encoding: chunked\r\n\r\n"
+            "3;name=val\r\nabc\r\n0\r\nX-Checksum: 1\r\nX-Other: 2\r\n\r\n"
+            "GET /echo/1 HTTP/1.1\r\nHost: a\r\n\r\n");
+        CHECK(readResponses(fd, 2) == std::vector<std::string>{"abc", "1"});
+        sendAll(fd, "POST /body HTTP/1.1\r\nHost: a\r\nTransfer-Encoding: chunked\r\n\r\n3\r\nabc\r");
+        std::this_thread::sleep_for((50_ms).toChrono());
+        sendAll(fd, "\n2\r\nde\r\n0\r\n\r\nGET /echo/2 HTTP/1.1\r\nHost: a\r\n\r\n");
+        CHECK(readResponses(fd, 2) == std::vector<std::string>{"abcde", "2"});
+        ::close(fd);
+    }
+
+    // 同时存在 Content-Length 与 Transfer-Encoding: 关闭连接, 不处理之后的数据
+    {
+        int fd = connectTo(28228);
+        sendAll(fd,
+            "GET /echo/1 HTTP/1.1\r\nHost: a\r\n\r\n"
+            "POST /body HTTP/1.1\r\nHost: a\r\nContent-Length: 4\r\nTransfer-Encoding: chunked\r\n\r\n"
+            "0\r\n\r\nGET /echo/9 HTTP/1.1\r\nHost: a\r\n\r\n");
+        CHECK(readResponses(fd, 1) == std::vector<std::string>{"1"});
+        CHECK(isClosed(fd));
+        ::close(fd);
+    }
+
+    // 多个不一致的 Content-Length: 关闭连接
+    {
+        int fd = connectTo(28228);
+        sendAll(fd,
+            "POST /body HTTP/1.1\r\nHost: a\r\nContent-Length: 3\r\nContent-Length: 5\r\n\r\n"
+            "abcdeGET /echo/9 HTTP/1.1\r\nHost: a\r\n\r\n");
+        CHECK(isClosed(fd));
+        ::close(fd);
+    }
+
+    // 重复但一致的 Content-Length 仍然可用
+    {
+        int fd = connectTo(28228);
+        sendAll(fd,
+            "POST /body HTTP/1.1\r\nHost: a\r\nContent-Length: 3, 3\r\n\r\n"
+            "abcGET /echo/1 HTTP/1.1\r\nHost: a\r\n\r\n");
+        CHECK(readResponses(fd, 2) == std::vector<std::string>{"abc", "1"});
+        ::close(fd);
+    }
+
+    // 未读取的请求体中块大小不合法: clear() 返回 false, 关闭连接 (而不是抛出异常)
+    {
+        int fd = connectTo(28228);
+        sendAll(fd,
+            "POST /ignore HTTP/1.1\r\nHost: a\r\nTransfer-Encoding: chunked\r\n\r\n"
+            "zz\r\nabc\r\n0\r\n\r\nGET /echo/9 HTTP/1.1\r\nHost: a\r\n\r\n");
+        CHECK(readResponses(fd, 1) == std::vector<std::string>{"ignored"});
+        CHECK(isClosed(fd));
+        ::close(fd);
+    }
+
+    // 块大小行填满了接收缓冲区: 按不合法的分块编码处理, 关闭连接
+    {
+        // 恰好填满 16 KB 的接收缓冲区, 不留未读的数据 (否则关闭时会发送 RST)
+        std::string req = "POST /ignore HTTP/1.1\r\nHost: a\r\nTransfer-Encoding: chunked\r\n\r\n3;";
+        req.resize(16 * 1024, 'x');
+        int fd = connectTo(28228);
+        sendAll(fd, req);
+        CHECK(readResponses(fd, 1) == std::vector<std::string>{"ignored"});
+        CHECK(isClosed(fd));
+        ::close(fd);
+    }
+
+    // 请求体未读完时, 响应不等待请求体
+    {
+        int fd = connectTo(28228);
+        auto const t0 = std::chrono::steady_clock::now();
+        sendAll(fd, "POST /ignore HTTP/1.1\r\nHost: a\r\nContent-Length: 10\r\n\r\nabc");
+        CHECK(readResponses(fd, 1) == std::vector<std::string>{"ignored"});
+        // 读取剩余的请求体最多等待 250 ms (之后关闭连接), 响应应在此之前到达
+        CHECK(std::chrono::steady_clock::now() - t0 < std::chrono::milliseconds{200});
+        ::close(fd);
+    }
+}
+
+#endif
@@ -0,0 +1,91 @@
+#include <HXLibs/net/ApiMacro.hpp>
+
+#include <cerrno>
+#include <chrono>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <sys/socket.h>
+    #include <sys/time.h>
+    #include <unistd.h>
+#endif
+
+using namespace HX;
+using namespace net;
+using namespace utils;
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+
+#if defined(__linux__)
+
+namespace {
+
+int connectTo(std::uint16_t port) {
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    ::sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    REQUIRE(::connect(fd, reinterpret_cast<::sockaddr*>(&addr), sizeof(addr)) == 0);
+    ::timeval tv{3, 0};
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    return fd;
+}
+
+} // namespace
+
+/**
+ * @brief 注册文件表只有 8 个槽位, 一次涌入 32 个长连接:
+ *        多发 accept 在表快满时取消并切换到普通 fd, 取消生效前内核直接接受到表中的连接
+ *        无人接管, 必须被关闭 (而不是占着槽位让客户端一直挂起)
+ */
+TEST_CASE("多发 accept: 切换到普通 fd 时, 每个连接要么被处理, 要么被关闭") {
+    HttpServer ser{28229};
+    ser.addEndpoint<GET>("/", [] ENDPOINT {
+        co_await res.setStatusAndContent(
+            Status::CODE_200, req.getIO().isFixedFile() ? "fixed" : "plain")
+                    .sendRes();
+    });
+    HttpServerOptions options{};
+    options.eventLoop.fixedFiles = 8;
+    options.multishotAccept = true;
+    ser.asyncRun(1, []{}, 5_s, options);
+    std::this_thread::sleep_for((500_ms).toChrono());
+
+    constexpr std::string_view req = "GET / HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n";
+    for (int round = 0; round < 2; ++round) {
+        std::vector<int> fds;
+        for (int i = 0; i < 32; ++i) {
+            fds.push_back(connectTo(28229));
+        }
+        std::size_t served = 0, closed = 0;
+        for (int fd : fds) {
+            char buf[1024];
+            ::send(fd, req.data(), req.size(), MSG_NOSIGNAL);
+            auto r = ::recv(fd, buf, sizeof(buf), 0);
+            if (r > 0) {
+                CHECK(std::string_view{buf, static_cast<std::size_t>(r)}
+                    .starts_with("HTTP/1.1 200 OK\r\n"));
+                ++served;
+            } else {
+                // 超时 (EAGAIN) 说明连接既没有被处理也没有被关闭
+                CHECK((r == 0 || errno == ECONNRESET));
+                ++closed;
+            }
+        }
+        log::hxLog.info("round", round, "served:", served, "closed:", closed);
+        CHECK(served + closed == fds.size());
+        CHECK(served >= 8);
+        for (int fd : fds) {
+            ::close(fd);
+        }
+        std::this_thread::sleep_for((200_ms).toChrono());
+    }
+}
+
+#endif
@@ -0,0 +1,59 @@
+#include <HXLibs/net/ApiMacro.hpp>
+#include <HXLibs/utils/CpuAffinity.hpp>
+
+#include <atomic>
+#include <thread>
+
+using namespace HX;
+using namespace net;
+using namespace utils;
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+
+TEST_CASE("绑核: 解析 CPU 列表与分配计划") {
+    CHECK(CpuAffinity::parseCpuList("0-3,8,10-11\n")
+        == std::vector<int>{0, 1, 2, 3, 8, 10, 11});
+    CHECK(CpuAffinity::parseCpuList("").empty());
+
+    CHECK(CpuAffinity{}.plan().empty()); // 默认不绑核
+
+    CpuAffinity affinity{};
+    affinity.enable = true;
+    affinity.cpus = {0, 1, 2, 3};
+    affinity.reserved = {1};
+    CHECK(affinity.plan() == std::vector<int>{0, 2, 3});
+
+    affinity.cpus.clear();
+    affinity.reserved.clear();
+    CHECK(affinity.plan() == CpuAffinity::allowedCpus());
+    affinity.numaSpread = true;
+    CHECK(affinity.plan().size() == CpuAffinity::allowedCpus().size());
+}
+
+#if defined(__linux__)
+
+TEST_CASE("绑核: 服务器与客户端的工作线程") {
+    auto const cpu = CpuAffinity::allowedCpus().back();
+    std::atomic_int servedOn{-1};
+    HttpServer ser{28219};
+    ser.addEndpoint<GET>("/", [&] ENDPOINT {
+        servedOn = ::sched_getcpu();
+        co_await res.setStatusAndContent(Status::CODE_200, "ok")
+                    .sendRes();
+    });
+    HttpServerOptions options{};
+    options.cpuAffinity.enable = true;
+    options.cpuAffinity.cpus = {cpu};
+    ser.asyncRun(1, []{}, 3_s, options);
+    std::this_thread::sleep_for((500_ms).toChrono());
+
+    HttpClientOptions<> cliOptions{};
+    cliOptions.cpu = cpu;
+    HttpClient cli{cliOptions};
+    auto res = cli.get("http://127.0.0.1:28219/").get().move();
+    CHECK(res.status == 200);
+    CHECK(servedOn.load() == cpu);
+}
+
+#endif